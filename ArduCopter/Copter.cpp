@@ -159,13 +159,13 @@ const AP_Scheduler::Task Copter::scheduler_tasks[] = {
 #endif
     SCHED_TASK_CLASS(AP_InertialSensor,    &copter.ins,                 periodic,       400,  50),
 
-    SCHED_TASK_CLASS(AP_Scheduler,         &copter.scheduler,           update_logging, 0.1,  75),
+    SCHED_TASK_CLASS_PRIORITY(AP_Scheduler, &copter.scheduler,          update_logging, 0.1,  75, 1),
 #if RPM_ENABLED == ENABLED
     SCHED_TASK(rpm_update,            40,    200),
 #endif
     SCHED_TASK(compass_cal_update,   100,    100),
     SCHED_TASK(accel_cal_update,      10,    100),
-    SCHED_TASK_CLASS(AP_TempCalibration,   &copter.g2.temp_calibration, update,          10, 100),
+    SCHED_TASK_CLASS_PRIORITY(AP_TempCalibration, &copter.g2.temp_calibration, update,    10, 100, 1),
 #if ADSB_ENABLED == ENABLED
     SCHED_TASK(avoidance_adsb_update, 10,    100),
 #endif
@@ -200,7 +200,7 @@ const AP_Scheduler::Task Copter::scheduler_tasks[] = {
     SCHED_TASK_CLASS(AP_Button,            &copter.button,           update,           5, 100),
 #endif
 #if STATS_ENABLED == ENABLED
-    SCHED_TASK_CLASS(AP_Stats,             &copter.g2.stats,            update,           1, 100),
+    SCHED_TASK_CLASS_ASYNC(AP_Stats,       &copter.g2.stats,            update,           1, 100),
 #endif
 #if OSD_ENABLED == ENABLED
     SCHED_TASK(publish_osd_info, 1, 10),
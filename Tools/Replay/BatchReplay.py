@@ -0,0 +1,125 @@
+#!/usr/bin/env python
+'''
+run Replay over many logs and parameter sets in parallel
+
+Every combination of log and parameter file is replayed in its own
+Replay process, using all cores. Each run appends a line of EKF
+innovation and health statistics to a single summary file. When
+replaying a time window the logs are indexed once up front, and the
+index is reused by every run and by later batches.
+'''
+
+import optparse, os, sys, glob, shutil, subprocess, multiprocessing
+
+parser = optparse.OptionParser("BatchReplay [options] LOG...")
+parser.add_option("--logdir", type='string', default=None, help='replay all *.bin logs in a directory')
+parser.add_option("--param-file", type='string', action='append', default=[], help='parameter file to replay with; may be given more than once, each is a separate run per log')
+parser.add_option("--jobs", type=int, default=multiprocessing.cpu_count(), help='number of runs at once')
+parser.add_option("--replay", type='string', default='./Replay.elf', help='Replay executable')
+parser.add_option("--summary", type='string', default='replay_summary.txt', help='summary file')
+parser.add_option("--outdir", type='string', default='batch_replay', help='directory for the output of each run')
+parser.add_option("--start-time", type=float, default=None, help='start replaying at time (seconds)')
+parser.add_option("--end-time", type=float, default=None, help='stop replaying at time (seconds)')
+parser.add_option("--metrics-only", action='store_true', default=False, help="only replay the EKF, without writing output logs")
+parser.add_option("--replay-args", type='string', default='', help='extra arguments for Replay')
+
+opts, args = parser.parse_args()
+
+SUMMARY_FIELDS = ['Log', 'Run', 'Time', 'Updates', 'Healthy', 'HealthChanges']
+for ratio in ['Vel', 'Pos', 'Hgt', 'Mag', 'Tas']:
+    SUMMARY_FIELDS.extend([ratio + 'Mean', ratio + 'Max'])
+
+def run_name(param_file):
+    '''name of a run in the summary'''
+    if param_file is None:
+        return 'default'
+    return os.path.splitext(os.path.basename(param_file))[0]
+
+def index_log(logfile):
+    '''build the index of one log'''
+    cmd = [opts.replay, '--', '--index-only', logfile]
+    with open(os.devnull, 'w') as devnull:
+        return (logfile, subprocess.call(cmd, stdout=devnull, stderr=subprocess.STDOUT))
+
+def run_replay(job):
+    '''run Replay on one log with one parameter file'''
+    (num, logfile, param_file) = job
+    name = run_name(param_file)
+    rundir = os.path.join(opts.outdir, "%04u-%s-%s" % (num, os.path.splitext(os.path.basename(logfile))[0], name))
+    if os.path.exists(rundir):
+        shutil.rmtree(rundir)
+    os.makedirs(rundir)
+    cmd = [opts.replay, '--', '--summary', os.path.abspath(opts.summary), '--run-name', name]
+    if param_file is not None:
+        cmd.extend(['--param-file', param_file])
+    if opts.start_time is not None:
+        cmd.extend(['--start-time', str(opts.start_time)])
+    if opts.end_time is not None:
+        cmd.extend(['--end-time', str(opts.end_time)])
+    if opts.metrics_only:
+        cmd.append('--metrics-only')
+    cmd.extend(opts.replay_args.split())
+    cmd.append(logfile)
+    # each run has its own directory for the logs it writes
+    with open(os.path.join(rundir, 'replay.out'), 'w') as out:
+        ret = subprocess.call(cmd, stdout=out, stderr=subprocess.STDOUT, cwd=rundir)
+    if ret != 0:
+        # record failed runs, e.g. on floating point exceptions
+        with open(opts.summary, 'a') as f:
+            f.write("%s\t%s\tFAILED(%d)\n" % (logfile, name, ret))
+    return (logfile, name, ret)
+
+def get_log_list():
+    '''get a list of log files to process'''
+    file_list = list(args)
+    if opts.logdir is not None:
+        file_list.extend(glob.glob(os.path.join(opts.logdir, "*.bin")))
+        file_list.extend(glob.glob(os.path.join(opts.logdir, "*.BIN")))
+    file_list = sorted(set([os.path.abspath(f) for f in file_list]))
+    if len(file_list) == 0:
+        print("No logs to process")
+        sys.exit(1)
+    return file_list
+
+def batch_replay():
+    '''replay every combination of log and parameter file'''
+    opts.replay = os.path.abspath(opts.replay)
+    log_list = get_log_list()
+    param_files = [os.path.abspath(p) for p in opts.param_file]
+    if len(param_files) == 0:
+        param_files = [None]
+
+    pool = multiprocessing.Pool(opts.jobs)
+
+    if opts.start_time is not None:
+        # index each log once rather than in every run
+        for (logfile, ret) in pool.imap_unordered(index_log, log_list):
+            if ret != 0:
+                print("Failed to index %s" % logfile)
+                sys.exit(1)
+
+    with open(opts.summary, 'w') as f:
+        f.write('\t'.join(SUMMARY_FIELDS) + '\n')
+
+    jobs = []
+    for logfile in log_list:
+        for param_file in param_files:
+            jobs.append((len(jobs), logfile, param_file))
+    print("Replaying %u logs with %u parameter sets: %u runs on %u cores" % (
+        len(log_list), len(param_files), len(jobs), opts.jobs))
+
+    failures = 0
+    done = 0
+    for (logfile, name, ret) in pool.imap_unordered(run_replay, jobs):
+        done += 1
+        if ret != 0:
+            failures += 1
+        print("[%u/%u] %s %s: %s" % (done, len(jobs), logfile, name, "OK" if ret == 0 else "FAILED"))
+    pool.close()
+    pool.join()
+
+    print("%u runs, %u failed. Summary in %s" % (len(jobs), failures, opts.summary))
+    if failures != 0:
+        sys.exit(1)
+
+batch_replay()
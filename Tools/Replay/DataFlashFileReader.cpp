@@ -1,7 +1,10 @@
 #include "DataFlashFileReader.h"
 
 #include <fcntl.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <stdio.h>
 #include <unistd.h>
@@ -29,24 +32,203 @@ AP_LoggerFileReader::~AP_LoggerFileReader()
     const uint64_t delta = micros - start_micros;
     ::printf("Replay counts: %" PRIu64 " bytes  %u entries\n", bytes_read, message_count);
     ::printf("Replay rates: %" PRIu64 " bytes/second  %" PRIu64 " messages/second\n", bytes_read*1000000/delta, message_count*1000000/delta);
+    close_log();
 }
 
 bool AP_LoggerFileReader::open_log(const char *logfile)
 {
+    close_log();
     fd = ::open(logfile, O_RDONLY|O_CLOEXEC);
     if (fd == -1) {
         return false;
     }
+    input.reset();
+
+    // map uncompressed logs so messages can be parsed in place rather
+    // than with a read() per message. Compressed logs are read
+    // through the decompressor
+    struct stat st;
+    uint32_t magic = 0;
+    if (fstat(fd, &st) == 0 && st.st_size > 0 &&
+        (::pread(fd, &magic, sizeof(magic), 0) != sizeof(magic) || magic != LOG_COMPRESS_MAGIC)) {
+        void *m = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m != MAP_FAILED) {
+            ::madvise(m, st.st_size, MADV_SEQUENTIAL);
+            map = (const uint8_t *)m;
+            map_size = st.st_size;
+        }
+    }
+
+    if (asprintf(&index_filename, "%s.idx", logfile) == -1) {
+        index_filename = nullptr;
+    }
     return true;
 }
 
+void AP_LoggerFileReader::close_log()
+{
+    if (map != nullptr) {
+        ::munmap((void *)map, map_size);
+        map = nullptr;
+        map_size = 0;
+    }
+    if (fd != -1) {
+        ::close(fd);
+        fd = -1;
+    }
+    offset = 0;
+    free(index_filename);
+    index_filename = nullptr;
+    index.clear();
+    free(prelude);
+    prelude = nullptr;
+    prelude_count = 0;
+    prelude_next = 0;
+    skipping = false;
+}
+
 ssize_t AP_LoggerFileReader::read_input(void *buffer, const size_t count)
 {
-    uint64_t ret = ::read(fd, buffer, count);
-    bytes_read += ret;
+    ssize_t ret;
+    if (map != nullptr) {
+        ret = MIN(uint64_t(count), map_size - offset);
+        memcpy(buffer, &map[offset], ret);
+    } else {
+        ret = input.read(buffer, count);
+    }
+    if (ret > 0) {
+        offset += ret;
+        bytes_read += ret;
+    }
     return ret;
 }
 
+bool AP_LoggerFileReader::seek_input(uint64_t ofs)
+{
+    if (map != nullptr) {
+        if (ofs > map_size) {
+            return false;
+        }
+    } else if (ofs > UINT32_MAX || !input.seek(ofs)) {
+        return false;
+    }
+    offset = ofs;
+    return true;
+}
+
+bool AP_LoggerFileReader::index_log()
+{
+    struct stat st;
+    if (fd == -1 || fstat(fd, &st) != 0) {
+        return false;
+    }
+    if (index_filename != nullptr &&
+        index.load(index_filename, st.st_size, st.st_mtime)) {
+        return true;
+    }
+
+    ::printf("Indexing log\n");
+    const uint64_t start_offset = offset;
+    const uint64_t start_bytes_read = bytes_read;
+    if (!seek_input(0)) {
+        return false;
+    }
+    uint8_t msg[256];
+    uint64_t ofs = 0;
+    while (read_input(msg, 3) == 3) {
+        if (msg[0] != HEAD_BYTE1 || msg[1] != HEAD_BYTE2) {
+            ::printf("bad log header at offset %" PRIu64 "\n", ofs);
+            break;
+        }
+        const uint8_t len = index.message_length(msg[2]);
+        if (len <= 3) {
+            ::printf("No format defined for type (%d)\n", msg[2]);
+            break;
+        }
+        if (read_input(&msg[3], len-3) != len-3) {
+            break;
+        }
+        index.add(ofs, msg);
+        ofs += len;
+    }
+    index.finish(ofs);
+
+    // indexing doesn't count towards the replay statistics
+    bytes_read = start_bytes_read;
+    if (!seek_input(start_offset)) {
+        return false;
+    }
+    if (index_filename == nullptr) {
+        ::printf("Unable to save log index\n");
+    } else if (!index.save(index_filename, st.st_size, st.st_mtime)) {
+        ::printf("Unable to save log index %s\n", index_filename);
+    }
+    return true;
+}
+
+static int compare_offsets(const void *a, const void *b)
+{
+    const uint64_t oa = *(const uint64_t *)a;
+    const uint64_t ob = *(const uint64_t *)b;
+    return oa < ob ? -1 : (oa > ob ? 1 : 0);
+}
+
+bool AP_LoggerFileReader::seek_time(uint64_t time_us, const char *prelude_types[])
+{
+    if (!index.complete()) {
+        return false;
+    }
+    const uint64_t target = index.offset_for_time(time_us);
+
+    // the messages to return first: FMT and the prelude types
+    uint8_t types[LOGREADER_MAX_FORMATS];
+    uint8_t num_types = 0;
+    types[num_types++] = LOG_FORMAT_MSG;
+    for (uint8_t i=0; prelude_types != nullptr && prelude_types[i] != nullptr; i++) {
+        uint8_t type;
+        if (index.find_type(prelude_types[i], type) && num_types < ARRAY_SIZE(types)) {
+            types[num_types++] = type;
+        }
+    }
+    uint64_t count = 0;
+    for (uint8_t i=0; i<num_types; i++) {
+        if (index.offsets(types[i]) == nullptr) {
+            ::printf("Too many %s messages to seek\n", index.type_name(types[i]));
+            return false;
+        }
+        count += index.count(types[i]);
+    }
+
+    free(prelude);
+    prelude = (uint64_t *)malloc(count * sizeof(uint64_t));
+    if (prelude == nullptr) {
+        return false;
+    }
+    prelude_count = 0;
+    for (uint8_t i=0; i<num_types; i++) {
+        const uint64_t *offsets = index.offsets(types[i]);
+        for (uint64_t j=0; j<index.count(types[i]) && offsets[j] < target; j++) {
+            prelude[prelude_count++] = offsets[j];
+        }
+    }
+    qsort(prelude, prelude_count, sizeof(uint64_t), compare_offsets);
+
+    prelude_next = 0;
+    skip_target = target;
+    skipping = true;
+    return true;
+}
+
+ssize_t AP_LoggerFileReader::Input::read_raw(void *buf, uint32_t count)
+{
+    return ::read(fd, buf, count);
+}
+
+bool AP_LoggerFileReader::Input::seek_raw(uint32_t ofs)
+{
+    return ::lseek(fd, ofs, SEEK_SET) != (off_t)-1;
+}
+
 void AP_LoggerFileReader::format_type(uint16_t type, char dest[5])
 {
     const struct log_Format &f = formats[type];
@@ -63,6 +245,21 @@ void AP_LoggerFileReader::get_packet_counts(uint64_t dest[])
 
 bool AP_LoggerFileReader::update(char type[5])
 {
+    if (skipping) {
+        // after a seek_time(), jump to each message of the prelude and
+        // then to the target
+        uint64_t ofs;
+        if (prelude_next < prelude_count) {
+            ofs = prelude[prelude_next++];
+        } else {
+            ofs = skip_target;
+            skipping = false;
+        }
+        if (!seek_input(ofs)) {
+            return false;
+        }
+    }
+
     uint8_t hdr[3];
     if (read_input(hdr, 3) != 3) {
         return false;
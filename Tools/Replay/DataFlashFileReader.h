@@ -1,6 +1,8 @@
 #pragma once
 
 #include <AP_Logger/AP_Logger.h>
+#include <AP_Logger/LogCompress.h>
+#include "LogIndex.h"
 
 #define LOGREADER_MAX_FORMATS 255 // must be >= highest MESSAGE
 
@@ -14,6 +16,22 @@ public:
     bool open_log(const char *logfile);
     bool update(char type[5]);
 
+    /*
+      load the index of the open log from its sidecar file, building
+      and saving it if it is missing or out of date
+     */
+    bool index_log();
+    const LogIndex &get_index() const { return index; }
+
+    /*
+      skip to the messages timestamped from time_us onwards. The
+      following updates first return the FMT messages and the
+      messages of the types named in the nullptr terminated list
+      prelude_types which come before that point, in log order.
+      Requires the log to have been indexed
+     */
+    bool seek_time(uint64_t time_us, const char *prelude_types[]);
+
     virtual bool handle_log_format_msg(const struct log_Format &f) = 0;
     virtual bool handle_msg(const struct log_Format &f, uint8_t *msg) = 0;
 
@@ -27,6 +45,37 @@ protected:
 
 private:
     ssize_t read_input(void *buf, size_t count);
+    bool seek_input(uint64_t ofs);
+
+    // log input, decompressing block compressed logs
+    class Input : public LogDecompressor {
+    public:
+        Input(const int &_fd) : fd(_fd) {}
+    protected:
+        ssize_t read_raw(void *buf, uint32_t count) override;
+        bool seek_raw(uint32_t ofs) override;
+    private:
+        const int &fd;
+    } input{fd};
+
+    // uncompressed logs are mapped into memory and read from there
+    const uint8_t *map = nullptr;
+    size_t map_size = 0;
+    // offset in the log data of the next read
+    uint64_t offset = 0;
+
+    char *index_filename = nullptr;
+    LogIndex index;
+
+    // offsets of the messages to return before continuing from
+    // skip_target after a seek_time()
+    uint64_t *prelude = nullptr;
+    uint32_t prelude_count = 0;
+    uint32_t prelude_next = 0;
+    uint64_t skip_target = 0;
+    bool skipping = false;
+
+    void close_log();
 
     uint64_t bytes_read = 0;
     uint32_t message_count = 0;
@@ -102,6 +102,13 @@ void LR_MsgHandler_CHEK::process_message(uint8_t *msg)
 
 void LR_MsgHandler_BARO::process_message(uint8_t *msg)
 {
+    if (typed) {
+        LogDecode::BARO pkt;
+        pkt.decode(msg);
+        wait_timestamp_usec(pkt.TimeUS);
+        AP::baro().setHIL(0, pkt.Press, pkt.Temp * 0.01f, pkt.Alt, pkt.CRt, pkt.SMS);
+        return;
+    }
     wait_timestamp_from_msg(msg);
     uint32_t last_update_ms;
     if (!field_value(msg, "SMS", last_update_ms)) {
@@ -138,6 +145,30 @@ void LR_MsgHandler_GPS2::process_message(uint8_t *msg)
 
 void LR_MsgHandler_GPS_Base::update_from_msg_gps(uint8_t gps_offset, uint8_t *msg)
 {
+    if (typed) {
+        LogDecode::GPS pkt;
+        pkt.decode(msg);
+        wait_timestamp_usec(pkt.TimeUS);
+        Location loc;
+        loc.lat = pkt.Lat;
+        loc.lng = pkt.Lng;
+        loc.set_alt_cm(pkt.Alt, Location::AltFrame::ABSOLUTE);
+        const Vector3f vel(pkt.Spd * cosf(radians(pkt.GCrs)),
+                           pkt.Spd * sinf(radians(pkt.GCrs)),
+                           pkt.VZ);
+        gps.setHIL(gps_offset,
+                   (AP_GPS::GPS_Status)pkt.Status,
+                   AP_GPS::time_epoch_convert(pkt.GWk, pkt.GMS),
+                   loc,
+                   vel,
+                   pkt.NSats,
+                   pkt.HDop);
+        if (pkt.Status == AP_GPS::GPS_OK_FIX_3D && ground_alt_cm == 0) {
+            ground_alt_cm = pkt.Alt;
+        }
+        return;
+    }
+
     uint64_t time_us;
     if (! field_value(msg, "TimeUS", time_us)) {
         uint32_t timestamp;
@@ -152,7 +183,7 @@ void LR_MsgHandler_GPS_Base::update_from_msg_gps(uint8_t gps_offset, uint8_t *ms
     ground_vel_from_msg(msg, vel, "Spd", "GCrs", "VZ");
 
     uint8_t status = require_field_uint8_t(msg, "Status");
-    uint8_t hdop = 0;
+    uint16_t hdop = 0;
     if (! field_value(msg, "HDop", hdop) &&
         ! field_value(msg, "HDp", hdop)) {
         hdop = 20;
@@ -192,6 +223,14 @@ void LR_MsgHandler_GPS::process_message(uint8_t *msg)
 
 void LR_MsgHandler_GPA_Base::update_from_msg_gpa(uint8_t gps_offset, uint8_t *msg)
 {
+    if (typed) {
+        LogDecode::GPA pkt;
+        pkt.decode(msg);
+        wait_timestamp_usec(pkt.TimeUS);
+        gps.setHIL_Accuracy(gps_offset, pkt.VDop*0.01f, pkt.HAcc*0.01f, pkt.VAcc*0.01f, pkt.SAcc*0.01f, pkt.VV, pkt.SMS);
+        return;
+    }
+
     uint64_t time_us;
     require_field(msg, "TimeUS", time_us);
     wait_timestamp_usec(time_us);
@@ -240,10 +279,23 @@ void LR_MsgHandler_IMU3::process_message(uint8_t *msg)
 
 void LR_MsgHandler_IMU_Base::update_from_msg_imu(uint8_t imu_offset, uint8_t *msg)
 {
-    wait_timestamp_from_msg(msg);
-
     uint8_t this_imu_mask = 1 << imu_offset;
 
+    if (typed) {
+        LogDecode::IMU pkt;
+        pkt.decode(msg);
+        wait_timestamp_usec(pkt.TimeUS);
+        if (gyro_mask & this_imu_mask) {
+            ins.set_gyro(imu_offset, Vector3f(pkt.GyrX, pkt.GyrY, pkt.GyrZ));
+        }
+        if (accel_mask & this_imu_mask) {
+            ins.set_accel(imu_offset, Vector3f(pkt.AccX, pkt.AccY, pkt.AccZ));
+        }
+        return;
+    }
+
+    wait_timestamp_from_msg(msg);
+
     if (gyro_mask & this_imu_mask) {
         Vector3f gyro;
         require_field(msg, "Gyr", gyro);
@@ -264,14 +316,31 @@ void LR_MsgHandler_IMU::process_message(uint8_t *msg)
 
 void LR_MsgHandler_IMT_Base::update_from_msg_imt(uint8_t imu_offset, uint8_t *msg)
 {
+    uint8_t this_imu_mask = 1 << imu_offset;
+
+    if (typed) {
+        LogDecode::IMT pkt;
+        pkt.decode(msg);
+        wait_timestamp_usec(pkt.TimeUS);
+        if (!use_imt) {
+            return;
+        }
+        ins.set_delta_time(pkt.DelT);
+        if (gyro_mask & this_imu_mask) {
+            ins.set_delta_angle(imu_offset, Vector3f(pkt.DelAX, pkt.DelAY, pkt.DelAZ), pkt.DelaT);
+        }
+        if (accel_mask & this_imu_mask) {
+            ins.set_delta_velocity(imu_offset, pkt.DelvT, Vector3f(pkt.DelVX, pkt.DelVY, pkt.DelVZ));
+        }
+        return;
+    }
+
     wait_timestamp_from_msg(msg);
 
     if (!use_imt) {
         return;
     }
 
-    uint8_t this_imu_mask = 1 << imu_offset;
-
     float delta_time = 0;
     require_field(msg, "DelT", delta_time);
     ins.set_delta_time(delta_time);
@@ -317,6 +386,17 @@ void LR_MsgHandler_MAG2::process_message(uint8_t *msg)
 
 void LR_MsgHandler_MAG_Base::update_from_msg_compass(uint8_t compass_offset, uint8_t *msg)
 {
+    if (typed) {
+        LogDecode::MAG pkt;
+        pkt.decode(msg);
+        wait_timestamp_usec(pkt.TimeUS);
+        const Vector3f mag(pkt.MagX, pkt.MagY, pkt.MagZ);
+        const Vector3f mag_offset(pkt.OfsX, pkt.OfsY, pkt.OfsZ);
+        compass.setHIL(compass_offset, mag - mag_offset, pkt.S);
+        compass.set_offsets(compass_offset, mag_offset);
+        return;
+    }
+
     wait_timestamp_from_msg(msg);
 
     Vector3f mag;
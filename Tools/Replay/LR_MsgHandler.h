@@ -2,6 +2,7 @@
 
 #include "MsgHandler.h"
 #include <AP_AHRS/AP_AHRS.h>
+#include <AP_Logger/LogDecoders.h>
 #include <AP_GPS/AP_GPS.h>
 
 #include <functional>
@@ -31,6 +32,12 @@ protected:
 
 };
 
+/*
+  handlers for high rate messages decode them with the generated
+  decoders when the log's format is the one they were generated for,
+  and fall back to looking up fields by label otherwise
+ */
+
 /* subclasses below this point */
 
 class LR_MsgHandler_AHR2 : public LR_MsgHandler
@@ -116,11 +123,15 @@ class LR_MsgHandler_BARO : public LR_MsgHandler
 public:
     LR_MsgHandler_BARO(log_Format &_f, AP_Logger &_logger,
                     uint64_t &_last_timestamp_usec)
-        : LR_MsgHandler(_f, _logger, _last_timestamp_usec)
+        : LR_MsgHandler(_f, _logger, _last_timestamp_usec),
+          typed(LogDecode::BARO::matches(_f))
         { };
 
     void process_message(uint8_t *msg) override;
 
+private:
+    const bool typed;
+
 };
 
 
@@ -145,7 +156,8 @@ public:
                            uint64_t &_last_timestamp_usec, AP_GPS &_gps,
                            uint32_t &_ground_alt_cm)
         : LR_MsgHandler(_f, _logger, _last_timestamp_usec),
-          gps(_gps), ground_alt_cm(_ground_alt_cm) { };
+          gps(_gps), ground_alt_cm(_ground_alt_cm),
+          typed(LogDecode::GPS::matches(_f)) { };
 
 protected:
     void update_from_msg_gps(uint8_t imu_offset, uint8_t *data);
@@ -153,6 +165,7 @@ protected:
 private:
     AP_GPS &gps;
     uint32_t &ground_alt_cm;
+    const bool typed;
 };
 
 class LR_MsgHandler_GPS : public LR_MsgHandler_GPS_Base
@@ -197,13 +210,15 @@ class LR_MsgHandler_GPA_Base : public LR_MsgHandler
 public:
     LR_MsgHandler_GPA_Base(log_Format &_f, AP_Logger &_logger,
                            uint64_t &_last_timestamp_usec, AP_GPS &_gps)
-        : LR_MsgHandler(_f, _logger, _last_timestamp_usec), gps(_gps) { };
+        : LR_MsgHandler(_f, _logger, _last_timestamp_usec), gps(_gps),
+          typed(LogDecode::GPA::matches(_f)) { };
 
 protected:
     void update_from_msg_gpa(uint8_t imu_offset, uint8_t *data);
 
 private:
     AP_GPS &gps;
+    const bool typed;
 };
 
 
@@ -247,13 +262,15 @@ public:
         LR_MsgHandler(_f, _logger, _last_timestamp_usec),
         accel_mask(_accel_mask),
         gyro_mask(_gyro_mask),
-        ins(_ins) { };
+        ins(_ins),
+        typed(LogDecode::IMU::matches(_f)) { };
     void update_from_msg_imu(uint8_t imu_offset, uint8_t *msg);
 
 private:
     uint8_t &accel_mask;
     uint8_t &gyro_mask;
     AP_InertialSensor &ins;
+    const bool typed;
 };
 
 class LR_MsgHandler_IMU : public LR_MsgHandler_IMU_Base
@@ -308,7 +325,8 @@ public:
         accel_mask(_accel_mask),
         gyro_mask(_gyro_mask),
         use_imt(_use_imt),
-        ins(_ins) { };
+        ins(_ins),
+        typed(LogDecode::IMT::matches(_f)) { };
     void update_from_msg_imt(uint8_t imu_offset, uint8_t *msg);
 
 private:
@@ -316,6 +334,7 @@ private:
     uint8_t &gyro_mask;
     bool &use_imt;
     AP_InertialSensor &ins;
+    const bool typed;
 };
 
 class LR_MsgHandler_IMT : public LR_MsgHandler_IMT_Base
@@ -366,13 +385,15 @@ class LR_MsgHandler_MAG_Base : public LR_MsgHandler
 public:
     LR_MsgHandler_MAG_Base(log_Format &_f, AP_Logger &_logger,
                         uint64_t &_last_timestamp_usec, Compass &_compass)
-	: LR_MsgHandler(_f, _logger, _last_timestamp_usec), compass(_compass) { };
+	: LR_MsgHandler(_f, _logger, _last_timestamp_usec), compass(_compass),
+          typed(LogDecode::MAG::matches(_f)) { };
 
 protected:
     void update_from_msg_compass(uint8_t compass_offset, uint8_t *msg);
 
 private:
     Compass &compass;
+    const bool typed;
 };
 
 class LR_MsgHandler_MAG : public LR_MsgHandler_MAG_Base
@@ -0,0 +1,310 @@
+#include "LogIndex.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define LOG_INDEX_MAGIC 0x58495052 // "RPIX"
+#define LOG_INDEX_VERSION 1
+
+struct PACKED log_index_header {
+    uint32_t magic;
+    uint16_t version;
+    uint64_t log_size;
+    int64_t log_mtime;
+    uint64_t data_size;
+    uint64_t last_time_us;
+    uint32_t num_times;
+    uint16_t num_types;
+};
+
+struct PACKED log_index_type {
+    uint8_t type;
+    char name[4];
+    uint8_t length;
+    uint8_t time_ofs;
+    uint64_t count;
+    uint64_t first_offset;
+    uint64_t last_offset;
+};
+
+void LogIndex::clear()
+{
+    for (Type &t : types) {
+        free(t.offsets);
+        t = Type {};
+    }
+    free(times);
+    times = nullptr;
+    num_times = 0;
+    times_space = 0;
+    next_time_us = 0;
+    _last_time_us = 0;
+    _data_size = 0;
+    _complete = false;
+
+    // FMT messages describe themselves, but we need to know their
+    // length to find the first one
+    types[LOG_FORMAT_MSG].length = sizeof(struct log_Format);
+    strncpy(types[LOG_FORMAT_MSG].name, "FMT", sizeof(types[LOG_FORMAT_MSG].name));
+}
+
+void LogIndex::add_format(const struct log_Format &f)
+{
+    Type &t = types[f.type];
+    t.length = f.length;
+    memset(t.name, 0, sizeof(t.name));
+    strncpy(t.name, f.name, 4);
+    // a leading TimeUS field gives the time of each message
+    t.time_ofs = 0;
+    if (f.format[0] == 'Q' &&
+        strncmp(f.labels, "TimeUS", 6) == 0 &&
+        (f.labels[6] == ',' || f.labels[6] == 0)) {
+        t.time_ofs = LOG_PACKET_HEADER_LEN;
+    }
+}
+
+bool LogIndex::add_offset(Type &t, uint64_t offset)
+{
+    if (t.count > LOG_INDEX_MAX_OFFSETS) {
+        // too many to record
+        return true;
+    }
+    if (t.count == LOG_INDEX_MAX_OFFSETS) {
+        ::printf("More than %u %s messages, not indexing their offsets\n",
+                 unsigned(LOG_INDEX_MAX_OFFSETS), t.name);
+        free(t.offsets);
+        t.offsets = nullptr;
+        t.offsets_space = 0;
+        return true;
+    }
+    if (t.count == t.offsets_space) {
+        const uint32_t space = t.offsets_space ? t.offsets_space * 2 : 16;
+        uint64_t *offsets = (uint64_t *)realloc(t.offsets, space * sizeof(uint64_t));
+        if (offsets == nullptr) {
+            return false;
+        }
+        t.offsets = offsets;
+        t.offsets_space = space;
+    }
+    t.offsets[t.count] = offset;
+    return true;
+}
+
+bool LogIndex::add_time(uint64_t time_us, uint64_t offset)
+{
+    if (num_times == times_space) {
+        const uint32_t space = times_space ? times_space * 2 : 1024;
+        TimeEntry *entries = (TimeEntry *)realloc(times, space * sizeof(TimeEntry));
+        if (entries == nullptr) {
+            return false;
+        }
+        times = entries;
+        times_space = space;
+    }
+    times[num_times++] = TimeEntry { time_us, offset };
+    return true;
+}
+
+void LogIndex::add(uint64_t offset, const uint8_t *msg)
+{
+    const uint8_t type = msg[2];
+    if (type == LOG_FORMAT_MSG) {
+        struct log_Format f;
+        memcpy(&f, msg, sizeof(f));
+        add_format(f);
+    }
+
+    Type &t = types[type];
+    if (t.count == 0) {
+        t.first_offset = offset;
+    }
+    t.last_offset = offset;
+    if (!add_offset(t, offset)) {
+        ::printf("Out of memory indexing log\n");
+        exit(1);
+    }
+    t.count++;
+
+    if (t.time_ofs == 0) {
+        return;
+    }
+    uint64_t time_us;
+    memcpy(&time_us, &msg[t.time_ofs], sizeof(time_us));
+    if (time_us > _last_time_us) {
+        _last_time_us = time_us;
+    }
+    if (time_us >= next_time_us) {
+        if (!add_time(time_us, offset)) {
+            ::printf("Out of memory indexing log\n");
+            exit(1);
+        }
+        next_time_us = (time_us / LOG_INDEX_TIME_STEP_US + 1) * LOG_INDEX_TIME_STEP_US;
+    }
+}
+
+void LogIndex::finish(uint64_t data_size)
+{
+    _data_size = data_size;
+    _complete = true;
+}
+
+bool LogIndex::find_type(const char *name, uint8_t &type) const
+{
+    for (uint16_t i=0; i<ARRAY_SIZE(types); i++) {
+        if (types[i].count != 0 && strncmp(types[i].name, name, 4) == 0) {
+            type = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+const uint64_t *LogIndex::offsets(uint8_t type) const
+{
+    const Type &t = types[type];
+    if (t.count == 0 || t.count > LOG_INDEX_MAX_OFFSETS) {
+        return nullptr;
+    }
+    return t.offsets;
+}
+
+uint64_t LogIndex::offset_for_time(uint64_t time_us) const
+{
+    // find the last entry before time_us
+    uint32_t lo = 0;
+    uint32_t hi = num_times;
+    while (lo < hi) {
+        const uint32_t mid = (lo + hi) / 2;
+        if (times[mid].time_us < time_us) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    // messages are only roughly in time order, so start an entry
+    // earlier to be sure of seeing them all
+    if (lo < 2) {
+        return 0;
+    }
+    return times[lo-2].offset;
+}
+
+bool LogIndex::save(const char *filename, uint64_t log_size, int64_t log_mtime) const
+{
+    if (!_complete) {
+        return false;
+    }
+    char *tmpname;
+    if (asprintf(&tmpname, "%s.tmp", filename) == -1) {
+        return false;
+    }
+    FILE *f = fopen(tmpname, "wb");
+    if (f == nullptr) {
+        free(tmpname);
+        return false;
+    }
+
+    struct log_index_header hdr {};
+    hdr.magic = LOG_INDEX_MAGIC;
+    hdr.version = LOG_INDEX_VERSION;
+    hdr.log_size = log_size;
+    hdr.log_mtime = log_mtime;
+    hdr.data_size = _data_size;
+    hdr.last_time_us = _last_time_us;
+    hdr.num_times = num_times;
+    for (const Type &t : types) {
+        if (t.count != 0) {
+            hdr.num_types++;
+        }
+    }
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+
+    for (uint16_t i=0; i<ARRAY_SIZE(types) && ok; i++) {
+        const Type &t = types[i];
+        if (t.count == 0) {
+            continue;
+        }
+        struct log_index_type it {};
+        it.type = i;
+        memcpy(it.name, t.name, sizeof(it.name));
+        it.length = t.length;
+        it.time_ofs = t.time_ofs;
+        it.count = t.count;
+        it.first_offset = t.first_offset;
+        it.last_offset = t.last_offset;
+        ok = fwrite(&it, sizeof(it), 1, f) == 1;
+        if (ok && t.count <= LOG_INDEX_MAX_OFFSETS) {
+            ok = fwrite(t.offsets, sizeof(uint64_t), t.count, f) == t.count;
+        }
+    }
+    if (ok && num_times != 0) {
+        ok = fwrite(times, sizeof(TimeEntry), num_times, f) == num_times;
+    }
+
+    if (fclose(f) != 0) {
+        ok = false;
+    }
+    if (ok) {
+        ok = rename(tmpname, filename) == 0;
+    }
+    if (!ok) {
+        unlink(tmpname);
+    }
+    free(tmpname);
+    return ok;
+}
+
+bool LogIndex::load(const char *filename, uint64_t log_size, int64_t log_mtime)
+{
+    clear();
+    FILE *f = fopen(filename, "rb");
+    if (f == nullptr) {
+        return false;
+    }
+
+    struct log_index_header hdr;
+    bool ok = fread(&hdr, sizeof(hdr), 1, f) == 1 &&
+        hdr.magic == LOG_INDEX_MAGIC &&
+        hdr.version == LOG_INDEX_VERSION &&
+        hdr.log_size == log_size &&
+        hdr.log_mtime == log_mtime;
+
+    for (uint16_t i=0; ok && i<hdr.num_types; i++) {
+        struct log_index_type it;
+        if (fread(&it, sizeof(it), 1, f) != 1) {
+            ok = false;
+            break;
+        }
+        Type &t = types[it.type];
+        memcpy(t.name, it.name, sizeof(it.name));
+        t.length = it.length;
+        t.time_ofs = it.time_ofs;
+        t.count = it.count;
+        t.first_offset = it.first_offset;
+        t.last_offset = it.last_offset;
+        if (t.count <= LOG_INDEX_MAX_OFFSETS) {
+            t.offsets = (uint64_t *)malloc(t.count * sizeof(uint64_t));
+            t.offsets_space = t.count;
+            ok = t.offsets != nullptr &&
+                fread(t.offsets, sizeof(uint64_t), t.count, f) == t.count;
+        }
+    }
+    if (ok && hdr.num_times != 0) {
+        times = (TimeEntry *)malloc(hdr.num_times * sizeof(TimeEntry));
+        times_space = hdr.num_times;
+        num_times = hdr.num_times;
+        ok = times != nullptr &&
+            fread(times, sizeof(TimeEntry), num_times, f) == num_times;
+    }
+    fclose(f);
+
+    if (!ok) {
+        clear();
+        return false;
+    }
+    _last_time_us = hdr.last_time_us;
+    finish(hdr.data_size);
+    return true;
+}
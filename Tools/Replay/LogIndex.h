@@ -0,0 +1,105 @@
+#pragma once
+
+/*
+  index of the messages in a log, by message type and by time
+
+  The index is built by a single pass over the log and saved alongside
+  it as LOGFILE.idx, so later runs can seek within the log without
+  scanning it. Offsets are offsets in the log data, i.e. after
+  decompression for compressed logs.
+ */
+
+#include <AP_Logger/AP_Logger.h>
+
+// types with more messages than this only have their count and first
+// and last offsets recorded, which is reported when the log is indexed
+#define LOG_INDEX_MAX_OFFSETS 65536
+
+// spacing of the entries of the time index
+#define LOG_INDEX_TIME_STEP_US 100000
+
+class LogIndex
+{
+public:
+    LogIndex() { clear(); }
+    ~LogIndex() { clear(); }
+
+    /* do not allow copies */
+    LogIndex(const LogIndex &other) = delete;
+    LogIndex &operator=(const LogIndex&) = delete;
+
+    void clear();
+
+    /*
+      building the index
+     */
+
+    // length of messages of type, or zero if no format has been seen
+    uint8_t message_length(uint8_t type) const { return types[type].length; }
+
+    // add the complete message msg found at offset
+    void add(uint64_t offset, const uint8_t *msg);
+
+    // mark the index complete for log data of data_size bytes
+    void finish(uint64_t data_size);
+
+    /*
+      sidecar file, identified by the size and modification time of the
+      log it indexes
+     */
+    bool load(const char *filename, uint64_t log_size, int64_t log_mtime);
+    bool save(const char *filename, uint64_t log_size, int64_t log_mtime) const;
+
+    /*
+      lookup
+     */
+    bool complete() const { return _complete; }
+    uint64_t data_size() const { return _data_size; }
+
+    // find a message type by name, returns false if not in the log
+    bool find_type(const char *name, uint8_t &type) const;
+
+    uint64_t count(uint8_t type) const { return types[type].count; }
+    const char *type_name(uint8_t type) const { return types[type].name; }
+
+    // offsets of all messages of a type in log order, or nullptr if
+    // there were more than LOG_INDEX_MAX_OFFSETS of them
+    const uint64_t *offsets(uint8_t type) const;
+
+    // offset to start reading at to see all messages timestamped at or
+    // after time_us
+    uint64_t offset_for_time(uint64_t time_us) const;
+
+    // first and last message timestamps in the log
+    uint64_t first_time_us() const { return num_times ? times[0].time_us : 0; }
+    uint64_t last_time_us() const { return _last_time_us; }
+
+private:
+    struct Type {
+        char name[5];
+        uint8_t length;
+        // offset of the TimeUS field, or zero if there is none
+        uint8_t time_ofs;
+        uint64_t count;
+        uint64_t first_offset;
+        uint64_t last_offset;
+        uint64_t *offsets;
+        uint32_t offsets_space;
+    } types[256] {};
+
+    struct TimeEntry {
+        uint64_t time_us;
+        uint64_t offset;
+    } *times = nullptr;
+    uint32_t num_times = 0;
+    uint32_t times_space = 0;
+
+    uint64_t next_time_us = 0;
+    uint64_t _last_time_us = 0;
+    uint64_t _data_size = 0;
+    bool _complete = false;
+
+    void add_format(const struct log_Format &f);
+    bool add_offset(Type &t, uint64_t offset);
+    bool add_time(uint64_t time_us, uint64_t offset);
+};
@@ -423,7 +423,8 @@ bool LogReader::handle_msg(const struct log_Format &f, uint8_t *msg) {
             exit(1);
         }
         msg[2] = mapped_msgid[msg[2]];
-        if (!in_list(name, nottypes)) {
+        if (!in_list(name, nottypes) &&
+            (!metrics_only || in_list(name, keep_types))) {
             logger.WriteBlock(msg, f.length);        
         }
         // a MsgHandler would probably have found a timestamp and
@@ -32,6 +32,12 @@ public:
     void set_gyro_mask(uint8_t mask) { gyro_mask = mask; }
     void set_use_imt(bool _use_imt) { use_imt = _use_imt; }
     void set_save_chek_messages(bool _save_chek_messages) { save_chek_messages = _save_chek_messages; }
+    // only write the types in the nullptr terminated list keep_types
+    // through to the output log
+    void set_metrics_only(const char **_keep_types) {
+        metrics_only = true;
+        keep_types = _keep_types;
+    }
 
     uint64_t last_timestamp_us(void) const { return last_timestamp_usec; }
     bool handle_log_format_msg(const struct log_Format &f) override;
@@ -79,6 +85,9 @@ private:
 
     bool save_chek_messages;
 
+    bool metrics_only;
+    const char **keep_types;
+
     void maybe_install_vehicle_specific_parsers();
 
     void initialise_fmt_map();
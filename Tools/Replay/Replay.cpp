@@ -30,6 +30,9 @@
 
 #include <AP_Camera/AP_Camera.h>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
 #include <SITL/SITL.h>
 #endif
@@ -100,6 +103,9 @@ void ReplayVehicle::load_parameters(void)
     AP_Param::set_default_by_name("LOG_REPLAY", 1);
     AP_Param::set_default_by_name("AHRS_EKF_TYPE", 2);
     AP_Param::set_default_by_name("LOG_FILE_BUFSIZE", 60);
+    if (logging_disabled) {
+        AP_Param::set_default_by_name("LOG_BACKEND_TYPE", 0);
+    }
 }
 
 void ReplayVehicle::init_ardupilot(void)
@@ -151,6 +157,14 @@ void Replay::usage(void)
     ::printf("\t--no-params        don't use parameters from the log\n");
     ::printf("\t--no-fpe           do not generate floating point exceptions\n");
     ::printf("\t--packet-counts    print packet counts at end of processing\n");
+    ::printf("\t--start-time SECS  start replaying at time (seconds), using the log index\n");
+    ::printf("\t--end-time SECS    stop replaying at time (seconds)\n");
+    ::printf("\t--index-only       build the log index and exit\n");
+    ::printf("\t--summary FILE     append EKF statistics for the run to FILE\n");
+    ::printf("\t--run-name NAME    name of the run in the summary\n");
+    ::printf("\t--metrics-only     only replay the EKF, without writing an output log\n");
+    ::printf("\t--keep-types       with --metrics-only, list of msg types still output, comma separated.\n");
+    ::printf("\t                   EKF, AHRS2 and POS select the messages written by Replay\n");
 }
 
 
@@ -167,6 +181,13 @@ enum {
     OPT_PARAM_FILE,
     OPT_NO_FPE,
     OPT_PACKET_COUNTS,
+    OPT_START_TIME,
+    OPT_END_TIME,
+    OPT_INDEX_ONLY,
+    OPT_SUMMARY,
+    OPT_RUN_NAME,
+    OPT_METRICS_ONLY,
+    OPT_KEEP_TYPES,
 };
 
 void Replay::flush_logger(void) {
@@ -224,6 +245,13 @@ void Replay::_parse_command_line(uint8_t argc, char * const argv[])
         {"no-params",       false,  0, OPT_NOPARAMS},
         {"no-fpe",          false,  0, OPT_NO_FPE},
         {"packet-counts",   false,  0, OPT_PACKET_COUNTS},
+        {"start-time",      true,   0, OPT_START_TIME},
+        {"end-time",        true,   0, OPT_END_TIME},
+        {"index-only",      false,  0, OPT_INDEX_ONLY},
+        {"summary",         true,   0, OPT_SUMMARY},
+        {"run-name",        true,   0, OPT_RUN_NAME},
+        {"metrics-only",    false,  0, OPT_METRICS_ONLY},
+        {"keep-types",      true,   0, OPT_KEEP_TYPES},
         {0, false, 0, 0}
     };
 
@@ -311,6 +339,34 @@ void Replay::_parse_command_line(uint8_t argc, char * const argv[])
             packet_counts = true;
             break;
 
+        case OPT_START_TIME:
+            start_time = atof(gopt.optarg);
+            break;
+
+        case OPT_END_TIME:
+            end_time = atof(gopt.optarg);
+            break;
+
+        case OPT_INDEX_ONLY:
+            index_only = true;
+            break;
+
+        case OPT_SUMMARY:
+            summary_filename = gopt.optarg;
+            break;
+
+        case OPT_RUN_NAME:
+            run_name = gopt.optarg;
+            break;
+
+        case OPT_METRICS_ONLY:
+            metrics_only = true;
+            break;
+
+        case OPT_KEEP_TYPES:
+            keep_types = parse_list_from_string(gopt.optarg);
+            break;
+
         case 'h':
         default:
             usage();
@@ -471,6 +527,14 @@ bool Replay::find_log_info(struct log_information &info)
     return true;
 }
 
+// time not affected by the replay's stopped clock
+static uint64_t wall_micros(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec*1000000ULL + ts.tv_nsec/1000U;
+}
+
 // catch floating point exceptions
 static void _replay_sig_fpe(int signum)
 {
@@ -507,6 +571,8 @@ void Replay::setup()
 
     _parse_command_line(argc, argv);
 
+    wall_start_us = wall_micros();
+
     if (!check_generate) {
         logreader.set_save_chek_messages(true);
     }
@@ -515,6 +581,14 @@ void Replay::setup()
 
     hal.console->printf("Processing log %s\n", filename);
 
+    if (index_only) {
+        if (!logreader.open_log(filename) || !logreader.index_log()) {
+            ::printf("Failed to index %s\n", filename);
+            exit(1);
+        }
+        exit(0);
+    }
+
     // remember filename for reporting
     log_filename = filename;
 
@@ -530,6 +604,12 @@ void Replay::setup()
         exit(1);
     }
 
+    if (metrics_only) {
+        logreader.set_metrics_only(keep_types);
+        // with nothing to output there is no need for a logger at all
+        _vehicle.logging_disabled = (keep_types == nullptr);
+    }
+
     _vehicle.setup();
 
     inhibit_gyro_cal();
@@ -546,6 +626,18 @@ void Replay::setup()
     }
     
     set_ins_update_rate(log_info.update_rate);
+
+    if (start_time > 0) {
+        // skip to the start time, still applying the parameters set
+        // before it
+        const char *prelude_types[] { "PARM", nullptr };
+        if (!logreader.index_log() ||
+            !logreader.seek_time(start_time * 1.0e6, prelude_types)) {
+            ::printf("Unable to seek to %.1f seconds\n", start_time);
+            exit(1);
+        }
+        ::printf("Starting at %.1f seconds\n", start_time);
+    }
 }
 
 void Replay::set_ins_update_rate(uint16_t _update_rate) {
@@ -613,17 +705,28 @@ void Replay::set_signal_handlers(void)
  */
 void Replay::write_ekf_logs(void)
 {
-    if (!LogReader::in_list("EKF", nottypes)) {
+    if (output_type("EKF")) {
         _vehicle.ahrs.Log_Write();
     }
-    if (!LogReader::in_list("AHRS2", nottypes)) {
+    if (output_type("AHRS2")) {
         _vehicle.logger.Write_AHRS2();
     }
-    if (!LogReader::in_list("POS", nottypes)) {
+    if (output_type("POS")) {
         _vehicle.logger.Write_POS();
     }
 }
 
+/*
+  true if messages of type name should be written to the output log
+ */
+bool Replay::output_type(const char *name) const
+{
+    if (LogReader::in_list(name, nottypes)) {
+        return false;
+    }
+    return !metrics_only || LogReader::in_list(name, keep_types);
+}
+
 void Replay::read_sensors(const char *type)
 {
     if (streq(type, "PARM")) {
@@ -648,7 +751,7 @@ void Replay::read_sensors(const char *type)
 
     if (streq(type,"GPS")) {
         _vehicle.gps.update();
-        if (_vehicle.gps.status() >= AP_GPS::GPS_OK_FIX_3D) {
+        if (!metrics_only && _vehicle.gps.status() >= AP_GPS::GPS_OK_FIX_3D) {
             _vehicle.ahrs.estimate_wind();
         }
     } else if (streq(type,"MAG")) {
@@ -693,7 +796,14 @@ void Replay::read_sensors(const char *type)
     }
     
     if (run_ahrs) {
-        _vehicle.ahrs.update();
+        if (metrics_only) {
+            const uint64_t start_us = wall_micros();
+            _vehicle.ahrs.update();
+            ekf_time_us += wall_micros() - start_us;
+            ekf_updates++;
+        } else {
+            _vehicle.ahrs.update();
+        }
         if ((downsample == 0 || ++output_counter % downsample == 0) && !logmatch) {
             write_ekf_logs();
         }
@@ -702,6 +812,10 @@ void Replay::read_sensors(const char *type)
             printf("AHRS health: %u at %lu\n", 
                    (unsigned)ahrs_healthy,
                    (unsigned long)AP_HAL::millis());
+            summary.health_changes++;
+        }
+        if (summary_filename != nullptr) {
+            update_summary();
         }
         if (check_generate) {
             log_check_generate();
@@ -776,10 +890,91 @@ void Replay::log_check_solution(void)
     check_result.max_pos_error   = MAX(check_result.max_pos_error,   pos_error);
 }
 
+/*
+  accumulate EKF statistics for --summary
+ */
+void Replay::update_summary(void)
+{
+    summary.updates++;
+    if (ahrs_healthy) {
+        summary.healthy_updates++;
+    }
+    float velVar, posVar, hgtVar, tasVar;
+    Vector3f magVar;
+    Vector2f offset;
+    if (!_vehicle.ahrs.get_variances(velVar, posVar, hgtVar, magVar, tasVar, offset)) {
+        return;
+    }
+    const float ratios[] { velVar, posVar, hgtVar, magVar.length(), tasVar };
+    for (uint8_t i=0; i<ARRAY_SIZE(ratios); i++) {
+        summary.ratio_sum[i] += ratios[i];
+        summary.ratio_max[i] = MAX(summary.ratio_max[i], ratios[i]);
+    }
+    summary.variance_count++;
+}
+
+/*
+  append a line of EKF statistics for this run to the summary
+  file. Several runs may append to the same file at once, so the line
+  is written with a single write()
+ */
+void Replay::write_summary(void)
+{
+    char line[512];
+    int n = snprintf(line, sizeof(line), "%s\t%s\t%.1f\t%lu\t%.4f\t%lu",
+                     log_filename,
+                     run_name != nullptr ? run_name : "-",
+                     AP_HAL::millis()*0.001f,
+                     (unsigned long)summary.updates,
+                     summary.updates ? summary.healthy_updates / double(summary.updates) : 0.0,
+                     (unsigned long)summary.health_changes);
+    for (uint8_t i=0; i<ARRAY_SIZE(summary.ratio_sum) && n > 0 && n < (int)sizeof(line); i++) {
+        n += snprintf(&line[n], sizeof(line)-n, "\t%.4f\t%.4f",
+                      summary.variance_count ? summary.ratio_sum[i] / summary.variance_count : 0.0,
+                      summary.ratio_max[i]);
+    }
+    if (n <= 0 || n >= (int)sizeof(line)-1) {
+        ::printf("Summary line too long\n");
+        return;
+    }
+    line[n++] = '\n';
+
+    const int fd = ::open(summary_filename, O_WRONLY|O_CREAT|O_APPEND|O_CLOEXEC, 0644);
+    if (fd == -1 || ::write(fd, line, n) != n) {
+        ::printf("Failed to write summary %s\n", summary_filename);
+    }
+    if (fd != -1) {
+        ::close(fd);
+    }
+}
+
+/*
+  report EKF throughput for --metrics-only
+ */
+void Replay::report_metrics(void)
+{
+    const float wall_s = (wall_micros() - wall_start_us) * 1.0e-6f;
+    const float ekf_s = ekf_time_us * 1.0e-6f;
+    const float log_s = AP_HAL::millis() * 0.001f;
+    ::printf("EKF: %u updates in %.2f seconds, %.0f updates/second\n",
+             (unsigned)ekf_updates, ekf_s,
+             ekf_s > 0 ? ekf_updates / ekf_s : 0.0f);
+    ::printf("Replayed %.1f seconds of log in %.2f seconds, %.1fx realtime\n",
+             log_s, wall_s, wall_s > 0 ? log_s / wall_s : 0.0f);
+}
+
 void Replay::flush_and_exit()
 {
     flush_logger();
 
+    if (summary_filename != nullptr) {
+        write_summary();
+    }
+
+    if (metrics_only) {
+        report_metrics();
+    }
+
     if (check_solution) {
         report_checks();
     }
@@ -833,6 +1028,11 @@ void Replay::loop()
     }
     last_timestamp = AP_HAL::micros64();
 
+    if (end_time > 0 && last_timestamp > end_time * 1.0e6) {
+        ::printf("End of replay at %.1f seconds\n", AP_HAL::millis()*0.001f);
+        flush_and_exit();
+    }
+
     if (streq(type, "FMT")) {
         if (!seen_non_fmt) {
             return;
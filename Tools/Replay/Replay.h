@@ -77,6 +77,9 @@ public:
     };
     AP_Logger logger{unused};
 
+    // don't start the logger, for replays with no output log
+    bool logging_disabled = false;
+
 protected:
 
     void init_ardupilot() override;
@@ -159,6 +162,31 @@ private:
     uint32_t output_counter = 0;
     uint64_t last_timestamp = 0;
     bool packet_counts = false;
+    // time window to replay in seconds, zero for the whole log
+    float start_time = 0;
+    float end_time = 0;
+    bool index_only = false;
+
+    // only replay the EKF and write the kept types to the output log
+    bool metrics_only = false;
+    const char **keep_types = nullptr;
+    uint64_t wall_start_us = 0;
+    uint64_t ekf_time_us = 0;
+    uint32_t ekf_updates = 0;
+
+    // EKF statistics for --summary
+    const char *summary_filename = nullptr;
+    const char *run_name = nullptr;
+    struct {
+        uint32_t updates;
+        uint32_t healthy_updates;
+        uint32_t health_changes;
+        uint32_t variance_count;
+        // normalised innovation test ratios for velocity, position,
+        // height, magnetometer and airspeed
+        double ratio_sum[5];
+        float ratio_max[5];
+    } summary {};
 
     struct {
         float max_roll_error;
@@ -195,6 +223,10 @@ private:
     void load_param_file(const char *filename);
     void set_signal_handlers(void);
     void flush_and_exit();
+    void update_summary(void);
+    bool output_type(const char *name) const;
+    void report_metrics(void);
+    void write_summary(void);
 
     FILE *xfopen(const char *f, const char *mode);
 
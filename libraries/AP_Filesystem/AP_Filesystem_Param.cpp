@@ -0,0 +1,588 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  ArduPilot filesystem interface for parameters. Reading param.pck
+  gives all parameters in a packed form, so a GCS can fetch them in a
+  single FTP transfer rather than a PARAM_VALUE message each
+ */
+#include "AP_Filesystem.h"
+#include "AP_Filesystem_Param.h"
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Math/AP_Math.h>
+#include <AP_Logger/AP_Logger.h>
+#include <GCS_MAVLink/GCS.h>
+
+extern const AP_HAL::HAL& hal;
+
+#if HAVE_FILESYSTEM_SUPPORT
+
+#define PACKED_NAME "param.pck"
+
+// largest file we accept writes of
+#define PACKED_MAX_WRITE_SIZE 65536U
+
+bool AP_Filesystem_Param::check_name(const char *fname) const
+{
+    return strcmp(fname, PACKED_NAME) == 0;
+}
+
+uint8_t AP_Filesystem_Param::pack_value(const AP_Param *ap, enum ap_var_type ptype, uint8_t *buf)
+{
+    switch (ptype) {
+    case AP_PARAM_INT8: {
+        const int8_t v = ((const AP_Int8 *)ap)->get();
+        memcpy(buf, &v, sizeof(v));
+        return sizeof(v);
+    }
+    case AP_PARAM_INT16: {
+        const int16_t v = ((const AP_Int16 *)ap)->get();
+        memcpy(buf, &v, sizeof(v));
+        return sizeof(v);
+    }
+    case AP_PARAM_INT32: {
+        const int32_t v = ((const AP_Int32 *)ap)->get();
+        memcpy(buf, &v, sizeof(v));
+        return sizeof(v);
+    }
+    case AP_PARAM_FLOAT: {
+        const float v = ((const AP_Float *)ap)->get();
+        memcpy(buf, &v, sizeof(v));
+        return sizeof(v);
+    }
+    default:
+        break;
+    }
+    return 0;
+}
+
+uint8_t AP_Filesystem_Param::pack_default(enum ap_var_type ptype, float value, uint8_t *buf)
+{
+    switch (ptype) {
+    case AP_PARAM_INT8: {
+        const int8_t v = value;
+        memcpy(buf, &v, sizeof(v));
+        return sizeof(v);
+    }
+    case AP_PARAM_INT16: {
+        const int16_t v = value;
+        memcpy(buf, &v, sizeof(v));
+        return sizeof(v);
+    }
+    case AP_PARAM_INT32: {
+        const int32_t v = value;
+        memcpy(buf, &v, sizeof(v));
+        return sizeof(v);
+    }
+    case AP_PARAM_FLOAT:
+        memcpy(buf, &value, sizeof(value));
+        return sizeof(value);
+    default:
+        break;
+    }
+    return 0;
+}
+
+/*
+  start a cursor at the file header
+ */
+void AP_Filesystem_Param::reset_cursor(struct cursor &c) const
+{
+    c.ap = nullptr;
+    c.started = false;
+    c.packed_ofs = 0;
+    const uint16_t magic = packed_magic;
+    const uint16_t count = AP_Param::count_parameters();
+    memcpy(&c.packed[0], &magic, sizeof(magic));
+    memcpy(&c.packed[2], &count, sizeof(count));
+    c.packed_len = 4;
+    c.last_name[0] = 0;
+}
+
+/*
+  move a cursor on to the next parameter, packing it into the cursor
+ */
+bool AP_Filesystem_Param::advance_cursor(struct cursor &c) const
+{
+    c.packed_ofs += c.packed_len;
+    c.packed_len = 0;
+
+    if (!c.started) {
+        c.started = true;
+        c.ap = AP_Param::first(&c.token, &c.ptype);
+    } else if (c.ap != nullptr) {
+        c.ap = AP_Param::next_scalar(&c.token, &c.ptype);
+    }
+    while (c.ap != nullptr && c.ptype > AP_PARAM_FLOAT) {
+        c.ap = AP_Param::next_scalar(&c.token, &c.ptype);
+    }
+    if (c.ap == nullptr) {
+        return false;
+    }
+
+    char name[AP_MAX_NAME_SIZE+1];
+    c.ap->copy_name_token(c.token, name, sizeof(name), true);
+    name[AP_MAX_NAME_SIZE] = 0;
+    const uint8_t name_len = strlen(name);
+    if (name_len == 0) {
+        // should not happen, skip it
+        return advance_cursor(c);
+    }
+
+    // share as much of the name with the previous one as we can, but
+    // send at least one character
+    uint8_t common_len = 0;
+    while (common_len < 15 && common_len < name_len-1 &&
+           name[common_len] == c.last_name[common_len]) {
+        common_len++;
+    }
+    const uint8_t new_len = name_len - common_len;
+
+    uint8_t *p = c.packed;
+    p[0] = c.ptype;
+    p[1] = common_len | ((new_len-1)<<4);
+    p += 2;
+    memcpy(p, &name[common_len], new_len);
+    p += new_len;
+    const uint8_t value_len = pack_value(c.ap, c.ptype, p);
+    p += value_len;
+
+    // include the default if the parameter has been changed from it
+    float def_value;
+    if (c.ap->get_default_token(c.token, def_value) &&
+        pack_default(c.ptype, def_value, p) == value_len &&
+        memcmp(p, p-value_len, value_len) != 0) {
+        c.packed[0] |= PACKED_FLAG_DEFAULT<<4;
+        p += value_len;
+    }
+
+    c.packed_len = p - c.packed;
+    memcpy(c.last_name, name, sizeof(name));
+    return true;
+}
+
+/*
+  size of the file, found by generating all of it
+ */
+uint32_t AP_Filesystem_Param::file_size(void) const
+{
+    struct cursor c;
+    reset_cursor(c);
+    while (advance_cursor(c)) {
+    }
+    return c.packed_ofs;
+}
+
+/*
+  generate the whole file into r.data. A parameter changing while the
+  file is read would otherwise change the length of the file part way
+  through, as the default is only included for changed parameters
+ */
+bool AP_Filesystem_Param::snapshot(struct rfile &r) const
+{
+    // leave some room for parameters changing while we generate
+    uint32_t space = file_size() + 2*max_packed_size;
+    uint8_t *data = (uint8_t *)malloc(space);
+    if (data == nullptr) {
+        return false;
+    }
+    struct cursor c;
+    reset_cursor(c);
+    do {
+        if (c.packed_ofs + c.packed_len > space) {
+            space = MAX(space + space/8, c.packed_ofs + c.packed_len);
+            uint8_t *d = (uint8_t *)realloc(data, space);
+            if (d == nullptr) {
+                free(data);
+                return false;
+            }
+            data = d;
+        }
+        memcpy(&data[c.packed_ofs], c.packed, c.packed_len);
+    } while (advance_cursor(c));
+    r.data = data;
+    r.size = c.packed_ofs;
+    r.space = space;
+    return true;
+}
+
+/*
+  set and save the parameters in a written file. The file is checked
+  in full before any parameters are set, so a truncated or corrupt
+  file changes nothing. On failure reason is set to why the file was
+  rejected
+ */
+bool AP_Filesystem_Param::apply_params(const uint8_t *data, uint32_t size, const char *&reason) const
+{
+    uint16_t magic, count;
+    if (size < 4) {
+        reason = "short header";
+        return false;
+    }
+    memcpy(&magic, &data[0], sizeof(magic));
+    memcpy(&count, &data[2], sizeof(count));
+    if (magic != packed_magic) {
+        reason = "bad magic";
+        return false;
+    }
+
+    for (uint8_t pass=0; pass<2; pass++) {
+        const bool apply = (pass == 1);
+        char name[AP_MAX_NAME_SIZE+1] {};
+        uint32_t ofs = 4;
+        uint16_t num_params = 0;
+        while (ofs < size) {
+            if (size - ofs < 2) {
+                reason = "truncated";
+                return false;
+            }
+            const enum ap_var_type type = (enum ap_var_type)(data[ofs] & 0x0F);
+            const uint8_t flags = data[ofs] >> 4;
+            const uint8_t common_len = data[ofs+1] & 0x0F;
+            const uint8_t new_len = (data[ofs+1] >> 4) + 1;
+            ofs += 2;
+            if (type < AP_PARAM_INT8 || type > AP_PARAM_FLOAT ||
+                common_len > strlen(name) ||
+                common_len + new_len > AP_MAX_NAME_SIZE ||
+                size - ofs < new_len) {
+                reason = "bad entry";
+                return false;
+            }
+            memcpy(&name[common_len], &data[ofs], new_len);
+            name[common_len+new_len] = 0;
+            ofs += new_len;
+
+            const uint8_t value_len = type == AP_PARAM_INT8 ? 1 : type == AP_PARAM_INT16 ? 2 : 4;
+            const uint8_t packed_len = (flags & PACKED_FLAG_DEFAULT) ? 2*value_len : value_len;
+            if (size - ofs < packed_len) {
+                reason = "truncated";
+                return false;
+            }
+            const uint8_t *v = &data[ofs];
+            ofs += packed_len;
+            num_params++;
+
+            if (!apply) {
+                continue;
+            }
+
+            int32_t ivalue = 0;
+            float fvalue;
+            switch (type) {
+            case AP_PARAM_INT8:
+                ivalue = (int8_t)v[0];
+                fvalue = ivalue;
+                break;
+            case AP_PARAM_INT16: {
+                int16_t v16;
+                memcpy(&v16, v, sizeof(v16));
+                ivalue = v16;
+                fvalue = ivalue;
+                break;
+            }
+            case AP_PARAM_INT32:
+                memcpy(&ivalue, v, sizeof(ivalue));
+                fvalue = ivalue;
+                break;
+            default:
+                memcpy(&fvalue, v, sizeof(fvalue));
+                break;
+            }
+
+            // same checks as a PARAM_SET
+            enum ap_var_type ptype;
+            uint16_t parameter_flags = 0;
+            AP_Param *vp = AP_Param::find(name, &ptype, &parameter_flags);
+            if (vp == nullptr || isnan(fvalue) || isinf(fvalue)) {
+                continue;
+            }
+            if ((parameter_flags & AP_PARAM_FLAG_INTERNAL_USE_ONLY) ||
+                vp->is_read_only()) {
+                // a GCS usually sends back the whole file, so only
+                // complain about attempts to change the value
+                if (!is_equal(fvalue, vp->cast_to_float(ptype))) {
+                    gcs().send_text(MAV_SEVERITY_WARNING, "Param write denied (%s)", name);
+                }
+                continue;
+            }
+
+            // only save parameters which change, a GCS will usually
+            // send back a file which is mostly unchanged
+            uint8_t old_value[4], new_value[4];
+            const uint8_t len = pack_value(vp, ptype, old_value);
+            if (ptype == AP_PARAM_INT32 && type == AP_PARAM_INT32) {
+                // avoid the loss of precision of going through a float
+                ((AP_Int32 *)vp)->set(ivalue);
+            } else {
+                vp->set_float(fvalue, ptype);
+            }
+            if (pack_value(vp, ptype, new_value) != len ||
+                memcmp(old_value, new_value, len) != 0) {
+                vp->save(true);
+                AP_Logger *logger = AP_Logger::get_singleton();
+                if (logger != nullptr) {
+                    logger->Write_Parameter(name, vp->cast_to_float(ptype));
+                }
+            }
+        }
+        if (num_params != count) {
+            reason = "count mismatch";
+            return false;
+        }
+    }
+    return true;
+}
+
+int AP_Filesystem_Param::open(const char *fname, int flags)
+{
+    if (!check_name(fname)) {
+        errno = ENOENT;
+        return -1;
+    }
+    if ((flags & O_ACCMODE) == O_RDWR) {
+        errno = EINVAL;
+        return -1;
+    }
+    if ((flags & O_ACCMODE) == O_WRONLY && hal.util->get_soft_armed()) {
+        // saves are dropped when the storage queue is full while
+        // armed, so a whole file of changes could be partly lost
+        gcs().send_text(MAV_SEVERITY_WARNING, "Param file write rejected while armed");
+        errno = EBUSY;
+        return -1;
+    }
+    uint8_t idx;
+    for (idx=0; idx<max_open_file; idx++) {
+        if (!file[idx].open) {
+            break;
+        }
+    }
+    if (idx == max_open_file) {
+        errno = ENFILE;
+        return -1;
+    }
+    struct rfile &r = file[idx];
+    r.open = true;
+    r.writing = (flags & O_ACCMODE) == O_WRONLY;
+    r.ofs = 0;
+    r.data = nullptr;
+    r.size = 0;
+    r.space = 0;
+    if (!r.writing && !snapshot(r)) {
+        r.open = false;
+        errno = ENOMEM;
+        return -1;
+    }
+    return idx;
+}
+
+int AP_Filesystem_Param::close(int fd)
+{
+    if (fd < 0 || fd >= max_open_file || !file[fd].open) {
+        errno = EBADF;
+        return -1;
+    }
+    struct rfile &r = file[fd];
+    bool ok = true;
+    if (r.writing) {
+        const char *reason = "";
+        ok = apply_params(r.data, r.size, reason);
+        if (!ok) {
+            gcs().send_text(MAV_SEVERITY_WARNING, "Param file rejected: %s", reason);
+        }
+    }
+    free(r.data);
+    r.data = nullptr;
+    r.open = false;
+    if (!ok) {
+        errno = EINVAL;
+        return -1;
+    }
+    return 0;
+}
+
+ssize_t AP_Filesystem_Param::read(int fd, void *buf, size_t count)
+{
+    if (fd < 0 || fd >= max_open_file || !file[fd].open || file[fd].writing) {
+        errno = EBADF;
+        return -1;
+    }
+    struct rfile &r = file[fd];
+    if (r.ofs >= r.size) {
+        return 0;
+    }
+    const uint32_t n = MIN(count, r.size - r.ofs);
+    memcpy(buf, &r.data[r.ofs], n);
+    r.ofs += n;
+    return n;
+}
+
+ssize_t AP_Filesystem_Param::write(int fd, const void *buf, size_t count)
+{
+    if (fd < 0 || fd >= max_open_file || !file[fd].open || !file[fd].writing) {
+        errno = EBADF;
+        return -1;
+    }
+    struct rfile &r = file[fd];
+    const uint32_t end = r.ofs + count;
+    if (end > PACKED_MAX_WRITE_SIZE) {
+        errno = EFBIG;
+        return -1;
+    }
+    if (end > r.space) {
+        const uint32_t space = MIN(PACKED_MAX_WRITE_SIZE, MAX(end, MAX(r.space*2, 1024U)));
+        uint8_t *data = (uint8_t *)realloc(r.data, space);
+        if (data == nullptr) {
+            errno = ENOMEM;
+            return -1;
+        }
+        r.data = data;
+        r.space = space;
+    }
+    if (r.ofs > r.size) {
+        memset(&r.data[r.size], 0, r.ofs - r.size);
+    }
+    memcpy(&r.data[r.ofs], buf, count);
+    r.ofs = end;
+    r.size = MAX(r.size, end);
+    return count;
+}
+
+int AP_Filesystem_Param::fsync(int fd)
+{
+    return 0;
+}
+
+off_t AP_Filesystem_Param::lseek(int fd, off_t offset, int seek_from)
+{
+    if (fd < 0 || fd >= max_open_file || !file[fd].open) {
+        errno = EBADF;
+        return -1;
+    }
+    struct rfile &r = file[fd];
+    off_t ofs;
+    switch (seek_from) {
+    case SEEK_SET:
+        ofs = offset;
+        break;
+    case SEEK_CUR:
+        ofs = r.ofs + offset;
+        break;
+    case SEEK_END:
+        ofs = r.size + offset;
+        break;
+    default:
+        errno = EINVAL;
+        return -1;
+    }
+    if (ofs < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    r.ofs = ofs;
+    return r.ofs;
+}
+
+int AP_Filesystem_Param::stat(const char *name, struct stat *stbuf)
+{
+    if (!check_name(name)) {
+        errno = ENOENT;
+        return -1;
+    }
+    memset(stbuf, 0, sizeof(*stbuf));
+    stbuf->st_size = file_size();
+    return 0;
+}
+
+int AP_Filesystem_Param::unlink(const char *pathname)
+{
+    errno = EROFS;
+    return -1;
+}
+
+int AP_Filesystem_Param::mkdir(const char *pathname)
+{
+    errno = EROFS;
+    return -1;
+}
+
+void *AP_Filesystem_Param::opendir(const char *pathname)
+{
+    if (strlen(pathname) > 0) {
+        // there are no subdirectories
+        errno = ENOENT;
+        return nullptr;
+    }
+    uint8_t idx;
+    for (idx=0; idx<max_open_dir; idx++) {
+        if (!dir[idx].open) {
+            break;
+        }
+    }
+    if (idx == max_open_dir) {
+        errno = ENFILE;
+        return nullptr;
+    }
+    dir[idx].open = true;
+    dir[idx].ofs = 0;
+    return (void*)&dir[idx];
+}
+
+struct dirent *AP_Filesystem_Param::readdir(void *dirp)
+{
+    uint32_t idx = ((rdir*)dirp) - &dir[0];
+    if (idx >= max_open_dir) {
+        errno = EBADF;
+        return nullptr;
+    }
+    if (dir[idx].ofs > 0) {
+        return nullptr;
+    }
+    dir[idx].de.d_type = DT_REG;
+    strncpy(dir[idx].de.d_name, PACKED_NAME, sizeof(dir[idx].de.d_name));
+    dir[idx].ofs++;
+    return &dir[idx].de;
+}
+
+int AP_Filesystem_Param::closedir(void *dirp)
+{
+    uint32_t idx = ((rdir *)dirp) - &dir[0];
+    if (idx >= max_open_dir) {
+        errno = EBADF;
+        return -1;
+    }
+    dir[idx].open = false;
+    return 0;
+}
+
+// return free disk space in bytes
+int64_t AP_Filesystem_Param::disk_free(const char *path)
+{
+    return 0;
+}
+
+// return total disk space in bytes
+int64_t AP_Filesystem_Param::disk_space(const char *path)
+{
+    return 0;
+}
+
+/*
+  set mtime on a file
+ */
+bool AP_Filesystem_Param::set_mtime(const char *filename, const time_t mtime_sec)
+{
+    return false;
+}
+
+#endif // HAVE_FILESYSTEM_SUPPORT
@@ -0,0 +1,134 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "AP_Filesystem_backend.h"
+
+#if HAVE_FILESYSTEM_SUPPORT
+
+#include <AP_Param/AP_Param.h>
+
+/*
+  packed parameter file, @PARAM/param.pck
+
+  The file starts with a header of uint16_t magic (0x671B) and
+  uint16_t count of parameters, followed by each parameter in the
+  order of AP_Param::next_scalar():
+
+    uint8_t  type in the low 4 bits (AP_PARAM_INT8 to AP_PARAM_FLOAT),
+             flags in the high 4 bits
+    uint8_t  length of the name shared with the previous parameter in
+             the low 4 bits, one less than the number of name characters
+             which follow in the high 4 bits
+    char     the rest of the name, not null terminated
+    value    1, 2 or 4 bytes depending on type, little endian
+    default  same size as value, only present if PACKED_FLAG_DEFAULT is
+             set, meaning the default is not the current value
+
+  Writing a file in the same format sets and saves each parameter in it
+  when the file is closed. Defaults in a written file are ignored.
+ */
+class AP_Filesystem_Param : public AP_Filesystem_Backend
+{
+public:
+    // functions that closely match the equivalent posix calls
+    int open(const char *fname, int flags) override;
+    int close(int fd) override;
+    ssize_t read(int fd, void *buf, size_t count) override;
+    ssize_t write(int fd, const void *buf, size_t count) override;
+    int fsync(int fd) override;
+    off_t lseek(int fd, off_t offset, int whence) override;
+    int stat(const char *pathname, struct stat *stbuf) override;
+    int unlink(const char *pathname) override;
+    int mkdir(const char *pathname) override;
+    void *opendir(const char *pathname) override;
+    struct dirent *readdir(void *dirp) override;
+    int closedir(void *dirp) override;
+
+    // return free disk space in bytes, -1 on error
+    int64_t disk_free(const char *path) override;
+
+    // return total disk space in bytes, -1 on error
+    int64_t disk_space(const char *path) override;
+
+    // set modification time on a file
+    bool set_mtime(const char *filename, const time_t mtime_sec) override;
+
+private:
+    static constexpr uint16_t packed_magic = 0x671B;
+    static constexpr uint8_t PACKED_FLAG_DEFAULT = 1U<<0;
+
+    static constexpr uint8_t max_open_file = 4;
+    static constexpr uint8_t max_open_dir = 4;
+
+    // largest packed parameter, the file header is smaller
+    static constexpr uint8_t max_packed_size = 2 + AP_MAX_NAME_SIZE + 2*sizeof(float);
+
+    // generates a file one parameter at a time
+    struct cursor {
+        AP_Param::ParamToken token;
+        AP_Param *ap;
+        enum ap_var_type ptype;
+        bool started;
+        // file offset of the start of packed[]
+        uint32_t packed_ofs;
+        uint8_t packed_len;
+        uint8_t packed[max_packed_size];
+        char last_name[AP_MAX_NAME_SIZE+1];
+    };
+
+    struct rfile {
+        bool open;
+        bool writing;
+        uint32_t ofs;
+        // the file as generated when opened for reading, or the data
+        // written, which is applied on close
+        uint8_t *data;
+        uint32_t size;
+        uint32_t space;
+    } file[max_open_file];
+
+    struct rdir {
+        bool open;
+        uint8_t ofs;
+        struct dirent de;
+    } dir[max_open_dir];
+
+    bool check_name(const char *fname) const;
+
+    // start generating a file from the beginning
+    void reset_cursor(struct cursor &c) const;
+
+    // generate the next piece of a file, returning false at the end
+    bool advance_cursor(struct cursor &c) const;
+
+    // total size of the generated file
+    uint32_t file_size(void) const;
+
+    // generate the file for reading into r
+    bool snapshot(struct rfile &r) const;
+
+    // pack the value of a parameter, returning its length
+    static uint8_t pack_value(const AP_Param *ap, enum ap_var_type ptype, uint8_t *buf);
+
+    // pack a default value as a parameter of type ptype
+    static uint8_t pack_default(enum ap_var_type ptype, float value, uint8_t *buf);
+
+    // set and save the parameters in a written file, setting reason on failure
+    bool apply_params(const uint8_t *data, uint32_t size, const char *&reason) const;
+};
+
+#endif // HAVE_FILESYSTEM_SUPPORT
@@ -0,0 +1,259 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  ArduPilot filesystem interface for system information files. The
+  contents of each file are generated when it is opened
+ */
+#include "AP_Filesystem.h"
+#include "AP_Filesystem_Sys.h"
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Math/AP_Math.h>
+#include <AP_Scheduler/AP_Scheduler.h>
+#include <AP_Param/AP_Param.h>
+#ifndef HAL_NO_GCS
+#include <GCS_MAVLink/GCS.h>
+#endif
+
+#if HAVE_FILESYSTEM_SUPPORT
+
+static const char *sysfs_file_list[] = {
+    "tasks.txt",
+    "param_saves.txt",
+#ifndef HAL_NO_GCS
+    "routes.txt",
+#endif
+};
+
+/*
+  generate the contents of a system file
+ */
+char *AP_Filesystem_Sys::generate(const char *fname, uint32_t &size) const
+{
+    if (strcmp(fname, "tasks.txt") == 0) {
+        AP_Scheduler *sched = AP_Scheduler::get_singleton();
+        if (sched == nullptr) {
+            return nullptr;
+        }
+        // the table may grow between the two calls, any excess is
+        // truncated
+        size = sched->task_info(nullptr, 0);
+        char *data = (char *)malloc(size+1);
+        if (data == nullptr) {
+            return nullptr;
+        }
+        size = MIN(sched->task_info(data, size+1), size);
+        return data;
+    }
+    if (strcmp(fname, "param_saves.txt") == 0) {
+        size = AP_Param::save_info(nullptr, 0);
+        char *data = (char *)malloc(size+1);
+        if (data == nullptr) {
+            return nullptr;
+        }
+        size = MIN(AP_Param::save_info(data, size+1), size);
+        return data;
+    }
+#ifndef HAL_NO_GCS
+    if (strcmp(fname, "routes.txt") == 0) {
+        size = GCS_MAVLINK::routing_info(nullptr, 0);
+        char *data = (char *)malloc(size+1);
+        if (data == nullptr) {
+            return nullptr;
+        }
+        size = MIN(GCS_MAVLINK::routing_info(data, size+1), size);
+        return data;
+    }
+#endif
+    return nullptr;
+}
+
+int AP_Filesystem_Sys::open(const char *fname, int flags)
+{
+    if ((flags & O_ACCMODE) != O_RDONLY) {
+        errno = EROFS;
+        return -1;
+    }
+    uint8_t idx;
+    for (idx=0; idx<max_open_file; idx++) {
+        if (file[idx].data == nullptr) {
+            break;
+        }
+    }
+    if (idx == max_open_file) {
+        errno = ENFILE;
+        return -1;
+    }
+    file[idx].data = generate(fname, file[idx].size);
+    if (file[idx].data == nullptr) {
+        errno = ENOENT;
+        return -1;
+    }
+    file[idx].ofs = 0;
+    return idx;
+}
+
+int AP_Filesystem_Sys::close(int fd)
+{
+    if (fd < 0 || fd >= max_open_file || file[fd].data == nullptr) {
+        errno = EBADF;
+        return -1;
+    }
+    free(file[fd].data);
+    file[fd].data = nullptr;
+    return 0;
+}
+
+ssize_t AP_Filesystem_Sys::read(int fd, void *buf, size_t count)
+{
+    if (fd < 0 || fd >= max_open_file || file[fd].data == nullptr) {
+        errno = EBADF;
+        return -1;
+    }
+    count = MIN(file[fd].size - file[fd].ofs, count);
+    if (count == 0) {
+        return 0;
+    }
+    memcpy(buf, &file[fd].data[file[fd].ofs], count);
+    file[fd].ofs += count;
+    return count;
+}
+
+ssize_t AP_Filesystem_Sys::write(int fd, const void *buf, size_t count)
+{
+    errno = EROFS;
+    return -1;
+}
+
+int AP_Filesystem_Sys::fsync(int fd)
+{
+    return 0;
+}
+
+off_t AP_Filesystem_Sys::lseek(int fd, off_t offset, int seek_from)
+{
+    if (fd < 0 || fd >= max_open_file || file[fd].data == nullptr) {
+        errno = EBADF;
+        return -1;
+    }
+    switch (seek_from) {
+    case SEEK_SET:
+        file[fd].ofs = MIN(file[fd].size, offset);
+        break;
+    case SEEK_CUR:
+        file[fd].ofs = MIN(file[fd].size, offset+file[fd].ofs);
+        break;
+    case SEEK_END:
+        file[fd].ofs = file[fd].size;
+        break;
+    }
+    return file[fd].ofs;
+}
+
+int AP_Filesystem_Sys::stat(const char *name, struct stat *stbuf)
+{
+    uint32_t size;
+    char *data = generate(name, size);
+    if (data == nullptr) {
+        errno = ENOENT;
+        return -1;
+    }
+    free(data);
+    memset(stbuf, 0, sizeof(*stbuf));
+    stbuf->st_size = size;
+    return 0;
+}
+
+int AP_Filesystem_Sys::unlink(const char *pathname)
+{
+    errno = EROFS;
+    return -1;
+}
+
+int AP_Filesystem_Sys::mkdir(const char *pathname)
+{
+    errno = EROFS;
+    return -1;
+}
+
+void *AP_Filesystem_Sys::opendir(const char *pathname)
+{
+    if (strlen(pathname) > 0) {
+        // there are no subdirectories
+        errno = ENOENT;
+        return nullptr;
+    }
+    uint8_t idx;
+    for (idx=0; idx<max_open_dir; idx++) {
+        if (!dir[idx].open) {
+            break;
+        }
+    }
+    if (idx == max_open_dir) {
+        errno = ENFILE;
+        return nullptr;
+    }
+    dir[idx].open = true;
+    dir[idx].ofs = 0;
+    return (void*)&dir[idx];
+}
+
+struct dirent *AP_Filesystem_Sys::readdir(void *dirp)
+{
+    uint32_t idx = ((rdir*)dirp) - &dir[0];
+    if (idx >= max_open_dir) {
+        errno = EBADF;
+        return nullptr;
+    }
+    if (dir[idx].ofs >= ARRAY_SIZE(sysfs_file_list)) {
+        return nullptr;
+    }
+    dir[idx].de.d_type = DT_REG;
+    strncpy(dir[idx].de.d_name, sysfs_file_list[dir[idx].ofs], sizeof(dir[idx].de.d_name));
+    dir[idx].ofs++;
+    return &dir[idx].de;
+}
+
+int AP_Filesystem_Sys::closedir(void *dirp)
+{
+    uint32_t idx = ((rdir *)dirp) - &dir[0];
+    if (idx >= max_open_dir) {
+        errno = EBADF;
+        return -1;
+    }
+    dir[idx].open = false;
+    return 0;
+}
+
+// return free disk space in bytes
+int64_t AP_Filesystem_Sys::disk_free(const char *path)
+{
+    return 0;
+}
+
+// return total disk space in bytes
+int64_t AP_Filesystem_Sys::disk_space(const char *path)
+{
+    return 0;
+}
+
+/*
+  set mtime on a file
+ */
+bool AP_Filesystem_Sys::set_mtime(const char *filename, const time_t mtime_sec)
+{
+    return false;
+}
+
+#endif // HAVE_FILESYSTEM_SUPPORT
@@ -172,6 +172,11 @@
 #define HAL_HAVE_GETTIME_SETTIME 0
 #endif
 
+// true when the FPU does double precision arithmetic in hardware
+#ifndef HAL_HAVE_HARDWARE_DOUBLE
+#define HAL_HAVE_HARDWARE_DOUBLE 0
+#endif
+
 // this is used as a general mechanism to make a 'small' build by
 // dropping little used features. We use this to allow us to keep
 // FMUv2 going for as long as possible
@@ -48,3 +48,24 @@ private:
 #define WITH_SEMAPHORE( sem ) JOIN( sem, __LINE__, __COUNTER__ )
 #define JOIN( sem, line, counter ) _DO_JOIN( sem, line, counter )
 #define _DO_JOIN( sem, line, counter ) WithSemaphore _getsem ## counter(sem, line)
+
+/*
+  a binary semaphore is used to signal an event from one thread to
+  another. wait() blocks until signal() has been called, consuming the
+  signal. Multiple signals before a wait are collapsed into one.
+
+  HALs which support it define HAL_BinarySemaphore
+ */
+class AP_HAL::BinarySemaphore {
+public:
+    virtual ~BinarySemaphore(void) {}
+
+    // wait up to timeout_us for a signal, returning true if signalled
+    virtual bool wait(uint32_t timeout_us) WARN_IF_UNUSED = 0;
+
+    // wait forever for a signal
+    virtual bool wait_blocking(void) = 0;
+
+    // signal the semaphore, waking any waiting thread
+    virtual void signal(void) = 0;
+};
@@ -305,6 +305,8 @@
 #define HAL_HAVE_BOARD_VOLTAGE 1
 #define HAL_HAVE_SAFETY_SWITCH 0
 
+#define HAL_HAVE_HARDWARE_DOUBLE 1
+
 
 #ifndef HAL_HAVE_SERVO_VOLTAGE
     #define HAL_HAVE_SERVO_VOLTAGE 0
@@ -347,4 +349,6 @@
 
 #include <AP_HAL_Linux/Semaphores.h>
 #define HAL_Semaphore Linux::Semaphore
+#include <AP_HAL/utility/BinarySemaphore_pthread.h>
+#define HAL_BinarySemaphore BinarySemaphore_pthread
 
@@ -5,6 +5,7 @@
 #define HAL_MEM_CLASS HAL_MEM_CLASS_1000
 #define HAL_OS_POSIX_IO 1
 #define HAL_OS_SOCKETS 1
+#define HAL_HAVE_HARDWARE_DOUBLE 1
 
 #define AP_FLASHSTORAGE_TYPE 3
 
@@ -57,6 +58,8 @@
 // allow for static semaphores
 #include <AP_HAL_SITL/Semaphores.h>
 #define HAL_Semaphore HALSITL::Semaphore
+#include <AP_HAL/utility/BinarySemaphore_pthread.h>
+#define HAL_BinarySemaphore BinarySemaphore_pthread
 
 #ifndef HAL_BOARD_STORAGE_DIRECTORY
 #define HAL_BOARD_STORAGE_DIRECTORY "."
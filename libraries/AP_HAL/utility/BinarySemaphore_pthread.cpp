@@ -0,0 +1,82 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  binary semaphore, implemented with a condition variable
+ */
+
+#include <AP_HAL/AP_HAL.h>
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_LINUX || CONFIG_HAL_BOARD == HAL_BOARD_SITL
+
+#include "BinarySemaphore_pthread.h"
+#include <time.h>
+
+BinarySemaphore_pthread::BinarySemaphore_pthread(bool initial_state) :
+    _pending(initial_state)
+{
+    pthread_mutex_init(&_lock, nullptr);
+    // timed waits use the monotonic clock so they are not affected by
+    // changes to the system time
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&_cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+bool BinarySemaphore_pthread::wait(uint32_t timeout_us)
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+        return false;
+    }
+    ts.tv_sec += timeout_us / 1000000UL;
+    ts.tv_nsec += (timeout_us % 1000000UL) * 1000UL;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    pthread_mutex_lock(&_lock);
+    while (!_pending) {
+        if (pthread_cond_timedwait(&_cond, &_lock, &ts) != 0) {
+            break;
+        }
+    }
+    const bool ret = _pending;
+    _pending = false;
+    pthread_mutex_unlock(&_lock);
+    return ret;
+}
+
+bool BinarySemaphore_pthread::wait_blocking(void)
+{
+    pthread_mutex_lock(&_lock);
+    while (!_pending) {
+        pthread_cond_wait(&_cond, &_lock);
+    }
+    _pending = false;
+    pthread_mutex_unlock(&_lock);
+    return true;
+}
+
+void BinarySemaphore_pthread::signal(void)
+{
+    pthread_mutex_lock(&_lock);
+    _pending = true;
+    pthread_cond_signal(&_cond);
+    pthread_mutex_unlock(&_lock);
+}
+
+#endif // CONFIG_HAL_BOARD
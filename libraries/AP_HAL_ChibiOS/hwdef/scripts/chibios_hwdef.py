@@ -610,6 +610,10 @@ def write_mcu_config(f):
     f.write('#define %s\n\n' % mcu_subtype)
     f.write('// crystal frequency\n')
     f.write('#define STM32_HSECLK %sU\n\n' % get_config('OSCILLATOR_HZ'))
+    cpu_flags = get_mcu_config('CPU_FLAGS')
+    if cpu_flags and '-mfpu=fpv5-d16' in cpu_flags.split():
+        f.write('// the FPU supports double precision\n')
+        f.write('#define HAL_HAVE_HARDWARE_DOUBLE 1\n\n')
     f.write('// UART used for stdout (printf)\n')
     if get_config('STDOUT_SERIAL', required=False):
         f.write('#define HAL_STDOUT_SERIAL %s\n\n' % get_config('STDOUT_SERIAL'))
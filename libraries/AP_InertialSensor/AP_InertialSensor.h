@@ -40,6 +40,7 @@ class AP_AHRS;
   because of mutual dependencies
  */
 class AP_Logger;
+class LogDeltaBatch;
 
 /* AP_InertialSensor is an abstraction for gyro and accel measurements
  * which are correctly aligned to the body axes and scaled to SI units.
@@ -337,6 +338,11 @@ public:
         bool doing_sensor_rate_logging() const { return _doing_sensor_rate_logging; }
         bool doing_post_filter_logging() const { return _doing_post_filter_logging; }
 
+        // true if raw sensor messages should also be written as delta batches
+        bool delta_encode_raw() const {
+            return (batch_opt_t)(_batch_options_mask.get()) & BATCH_OPT_DELTA_RAW;
+        }
+
         // class level parameters
         static const struct AP_Param::GroupInfo var_info[];
 
@@ -363,6 +369,7 @@ public:
         enum batch_opt_t {
             BATCH_OPT_SENSOR_RATE = (1<<0),
             BATCH_OPT_POST_FILTER = (1<<1),
+            BATCH_OPT_DELTA_RAW = (1<<2),
         };
 
         void rotate_to_next_sensor();
@@ -558,6 +565,9 @@ private:
     // bitmask bit which indicates if we should log raw accel and gyro data
     uint32_t _log_raw_bit;
 
+    // delta batches for raw accel and gyro logging, allocated on first use
+    LogDeltaBatch *_raw_log_batch[INS_MAX_INSTANCES][2];
+
     // has wait_for_sample() found a sample?
     bool _have_sample:1;
 
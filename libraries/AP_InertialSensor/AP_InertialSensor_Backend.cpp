@@ -280,7 +280,7 @@ void AP_InertialSensor_Backend::log_gyro_raw(uint8_t instance, const uint64_t sa
             GyrY      : gyro.y,
             GyrZ      : gyro.z
         };
-        logger->WriteBlock(&pkt, sizeof(pkt));
+        log_raw_message(logger, instance, AP_InertialSensor::IMU_SENSOR_TYPE_GYRO, GYR_FMT, &pkt, sizeof(pkt));
     } else {
         if (!_imu.batchsampler.doing_sensor_rate_logging()) {
             _imu.batchsampler.sample(instance, AP_InertialSensor::IMU_SENSOR_TYPE_GYRO, sample_us, gyro);
@@ -435,7 +435,7 @@ void AP_InertialSensor_Backend::log_accel_raw(uint8_t instance, const uint64_t s
             AccY      : accel.y,
             AccZ      : accel.z
         };
-        logger->WriteBlock(&pkt, sizeof(pkt));
+        log_raw_message(logger, instance, AP_InertialSensor::IMU_SENSOR_TYPE_ACCEL, ACC_FMT, &pkt, sizeof(pkt));
     } else {
         if (!_imu.batchsampler.doing_sensor_rate_logging()) {
             _imu.batchsampler.sample(instance, AP_InertialSensor::IMU_SENSOR_TYPE_ACCEL, sample_us, accel);
@@ -583,6 +583,29 @@ void AP_InertialSensor_Backend::update_accel(uint8_t instance)
     }
 }
 
+/*
+  write a raw sensor message, and also add it to a delta batch if
+  enabled. The plain message is always written so that log tools which
+  don't know DBAT still see every sample, in order and on time. Each
+  batch is only used from the thread of the backend owning the instance
+ */
+void AP_InertialSensor_Backend::log_raw_message(AP_Logger *logger, uint8_t instance, AP_InertialSensor::IMU_SENSOR_TYPE type,
+                                                const char *fmt, const void *pkt, uint8_t size)
+{
+    logger->WriteBlock(pkt, size);
+    if (!_imu.batchsampler.delta_encode_raw()) {
+        return;
+    }
+    LogDeltaBatch *&batch = _imu._raw_log_batch[instance][type];
+    if (batch == nullptr) {
+        batch = logger->new_delta_batch(fmt);
+        if (batch == nullptr) {
+            return;
+        }
+    }
+    logger->WriteDeltaBatched(*batch, pkt, size);
+}
+
 bool AP_InertialSensor_Backend::should_log_imu_raw() const
 {
     if (_imu._log_raw_bit == (uint32_t)-1) {
@@ -320,5 +320,7 @@ private:
     bool should_log_imu_raw() const;
     void log_accel_raw(uint8_t instance, const uint64_t sample_us, const Vector3f &accel);
     void log_gyro_raw(uint8_t instance, const uint64_t sample_us, const Vector3f &gryo);
+    void log_raw_message(AP_Logger *logger, uint8_t instance, AP_InertialSensor::IMU_SENSOR_TYPE type,
+                         const char *fmt, const void *pkt, uint8_t size);
 
 };
@@ -92,6 +92,14 @@ const AP_Param::GroupInfo AP_Logger::var_info[] = {
     // @User: Standard
     // @Units: s
     AP_GROUPINFO("_FILE_TIMEOUT",  6, AP_Logger, _params.file_timeout,     HAL_LOGGING_FILE_TIMEOUT),
+
+    // @Param: _FILE_COMP
+    // @DisplayName: Compress log files
+    // @Description: When enabled, log files are written block compressed to reduce the write rate to the SD card. Compressed logs are decompressed when downloaded over MAVLink and when read by Replay, but other tools reading the log file directly from the card need to decompress it first.
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    // @RebootRequired: True
+    AP_GROUPINFO("_FILE_COMP",  7, AP_Logger, _params.file_compress,     0),
     
     AP_GROUPEND
 };
@@ -610,6 +618,8 @@ const struct MultiplierStructure *AP_Logger::multiplier(uint16_t num) const
 
 void AP_Logger::PrepForArming()
 {
+    // write out batched messages before any backend starts a new log
+    flush_delta_batches();
     FOR_EACH_BACKEND(PrepForArming());
 }
 
@@ -643,6 +653,56 @@ void AP_Logger::WriteCriticalBlock(const void *pBuffer, uint16_t size) {
     FOR_EACH_BACKEND(WriteCriticalBlock(pBuffer, size));
 }
 
+void AP_Logger::WriteDeltaBatched(LogDeltaBatch &batch, const void *pBuffer, uint16_t size) {
+    if (!batch.accepts(size)) {
+        WriteBlock(pBuffer, size);
+        return;
+    }
+    struct log_DeltaBatch pkt;
+    bool have_pkt;
+    {
+        WITH_SEMAPHORE(_delta_batch_sem);
+        have_pkt = batch.add(pBuffer, size, pkt);
+    }
+    if (have_pkt) {
+        WriteBlock(&pkt, sizeof(pkt));
+    }
+}
+
+LogDeltaBatch *AP_Logger::new_delta_batch(const char *fmt)
+{
+    LogDeltaBatch *batch = new LogDeltaBatch(fmt);
+    if (batch == nullptr) {
+        return nullptr;
+    }
+    WITH_SEMAPHORE(_delta_batch_sem);
+    batch->next = _delta_batches;
+    _delta_batches = batch;
+    return batch;
+}
+
+void AP_Logger::flush_delta_batches()
+{
+    LogDeltaBatch *batch;
+    {
+        WITH_SEMAPHORE(_delta_batch_sem);
+        batch = _delta_batches;
+    }
+    // batches are never removed from the list, so it can be walked
+    // without holding the semaphore
+    for (; batch != nullptr; batch = batch->next) {
+        struct log_DeltaBatch pkt;
+        bool have_pkt;
+        {
+            WITH_SEMAPHORE(_delta_batch_sem);
+            have_pkt = batch->flush(pkt);
+        }
+        if (have_pkt) {
+            WriteBlock(&pkt, sizeof(pkt));
+        }
+    }
+}
+
 void AP_Logger::WritePrioritisedBlock(const void *pBuffer, uint16_t size, bool is_critical) {
     FOR_EACH_BACKEND(WritePrioritisedBlock(pBuffer, size, is_critical));
 }
@@ -667,6 +727,7 @@ void AP_Logger::Prep() {
 
 void AP_Logger::StopLogging()
 {
+    flush_delta_batches();
     FOR_EACH_BACKEND(stop_logging());
 }
 
@@ -731,12 +792,20 @@ void AP_Logger::handle_mavlink_msg(GCS_MAVLINK &link, const mavlink_message_t &m
 
 void AP_Logger::periodic_tasks() {
     handle_log_send();
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - _last_delta_flush_ms > 1000) {
+        // a batch stops filling when its messages stop being logged,
+        // e.g. after disarming, so don't leave messages in it for long
+        _last_delta_flush_ms = now_ms;
+        flush_delta_batches();
+    }
     FOR_EACH_BACKEND(periodic_tasks());
 }
 
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX
     // currently only AP_Logger_File support this:
 void AP_Logger::flush(void) {
+     flush_delta_batches();
      FOR_EACH_BACKEND(flush());
 }
 #endif
@@ -788,6 +857,16 @@ uint32_t AP_Logger::num_dropped() const
     return backends[0]->num_dropped();
 }
 
+void AP_Logger::get_write_contention(uint32_t &retries, uint32_t &busy) const
+{
+    if (_next_backend == 0) {
+        retries = 0;
+        busy = 0;
+        return;
+    }
+    backends[0]->get_write_contention(retries, busy);
+}
+
 
 // end functions pass straight through to backend
 
@@ -829,14 +908,148 @@ void AP_Logger::WriteCritical(const char *name, const char *labels, const char *
 }
 
 void AP_Logger::WriteV(const char *name, const char *labels, const char *units, const char *mults, const char *fmt, va_list arg_list, bool is_critical)
+{
+    WriteRegisteredV(RegisterFormat(name, labels, units, mults, fmt), arg_list, is_critical);
+}
+
+/*
+  register a runtime format, returning a handle for WriteRegistered()
+ */
+AP_Logger::FormatHandle AP_Logger::RegisterFormat(const char *name, const char *labels, const char *units, const char *mults, const char *fmt)
 {
     struct log_write_fmt *f = msg_fmt_for_name(name, labels, units, mults, fmt);
     if (f == nullptr) {
         // unable to map name to a messagetype; could be out of
         // msgtypes, could be out of slots, ...
         AP::internalerror().error(AP_InternalError::error_t::logger_mapfailure);
+    }
+    return f;
+}
+
+void AP_Logger::WriteRegistered(FormatHandle f, ...)
+{
+    va_list arg_list;
+
+    va_start(arg_list, f);
+    WriteRegisteredV(f, arg_list);
+    va_end(arg_list);
+}
+
+void AP_Logger::WriteRegisteredCritical(FormatHandle f, ...)
+{
+    va_list arg_list;
+
+    va_start(arg_list, f);
+    WriteRegisteredV(f, arg_list, true);
+    va_end(arg_list);
+}
+
+void AP_Logger::WriteRegisteredV(FormatHandle f, va_list arg_list, bool is_critical)
+{
+    if (f == nullptr) {
         return;
     }
+    write_packed(f, arg_list, is_critical);
+}
+
+/*
+  pack a message using the compiled packer of its format and write it
+  to all backends
+ */
+void AP_Logger::write_packed(struct log_write_fmt *f, va_list arg_list, bool is_critical)
+{
+    // pack the message once for all backends
+    uint8_t buffer[f->msg_len];
+    uint8_t offset = 0;
+    buffer[offset++] = HEAD_BYTE1;
+    buffer[offset++] = HEAD_BYTE2;
+    buffer[offset++] = f->msg_type;
+    for (uint8_t i=0; i<f->num_fields; i++) {
+        uint8_t charlen = 0;
+        switch (f->packer[i]) {
+        case FieldPack::INT8: {
+            int8_t tmp = va_arg(arg_list, int);
+            memcpy(&buffer[offset], &tmp, sizeof(int8_t));
+            offset += sizeof(int8_t);
+            break;
+        }
+        case FieldPack::UINT8: {
+            uint8_t tmp = va_arg(arg_list, int);
+            memcpy(&buffer[offset], &tmp, sizeof(uint8_t));
+            offset += sizeof(uint8_t);
+            break;
+        }
+        case FieldPack::INT16: {
+            int16_t tmp = va_arg(arg_list, int);
+            memcpy(&buffer[offset], &tmp, sizeof(int16_t));
+            offset += sizeof(int16_t);
+            break;
+        }
+        case FieldPack::UINT16: {
+            uint16_t tmp = va_arg(arg_list, int);
+            memcpy(&buffer[offset], &tmp, sizeof(uint16_t));
+            offset += sizeof(uint16_t);
+            break;
+        }
+        case FieldPack::INT32: {
+            int32_t tmp = va_arg(arg_list, int);
+            memcpy(&buffer[offset], &tmp, sizeof(int32_t));
+            offset += sizeof(int32_t);
+            break;
+        }
+        case FieldPack::UINT32: {
+            uint32_t tmp = va_arg(arg_list, uint32_t);
+            memcpy(&buffer[offset], &tmp, sizeof(uint32_t));
+            offset += sizeof(uint32_t);
+            break;
+        }
+        case FieldPack::INT64: {
+            int64_t tmp = va_arg(arg_list, int64_t);
+            memcpy(&buffer[offset], &tmp, sizeof(int64_t));
+            offset += sizeof(int64_t);
+            break;
+        }
+        case FieldPack::UINT64: {
+            uint64_t tmp = va_arg(arg_list, uint64_t);
+            memcpy(&buffer[offset], &tmp, sizeof(uint64_t));
+            offset += sizeof(uint64_t);
+            break;
+        }
+        case FieldPack::FLOAT: {
+            float tmp = va_arg(arg_list, double);
+            memcpy(&buffer[offset], &tmp, sizeof(float));
+            offset += sizeof(float);
+            break;
+        }
+        case FieldPack::DOUBLE: {
+            double tmp = va_arg(arg_list, double);
+            memcpy(&buffer[offset], &tmp, sizeof(double));
+            offset += sizeof(double);
+            break;
+        }
+        case FieldPack::CHAR4:
+            charlen = 4;
+            break;
+        case FieldPack::CHAR16:
+            charlen = 16;
+            break;
+        case FieldPack::CHAR64:
+            charlen = 64;
+            break;
+        case FieldPack::INT16_ARRAY32: {
+            int16_t *tmp = va_arg(arg_list, int16_t*);
+            const uint8_t bytes = 32*2;
+            memcpy(&buffer[offset], tmp, bytes);
+            offset += bytes;
+            break;
+        }
+        }
+        if (charlen != 0) {
+            char *tmp = va_arg(arg_list, char*);
+            memcpy(&buffer[offset], tmp, charlen);
+            offset += charlen;
+        }
+    }
 
     for (uint8_t i=0; i<_next_backend; i++) {
         if (!(f->sent_mask & (1U<<i))) {
@@ -845,10 +1058,7 @@ void AP_Logger::WriteV(const char *name, const char *labels, const char *units,
             }
             f->sent_mask |= (1U<<i);
         }
-        va_list arg_copy;
-        va_copy(arg_copy, arg_list);
-        backends[i]->Write(f->msg_type, arg_copy, is_critical);
-        va_end(arg_copy);
+        backends[i]->WritePrioritisedBlock(buffer, f->msg_len, is_critical);
     }
 }
 
@@ -940,6 +1150,11 @@ AP_Logger::log_write_fmt *AP_Logger::msg_fmt_for_name(const char *name, const ch
 
     f->msg_len = tmp;
 
+    if (!Write_compile_packer(*f)) {
+        free(f);
+        return nullptr;
+    }
+
     // add to front of list
     f->next = log_write_fmts;
     log_write_fmts = f;
@@ -1121,6 +1336,50 @@ int16_t AP_Logger::Write_calc_msg_len(const char *fmt) const
     return len;
 }
 
+/*
+  compile the format string of f into a packer, with one entry per
+  field, so that writes don't need to parse the format string
+ */
+bool AP_Logger::Write_compile_packer(log_write_fmt &f) const
+{
+    const uint8_t num_fields = strlen(f.fmt);
+    FieldPack *packer = new FieldPack[num_fields];
+    if (packer == nullptr) {
+        return false;
+    }
+    for (uint8_t i=0; i<num_fields; i++) {
+        switch (f.fmt[i]) {
+        case 'a' : packer[i] = FieldPack::INT16_ARRAY32; break;
+        case 'b' : packer[i] = FieldPack::INT8; break;
+        case 'c' : packer[i] = FieldPack::INT16; break;
+        case 'd' : packer[i] = FieldPack::DOUBLE; break;
+        case 'e' : packer[i] = FieldPack::INT32; break;
+        case 'f' : packer[i] = FieldPack::FLOAT; break;
+        case 'h' : packer[i] = FieldPack::INT16; break;
+        case 'i' : packer[i] = FieldPack::INT32; break;
+        case 'n' : packer[i] = FieldPack::CHAR4; break;
+        case 'B' : packer[i] = FieldPack::UINT8; break;
+        case 'C' : packer[i] = FieldPack::UINT16; break;
+        case 'E' : packer[i] = FieldPack::UINT32; break;
+        case 'H' : packer[i] = FieldPack::UINT16; break;
+        case 'I' : packer[i] = FieldPack::UINT32; break;
+        case 'L' : packer[i] = FieldPack::INT32; break;
+        case 'M' : packer[i] = FieldPack::UINT8; break;
+        case 'N' : packer[i] = FieldPack::CHAR16; break;
+        case 'Z' : packer[i] = FieldPack::CHAR64; break;
+        case 'q' : packer[i] = FieldPack::INT64; break;
+        case 'Q' : packer[i] = FieldPack::UINT64; break;
+        default:
+            // Write_calc_msg_len has already rejected unknown specifiers
+            delete[] packer;
+            return false;
+        }
+    }
+    f.packer = packer;
+    f.num_fields = num_fields;
+    return true;
+}
+
 /* End of Write support */
 
 #undef FOR_EACH_BACKEND
@@ -21,10 +21,13 @@
 #include <AP_Vehicle/ModeReason.h>
 
 #include <stdint.h>
+#include <atomic>
 
 #include "LoggerMessageWriter.h"
+#include "LogDeltaBatch.h"
 
 class AP_Logger_Backend;
+class ByteBuffer;
 class AP_AHRS;
 class AP_AHRS_View;
 
@@ -182,6 +185,9 @@ class AP_Logger
 {
     friend class AP_Logger_Backend; // for _num_types
 
+    // runtime format, defined with the private members
+    struct log_write_fmt;
+
 public:
     FUNCTOR_TYPEDEF(vehicle_startup_message_Writer, void);
 
@@ -209,6 +215,14 @@ public:
     void WriteBlock(const void *pBuffer, uint16_t size);
     /* Write an *important* block of data at current offset */
     void WriteCriticalBlock(const void *pBuffer, uint16_t size);
+    /* Write a message through a delta batch, the batch is written
+     * when it is full */
+    void WriteDeltaBatched(LogDeltaBatch &batch, const void *pBuffer, uint16_t size);
+    // allocate a delta batch for messages of format fmt. The logger
+    // flushes it when logging stops or a new log is started
+    LogDeltaBatch *new_delta_batch(const char *fmt);
+    // write out the messages held in all delta batches
+    void flush_delta_batches();
 
     // high level interface
     uint16_t find_last_log() const;
@@ -295,6 +309,19 @@ public:
     void WriteCritical(const char *name, const char *labels, const char *units, const char *mults, const char *fmt, ...);
     void WriteV(const char *name, const char *labels, const char *units, const char *mults, const char *fmt, va_list arg_list, bool is_critical=false);
 
+    /*
+      register a runtime format once, returning a handle that can be
+      passed to WriteRegistered() many times. Writes through a handle
+      skip the name lookup done by Write(). Returns nullptr if no
+      message type could be allocated. The strings must remain valid
+      for the lifetime of the logger
+     */
+    typedef struct log_write_fmt *FormatHandle;
+    FormatHandle RegisterFormat(const char *name, const char *labels, const char *units, const char *mults, const char *fmt);
+    void WriteRegistered(FormatHandle f, ...);
+    void WriteRegisteredCritical(FormatHandle f, ...);
+    void WriteRegisteredV(FormatHandle f, va_list arg_list, bool is_critical=false);
+
     // This structure provides information on the internal member data of a PID for logging purposes
     struct PID_Info {
         float target;
@@ -325,6 +352,9 @@ public:
     // number of blocks that have been dropped
     uint32_t num_dropped(void) const;
 
+    // contention between threads writing log messages, see LogWriteBuffer
+    void get_write_contention(uint32_t &retries, uint32_t &busy) const;
+
     // accesss to public parameters
     void set_force_log_disarmed(bool force_logging) { _force_log_disarmed = force_logging; }
     bool log_while_disarmed(void) const;
@@ -342,6 +372,7 @@ public:
         AP_Int8 log_replay;
         AP_Int8 mav_bufsize; // in kilobytes
         AP_Int16 file_timeout; // in seconds
+        AP_Int8 file_compress;
     } _params;
 
     const struct LogStructure *structure(uint16_t num) const;
@@ -406,6 +437,25 @@ private:
      * labels and values in a single function call.
      */
 
+    // how a field of a runtime format is read from the argument list
+    // and packed into a message, compiled from the format string
+    enum class FieldPack : uint8_t {
+        INT8,
+        UINT8,
+        INT16,
+        UINT16,
+        INT32,
+        UINT32,
+        INT64,
+        UINT64,
+        FLOAT,
+        DOUBLE,
+        CHAR4,
+        CHAR16,
+        CHAR64,
+        INT16_ARRAY32,
+    };
+
     // this structure looks much like struct LogStructure in
     // LogStructure.h, however we need to remember a pointer value for
     // efficiency of finding message types
@@ -414,18 +464,33 @@ private:
         uint8_t msg_type;
         uint8_t msg_len;
         uint8_t sent_mask; // bitmask of backends sent to
+        uint8_t num_fields;
+        const FieldPack *packer; // one entry per field of fmt
         const char *name;
         const char *fmt;
         const char *labels;
         const char *units;
         const char *mults;
-    } *log_write_fmts;
+    };
+
+    struct log_write_fmt *log_write_fmts;
     HAL_Semaphore log_write_fmts_sem;
 
+    // delta batches allocated by new_delta_batch(). The semaphore
+    // protects the list and the contents of the batches, which are
+    // added to from sensor threads
+    LogDeltaBatch *_delta_batches;
+    HAL_Semaphore _delta_batch_sem;
+    uint32_t _last_delta_flush_ms;
+
     // return (possibly allocating) a log_write_fmt for a name
     struct log_write_fmt *msg_fmt_for_name(const char *name, const char *labels, const char *units, const char *mults, const char *fmt);
     const struct log_write_fmt *log_write_fmt_for_msg_type(uint8_t msg_type) const;
 
+    // pack a message using the compiled packer of its format and
+    // write it to all backends
+    void write_packed(struct log_write_fmt *f, va_list arg_list, bool is_critical);
+
     const struct LogStructure *structure_for_msg_type(uint8_t msg_type);
 
     // return a msg_type which is not currently in use (or -1 if none available)
@@ -438,6 +503,9 @@ private:
     // fmt; includes the message header
     int16_t Write_calc_msg_len(const char *fmt) const;
 
+    // compile fmt into the packer for f, returning false on failure
+    bool Write_compile_packer(log_write_fmt &f) const;
+
     bool _armed;
 
     void Write_Baro_instance(uint64_t time_us, uint8_t baro_instance, enum LogMessages type);
@@ -511,9 +579,46 @@ private:
     // start page of log data
     uint32_t _log_data_page;
 
+    // offset the current data request started at
+    uint32_t _log_data_request_ofs;
+
     GCS_MAVLINK *_log_sending_link;
     HAL_Semaphore _log_send_sem;
 
+    /*
+      bulk downloads: large requests are read ahead into a buffer by
+      the IO thread and sent as fast as the link has space for them
+     */
+    ByteBuffer *_log_read_buf;
+    HAL_Semaphore _log_read_sem;
+    bool _log_read_registered;
+
+    // true while a bulk download is in progress
+    std::atomic<bool> _log_read_active {false};
+
+    // true once the IO thread has read all of the request
+    std::atomic<bool> _log_read_eof {false};
+
+    // next offset to read and bytes left to read, used by the IO thread
+    uint32_t _log_read_ofs;
+    uint32_t _log_read_remaining;
+
+    // a gap the GCS has asked for during a bulk download, sent from
+    // the main thread ahead of the read ahead data
+    uint32_t _log_gap_ofs;
+    uint32_t _log_gap_remaining;
+
+    // throughput of the current bulk download, reported at its end
+    struct {
+        uint32_t start_ms;
+        uint32_t bytes;
+        // calls to send data, and how many of those stopped because
+        // there was nothing read ahead or no space on the link
+        uint32_t sends;
+        uint32_t io_waits;
+        uint32_t link_waits;
+    } _log_bulk_stats;
+
     // last time arming failed, for backends
     uint32_t _last_arming_failure_ms;
 
@@ -527,6 +632,13 @@ private:
     void handle_log_send_listing(); // handle LISTING state
     void handle_log_sending(); // handle SENDING state
     bool handle_log_send_data(); // send data chunk to client
+    void handle_log_send_bulk(); // send read ahead data to client
+    void handle_log_send_gap(); // send requested gap during a bulk download
+    void end_log_send_bulk(); // report a completed bulk download
+
+    bool start_log_read_ahead();
+    void stop_log_read_ahead();
+    void log_read_ahead(); // IO thread read ahead for bulk downloads
 
     void get_log_info(uint16_t log_num, uint32_t &size, uint32_t &time_utc);
 
@@ -2,6 +2,8 @@
 
 #include "AP_Logger.h"
 
+#include <atomic>
+
 class LoggerMessageWriter_DFLogStart;
 
 class AP_Logger_Backend
@@ -103,6 +105,14 @@ public:
         return _dropped;
     }
 
+    // contention between threads writing to the backend: failed
+    // attempts to reserve buffer space and writes dropped because too
+    // many were in progress
+    virtual void get_write_contention(uint32_t &retries, uint32_t &busy) const {
+        retries = 0;
+        busy = 0;
+    }
+
     /*
      * Write support
      */
@@ -110,10 +120,6 @@ public:
     // Returns true if the FMT message has ever been written.
     bool Write_Emit_FMT(uint8_t msg_type);
 
-    // write a log message out to the log of msg_type type, with
-    // values contained in arg_list:
-    bool Write(uint8_t msg_type, va_list arg_list, bool is_critical=false);
-
     // these methods are used when reporting system status over mavlink
     virtual bool logging_enabled() const = 0;
     virtual bool logging_failed() const = 0;
@@ -147,7 +153,8 @@ protected:
     LoggerMessageWriter_DFLogStart *_startup_messagewriter;
     bool _writing_startup_messages;
 
-    uint32_t _dropped;
+    // incremented by any thread whose write fails
+    std::atomic<uint32_t> _dropped;
 
     // must be called when a new log is being started:
     virtual void start_new_log_reset_variables();
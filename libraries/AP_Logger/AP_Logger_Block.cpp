@@ -14,6 +14,18 @@ const extern AP_HAL::HAL& hal;
 // this if (and only if!) the low level format changes
 #define DF_LOGGING_FORMAT    0x1901201A
 
+// bytes of flash kept erased ahead of the write pointer, so writing
+// does not wait for erases. The oldest log loses up to this much data
+// earlier than it would otherwise
+#ifndef HAL_LOGGER_ERASE_AHEAD
+#define HAL_LOGGER_ERASE_AHEAD 65536
+#endif
+
+// pages checked for being erased on each call of the IO timer
+#ifndef HAL_LOGGER_ERASE_CHECK_PAGES
+#define HAL_LOGGER_ERASE_CHECK_PAGES 8
+#endif
+
 AP_Logger_Block::AP_Logger_Block(AP_Logger &front, LoggerMessageWriter_DFLogStart *writer) :
     writebuf(0),
     AP_Logger_Backend(front, writer)
@@ -72,6 +84,14 @@ void AP_Logger_Block::StartWrite(uint32_t PageAdr)
 {
     df_PageAdr    = PageAdr;
     log_write_started = true;
+
+    // the rest of a block we start part way through is already erased
+    erase_next_block = get_block(PageAdr);
+    if ((PageAdr-1) % df_PagePerBlock != 0) {
+        erase_next_block++;
+    }
+    erase_next_block %= num_blocks();
+    erase_check_page = 0;
 }
 
 void AP_Logger_Block::FinishWrite(void)
@@ -84,11 +104,103 @@ void AP_Logger_Block::FinishWrite(void)
     if (df_PageAdr > df_NumPages) {
         df_PageAdr = 1;
     }
+}
+
+/*
+  check if every byte of a page is erased. Reading is much quicker
+  than erasing, so this is worth doing to save wear
+ */
+bool AP_Logger_Block::page_erased(uint32_t page)
+{
+    PageToBuffer(page);
+    // the read buffer no longer holds the page being read
+    df_Read_PageAdr = 0;
+    for (uint16_t i=0; i<df_PageSize; i++) {
+        if (buffer[i] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+  erase the block about to be written to, unless it was erased in the
+  background. There is no time to check it is already erased here
+ */
+void AP_Logger_Block::prepare_write_block(void)
+{
+    const uint32_t block = get_block(df_PageAdr);
+    if (block != erase_next_block) {
+        return;
+    }
+    SectorErase(block);
+    erase_next_block = (block + 1) % num_blocks();
+    erase_check_page = 0;
+}
+
+/*
+  erase blocks ahead of the write pointer while there is nothing to
+  write, one at a time. Each block is checked a few pages per call, so
+  the IO thread isn't held up reading a whole block, and is skipped if
+  it is already erased, which saves wear on a chip which hasn't
+  wrapped yet
+ */
+void AP_Logger_Block::erase_ahead(void)
+{
+    if (erase_ahead_pending) {
+        if (Busy()) {
+            return;
+        }
+        erase_ahead_pending = false;
+    }
+    const uint32_t block = get_block(df_PageAdr);
+    const uint32_t max_blocks = MAX(HAL_LOGGER_ERASE_AHEAD / (df_PagePerBlock * df_PageSize), 1U);
+    // the last block and the wrap to the first block are left to be
+    // erased when they are reached, otherwise the chip would look
+    // unwrapped to find_last_page() and check_wrapped()
+    if (erase_next_block <= block ||
+        erase_next_block >= num_blocks() - 1 ||
+        erase_next_block - block > max_blocks) {
+        return;
+    }
+    const uint32_t first_page = erase_next_block * df_PagePerBlock + 1;
+    const uint32_t last_page = first_page + df_PagePerBlock - 1;
+    if (erase_check_page < first_page || erase_check_page > last_page) {
+        erase_check_page = first_page;
+    }
+    for (uint8_t i=0; i<HAL_LOGGER_ERASE_CHECK_PAGES && erase_check_page <= last_page; i++) {
+        if (!page_erased(erase_check_page)) {
+            SectorErase(erase_next_block);
+            erase_ahead_pending = true;
+            erase_check_page = last_page + 1;
+            break;
+        }
+        erase_check_page++;
+    }
+    if (erase_check_page > last_page) {
+        erase_next_block++;
+        erase_check_page = 0;
+    }
+}
 
-    // when starting a new sector, erase it
-    if ((df_PageAdr-1) % df_PagePerBlock == 0) {
-        SectorErase(df_PageAdr / df_PagePerBlock);
+/*
+  find the first page of the oldest data on a wrapped chip, given the
+  last page written. The rest of the block being written and the
+  blocks erased ahead of it read as erased, so this is the first block
+  after the write pointer which holds data
+ */
+uint32_t AP_Logger_Block::find_oldest_page(uint32_t last_page)
+{
+    uint32_t block = get_block(last_page);
+    for (uint32_t i=1; i<num_blocks(); i++) {
+        block = (block + 1) % num_blocks();
+        const uint32_t page = block * df_PagePerBlock + 1;
+        StartRead(page);
+        if (GetFileNumber() != 0xFFFF) {
+            return page;
+        }
     }
+    return 1;
 }
 
 bool AP_Logger_Block::WritesOK() const
@@ -112,13 +224,8 @@ bool AP_Logger_Block::_WritePrioritisedBlock(const void *pBuffer, uint16_t size,
         return false;
     }
 
-    if (writebuf.space() < size) {
-        // no room in buffer
-        return false;
-    }
-
-    writebuf.write((uint8_t*)pBuffer, size);
-    return true;
+    // fails if there is no room in the buffer
+    return writebuf.write((const uint8_t*)pBuffer, size);
 }
 
 
@@ -237,12 +344,13 @@ void AP_Logger_Block::Prep()
  */
 bool AP_Logger_Block::NeedErase(void)
 {
-    uint32_t version = 0;
+    struct FormatPage fmt {};
     StartRead(df_NumPages+1); // last page
 
-    BlockRead(0, &version, sizeof(version));
+    BlockRead(0, &fmt, sizeof(fmt));
     StartRead(1);
-    if (version == DF_LOGGING_FORMAT) {
+    if (fmt.version == DF_LOGGING_FORMAT) {
+        df_EraseCount = fmt.erase_count;
         return false;
     }
     return true;
@@ -273,9 +381,11 @@ void AP_Logger_Block::validate_log_structure()
         StartRead(page);
         file = GetFileNumber();
         next_file++;
-        // skip over the rest of an erased blcok
+        // skip over the rest of the block being written and the
+        // blocks erased ahead of it
         if (wrapped && file == 0xFFFF) {
-            StartRead((get_block(page) + 1) * df_PagePerBlock + 1);
+            page = find_oldest_page(page - 1);
+            StartRead(page);
             file = GetFileNumber();
         }
         if (wrapped && file < next_file) {
@@ -399,9 +509,9 @@ uint16_t AP_Logger_Block::get_num_logs(void)
     last = GetFileNumber();
     if (check_wrapped()) {
         // if we wrapped then the rest of the block will be filled with 0xFFFF because we always erase
-        // a block before writing to it, in order to find the first page we therefore have to read after the
-        // next block boundary
-        StartRead((get_block(lastpage) + 1) * df_PagePerBlock + 1);
+        // a block before writing to it, as will the blocks erased ahead of it. To find the first page we
+        // therefore have to read from the first block after them which holds data
+        StartRead(find_oldest_page(lastpage));
         first = GetFileNumber();
     }
 
@@ -429,8 +539,10 @@ void AP_Logger_Block::start_new_log(void)
 
     uint16_t new_log_num;
 
-    // Check for log of length 1 page and suppress
-    if (df_FilePage <= 1) {
+    // Check for log of length 1 page and suppress. Its page can only
+    // be written again once erased, which is only possible without
+    // losing other data when it is the first page of a block
+    if (df_FilePage <= 1 && (last_page-1) % df_PagePerBlock == 0) {
         new_log_num = GetFileNumber();
         // Last log too short, reuse its number
         // and overwrite it
@@ -462,7 +574,7 @@ void AP_Logger_Block::get_log_boundaries(uint16_t log_num, uint32_t & start_page
             end_page = find_last_page_of_log((uint16_t)log_num);
         } else {
             end_page = find_last_page_of_log((uint16_t)log_num);
-            start_page = end_page + 1;
+            start_page = find_oldest_page(end_page);
         }
     } else {
         if (log_num==1) {
@@ -470,11 +582,11 @@ void AP_Logger_Block::get_log_boundaries(uint16_t log_num, uint32_t & start_page
             if (GetFileNumber() == 0xFFFF) {
                 start_page = 1;
             } else {
-                start_page = find_last_page() + 1;
+                start_page = find_oldest_page(find_last_page());
             }
         } else {
             if (log_num == find_last_log() - num + 1) {
-                start_page = find_last_page() + 1;
+                start_page = find_oldest_page(find_last_page());
             } else {
                 look = log_num-1;
                 do {
@@ -664,12 +776,15 @@ void AP_Logger_Block::io_timer(void)
         }
         // write the logging format in the last page
         StartWrite(df_NumPages+1);
-        uint32_t version = DF_LOGGING_FORMAT;
+        struct FormatPage fmt {};
+        fmt.version = DF_LOGGING_FORMAT;
+        fmt.erase_count = ++df_EraseCount;
         memset(buffer, 0, df_PageSize);
-        memcpy(buffer, &version, sizeof(version));
+        memcpy(buffer, &fmt, sizeof(fmt));
         FinishWrite();
         erase_started = false;
-        gcs().send_text(MAV_SEVERITY_INFO, "Chip erase complete");
+        erase_ahead_pending = false;
+        gcs().send_text(MAV_SEVERITY_INFO, "Chip erase complete (%u erases)", unsigned(df_EraseCount));
         return;
     }
 
@@ -697,6 +812,14 @@ void AP_Logger_Block::io_timer(void)
     }
 
     while (writebuf.available() >= df_PageSize - sizeof(struct PageHeader)) {
+        // data stays buffered while a background erase completes
+        if (erase_ahead_pending) {
+            if (Busy()) {
+                return;
+            }
+            erase_ahead_pending = false;
+        }
+        prepare_write_block();
         struct PageHeader ph;
         ph.FileNumber = df_FileNumber;
         ph.FilePage = df_FilePage;
@@ -705,4 +828,6 @@ void AP_Logger_Block::io_timer(void)
         FinishWrite();
         df_FilePage++;
     }
+
+    erase_ahead();
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "AP_Logger_Backend.h"
+#include "LogWriteBuffer.h"
 
 class AP_Logger_Block : public AP_Logger_Backend {
 public:
@@ -31,6 +32,10 @@ public:
     bool logging_enabled() const override { return true; }
     bool logging_failed() const override { return false; }
     bool logging_started(void) const override { return log_write_started; }
+    void get_write_contention(uint32_t &retries, uint32_t &busy) const override {
+        retries = writebuf.get_retries();
+        busy = writebuf.get_busy();
+    }
 
 protected:
     /* Write a block of data at current offset */
@@ -46,14 +51,23 @@ private:
     virtual void Sector4kErase(uint32_t SectorAdr) = 0;
     virtual void StartErase() = 0;
     virtual bool InErase() = 0;
+    // true while the chip is busy with an erase or write
+    virtual bool Busy() = 0;
 
     struct PACKED PageHeader {
         uint32_t FilePage;
         uint16_t FileNumber;
     };
 
+    // contents of the page at the start of the reserved last block
+    struct PACKED FormatPage {
+        uint32_t version;
+        // number of chip erases, as a measure of flash wear
+        uint32_t erase_count;
+    };
+
     HAL_Semaphore sem;
-    ByteBuffer writebuf;
+    LogWriteBuffer writebuf;
 
     // state variables
     uint16_t df_Read_BufferIdx;
@@ -71,6 +85,18 @@ private:
     // are we waiting on an erase to finish?
     bool erase_started;
 
+    // chip erases from the format page
+    uint32_t df_EraseCount;
+
+    // blocks from the one being written up to this one are erased and
+    // ready for writing
+    uint32_t erase_next_block;
+    // next page of erase_next_block to check for being erased, 0 when
+    // the check has not started
+    uint32_t erase_check_page;
+    // is a block erase ahead of the write pointer in progress?
+    bool erase_ahead_pending;
+
     // read size bytes of data to a page. The caller must ensure that
     // the data fits within the page, otherwise it will wrap to the
     // start of the page
@@ -79,6 +105,11 @@ private:
     // erase handling
     bool NeedErase(void);
     void validate_log_structure();
+    uint32_t num_blocks(void) const { return df_NumPages / df_PagePerBlock; }
+    bool page_erased(uint32_t page);
+    void prepare_write_block(void);
+    void erase_ahead(void);
+    uint32_t find_oldest_page(uint32_t last_page);
 
     // internal high level functions
     int16_t get_log_data_raw(uint16_t log_num, uint32_t page, uint32_t offset, uint16_t len, uint8_t *data) WARN_IF_UNUSED;
@@ -26,7 +26,7 @@ private:
     bool              InErase() override;
     void              send_command_addr(uint8_t cmd, uint32_t address);
     void              WaitReady();
-    bool              Busy();
+    bool              Busy() override;
     uint8_t           ReadStatusReg();
     void              Enter4ByteAddressMode(void);
 
@@ -46,6 +46,7 @@ AP_Logger_File::AP_Logger_File(AP_Logger &front,
     _log_directory(log_directory),
     _writebuf(0),
     _writebuf_chunk(HAL_LOGGER_WRITE_CHUNK_SIZE),
+    _compress_buf(nullptr),
     _perf_write(hal.util->perf_alloc(AP_HAL::Util::PC_ELAPSED, "DF_write")),
     _perf_fsync(hal.util->perf_alloc(AP_HAL::Util::PC_ELAPSED, "DF_fsync")),
     _perf_errors(hal.util->perf_alloc(AP_HAL::Util::PC_COUNT, "DF_errors")),
@@ -100,6 +101,15 @@ void AP_Logger_File::Init()
 
     hal.console->printf("AP_Logger_File: buffer size=%u\n", (unsigned)bufsize);
 
+    if (_front._params.file_compress) {
+        _compress_buf = new uint8_t[LOG_COMPRESS_BLOCK_BOUND];
+        if (_compress_buf == nullptr || !_compressor.init()) {
+            hal.console->printf("Out of memory for log compression\n");
+            delete[] _compress_buf;
+            _compress_buf = nullptr;
+        }
+    }
+
     _initialised = true;
     hal.scheduler->register_io_process(FUNCTOR_BIND_MEMBER(&AP_Logger_File::_io_timer, void));
 }
@@ -153,7 +163,6 @@ void AP_Logger_File::periodic_1Hz()
         _write_fd = -1;
         _initialised = false;
     }
-    df_stats_log();
 }
 
 void AP_Logger_File::periodic_fullrate()
@@ -484,11 +493,10 @@ bool AP_Logger_File::_WritePrioritisedBlock(const void *pBuffer, uint16_t size,
         return false;
     }
 
-    if (!semaphore.take(1)) {
-        return false;
-    }
-        
-    uint32_t space = _writebuf.space();
+    // no lock is taken; the checks against space are only advisory
+    // as other threads may be writing, the buffer write itself fails
+    // if there is no room
+    const uint32_t space = _writebuf.space();
 
     if (_writing_startup_messages &&
         _startup_messagewriter->fmt_done()) {
@@ -501,7 +509,6 @@ bool AP_Logger_File::_WritePrioritisedBlock(const void *pBuffer, uint16_t size,
         if (!must_dribble &&
             space < non_messagewriter_message_reserved_space()) {
             // this message isn't dropped, it will be sent again...
-            semaphore.give();
             return false;
         }
         last_messagewrite_message_sent = now;
@@ -509,22 +516,18 @@ bool AP_Logger_File::_WritePrioritisedBlock(const void *pBuffer, uint16_t size,
         // we reserve some amount of space for critical messages:
         if (!is_critical && space < critical_message_reserved_space()) {
             _dropped++;
-            semaphore.give();
             return false;
         }
     }
 
     // if no room for entire message - drop it:
-    if (space < size) {
+    if (space < size ||
+        !_writebuf.write((const uint8_t*)pBuffer, size)) {
         hal.util->perf_count(_perf_overruns);
         _dropped++;
-        semaphore.give();
         return false;
     }
 
-    _writebuf.write((uint8_t*)pBuffer, size);
-    df_stats_gather(size);
-    semaphore.give();
     return true;
 }
 
@@ -563,7 +566,7 @@ uint32_t AP_Logger_File::_get_log_size(const uint16_t log_num)
             // it is the file we are currently writing
             free(fname);
             write_fd_semaphore.give();
-            return _write_offset;
+            return _write_data_size;
         }
         write_fd_semaphore.give();
     }
@@ -574,8 +577,18 @@ uint32_t AP_Logger_File::_get_log_size(const uint16_t log_num)
         free(fname);
         return 0;
     }
+    uint32_t size = st.st_size;
+
+    // compressed logs report the amount of log data they hold, which
+    // is what a download will return
+    FileDecompressor reader;
+    reader.fd = AP::FS().open(fname, O_RDONLY);
     free(fname);
-    return st.st_size;
+    if (reader.fd != -1) {
+        reader.get_data_size(st.st_size, size);
+        AP::FS().close(reader.fd);
+    }
+    return size;
 }
 
 uint32_t AP_Logger_File::_get_log_time(const uint16_t log_num)
@@ -664,6 +677,7 @@ int16_t AP_Logger_File::get_log_data(const uint16_t list_entry, const uint16_t p
     if (_read_fd != -1 && log_num != _read_fd_log_num) {
         AP::FS().close(_read_fd);
         _read_fd = -1;
+        _reader.reset();
     }
     if (_read_fd == -1) {
         char *fname = _log_file_name(log_num);
@@ -684,24 +698,29 @@ int16_t AP_Logger_File::get_log_data(const uint16_t list_entry, const uint16_t p
             return -1;            
         }
         free(fname);
-        _read_offset = 0;
+        _reader.reset();
+        _reader.fd = _read_fd;
         _read_fd_log_num = log_num;
     }
     uint32_t ofs = page * (uint32_t)LOGGER_PAGE_SIZE + offset;
 
-    if (ofs != _read_offset) {
-        if (AP::FS().lseek(_read_fd, ofs, SEEK_SET) == (off_t)-1) {
-            AP::FS().close(_read_fd);
-            _read_fd = -1;
-            return -1;
-        }
-        _read_offset = ofs;
-    }
-    int16_t ret = (int16_t)AP::FS().read(_read_fd, data, len);
-    if (ret > 0) {
-        _read_offset += ret;
+    if (!_reader.seek(ofs)) {
+        AP::FS().close(_read_fd);
+        _read_fd = -1;
+        _reader.reset();
+        return -1;
     }
-    return ret;
+    return (int16_t)_reader.read(data, len);
+}
+
+ssize_t AP_Logger_File::FileDecompressor::read_raw(void *buf, uint32_t count)
+{
+    return AP::FS().read(fd, buf, count);
+}
+
+bool AP_Logger_File::FileDecompressor::seek_raw(uint32_t ofs)
+{
+    return AP::FS().lseek(fd, ofs, SEEK_SET) != (off_t)-1;
 }
 
 /*
@@ -748,6 +767,16 @@ uint16_t AP_Logger_File::get_num_logs()
     return ret;
 }
 
+bool AP_Logger_File::write_compress_header(int fd)
+{
+    const struct log_compress_header hdr { LOG_COMPRESS_MAGIC, _write_data_size, _write_offset };
+    if (AP::FS().lseek(fd, 0, SEEK_SET) == (off_t)-1 ||
+        AP::FS().write(fd, &hdr, sizeof(hdr)) != ssize_t(sizeof(hdr))) {
+        return false;
+    }
+    return AP::FS().lseek(fd, _write_offset, SEEK_SET) == off_t(_write_offset);
+}
+
 /*
   stop logging
  */
@@ -758,6 +787,21 @@ void AP_Logger_File::stop_logging(void)
     if (_write_fd != -1) {
         int fd = _write_fd;
         _write_fd = -1;
+        if (have_sem && _compress_log) {
+            if (_compress_len != 0) {
+                // the data of a part written block has already left
+                // the write buffer, finish writing it
+                const uint16_t n = _compress_len - _compress_ofs;
+                if (AP::FS().write(fd, &_compress_buf[_compress_ofs], n) == ssize_t(n)) {
+                    _write_offset += n;
+                    _write_data_size += _compress_data_len;
+                }
+                _compress_len = 0;
+            }
+            // record the amount of log data so readers don't need to
+            // walk the blocks to find it
+            write_compress_header(fd);
+        }
         AP::FS().close(fd);
     }
     if (have_sem) {
@@ -791,6 +835,7 @@ void AP_Logger_File::start_new_log(void)
     if (_read_fd != -1) {
         AP::FS().close(_read_fd);
         _read_fd = -1;
+        _reader.reset();
     }
 
     if (disk_space_avail() < _free_space_min_avail && disk_space() > 0) {
@@ -845,7 +890,27 @@ void AP_Logger_File::start_new_log(void)
     }
     _last_write_ms = AP_HAL::millis();
     _write_offset = 0;
+    _write_data_size = 0;
     _writebuf.clear();
+
+    _compress_log = (_compress_buf != nullptr);
+    _compress_len = 0;
+    _compress_ofs = 0;
+    _compress_header_ms = AP_HAL::millis();
+    if (_compress_log) {
+        // the data size is filled in while logging and when the log
+        // is closed
+        const struct log_compress_header hdr { LOG_COMPRESS_MAGIC, 0, 0 };
+        if (AP::FS().write(_write_fd, &hdr, sizeof(hdr)) != ssize_t(sizeof(hdr))) {
+            AP::FS().close(_write_fd);
+            _write_fd = -1;
+            _initialised = false;
+            _open_error = true;
+            write_fd_semaphore.give();
+            return;
+        }
+        _write_offset = sizeof(hdr);
+    }
     write_fd_semaphore.give();
 
     // now update lastlog.txt with the new log number
@@ -881,7 +946,8 @@ void AP_Logger_File::flush(void)
 #if APM_BUILD_TYPE(APM_BUILD_Replay) || APM_BUILD_TYPE(APM_BUILD_UNKNOWN)
 {
     uint32_t tnow = AP_HAL::millis();
-    while (_write_fd != -1 && _initialised && !_open_error && _writebuf.available()) {
+    while (_write_fd != -1 && _initialised && !_open_error &&
+           (_writebuf.available() || _compress_len != 0)) {
         // convince the IO timer that it really is OK to write out
         // less than _writebuf_chunk bytes:
         if (tnow > 2001) { // avoid resetting _last_write_time to 0
@@ -913,11 +979,16 @@ void AP_Logger_File::_io_timer(void)
         return;
     }
 
+    if (tnow - _df_stats_last_log_ms >= 1000) {
+        _df_stats_last_log_ms = tnow;
+        df_stats_log();
+    }
+
     uint32_t nbytes = _writebuf.available();
-    if (nbytes == 0) {
+    if (nbytes == 0 && _compress_len == 0) {
         return;
     }
-    if (nbytes < _writebuf_chunk && 
+    if (nbytes < _writebuf_chunk && _compress_len == 0 &&
         tnow - _last_write_time < 2000UL) {
         // write in _writebuf_chunk-sized chunks, but always write at
         // least once per 2 seconds if data is available
@@ -944,18 +1015,6 @@ void AP_Logger_File::_io_timer(void)
         nbytes = _writebuf_chunk;
     }
 
-    uint32_t size;
-    const uint8_t *head = _writebuf.readptr(size);
-    nbytes = MIN(nbytes, size);
-
-    // try to align writes on a 512 byte boundary to avoid filesystem reads
-    if ((nbytes + _write_offset) % 512 != 0) {
-        uint32_t ofs = (nbytes + _write_offset) % 512;
-        if (ofs < nbytes) {
-            nbytes -= ofs;
-        }
-    }
-
     last_io_operation = "write";
     if (!write_fd_semaphore.take(1)) {
         return;
@@ -964,6 +1023,40 @@ void AP_Logger_File::_io_timer(void)
         write_fd_semaphore.give();
         return;
     }
+
+    uint32_t size;
+    const uint8_t *head;
+    if (_compress_log) {
+        if (_compress_len == 0) {
+            // compress the next chunk into a block. The chunk is removed
+            // from the ring buffer now, freeing the space while the
+            // block is written out
+            head = _writebuf.readptr(size);
+            nbytes = MIN(MIN(nbytes, size), uint32_t(LOG_COMPRESS_BLOCK_MAX));
+            last_io_operation = "compress";
+            _compress_len = _compressor.compress_block(head, nbytes, _compress_buf);
+            _compress_ofs = 0;
+            _compress_data_len = nbytes;
+            _writebuf.advance(nbytes);
+            last_io_operation = "write";
+        }
+        // compressed blocks are variable length so there is no point
+        // aligning them
+        head = &_compress_buf[_compress_ofs];
+        nbytes = _compress_len - _compress_ofs;
+    } else {
+        head = _writebuf.readptr(size);
+        nbytes = MIN(nbytes, size);
+
+        // try to align writes on a 512 byte boundary to avoid filesystem reads
+        if ((nbytes + _write_offset) % 512 != 0) {
+            uint32_t ofs = (nbytes + _write_offset) % 512;
+            if (ofs < nbytes) {
+                nbytes -= ofs;
+            }
+        }
+    }
+
     ssize_t nwritten = AP::FS().write(_write_fd, head, nbytes);
     last_io_operation = "";
     if (nwritten <= 0) {
@@ -984,7 +1077,32 @@ void AP_Logger_File::_io_timer(void)
         _last_write_failed = false;
         _last_write_ms = tnow;
         _write_offset += nwritten;
-        _writebuf.advance(nwritten);
+        df_stats_gather(nwritten);
+        if (_compress_log) {
+            _compress_ofs += nwritten;
+            if (_compress_ofs >= _compress_len) {
+                _compress_len = 0;
+                _write_data_size += _compress_data_len;
+                if (tnow - _compress_header_ms > _compress_header_interval_ms) {
+                    // keep the header close to the end of the log, so
+                    // sizing a log that isn't closed cleanly only
+                    // walks the last few blocks
+                    _compress_header_ms = tnow;
+                    last_io_operation = "header";
+                    if (!write_compress_header(_write_fd)) {
+                        // we no longer know where the file is positioned
+                        hal.util->perf_count(_perf_errors);
+                        AP::FS().close(_write_fd);
+                        _write_fd = -1;
+                        _initialised = false;
+                    }
+                    last_io_operation = "";
+                }
+            }
+        } else {
+            _writebuf.advance(nwritten);
+            _write_data_size += nwritten;
+        }
         /*
           the best strategy for minimizing corruption on microSD cards
           seems to be to write in 4k chunks and fsync the file on each
@@ -1078,6 +1196,7 @@ void AP_Logger_File::Write_AP_Logger_Stats_File(const struct df_stats &_stats)
     WriteBlock(&pkt, sizeof(pkt));
 }
 
+// the statistics are only gathered and logged by the IO thread
 void AP_Logger_File::df_stats_gather(const uint16_t bytes_written) {
     const uint32_t space_remaining = _writebuf.space();
     if (space_remaining < stats.buf_space_min) {
@@ -10,8 +10,9 @@
 
 #if HAVE_FILESYSTEM_SUPPORT
 
-#include <AP_HAL/utility/RingBuffer.h>
 #include "AP_Logger_Backend.h"
+#include "LogCompress.h"
+#include "LogWriteBuffer.h"
 
 class AP_Logger_File : public AP_Logger_Backend
 {
@@ -55,6 +56,10 @@ public:
     bool logging_failed() const override;
 
     bool logging_started(void) const override { return _write_fd != -1; }
+    void get_write_contention(uint32_t &retries, uint32_t &busy) const override {
+        retries = _writebuf.get_retries();
+        busy = _writebuf.get_busy();
+    }
 
     void vehicle_was_disarmed() override;
 
@@ -75,8 +80,10 @@ private:
     
     int _read_fd;
     uint16_t _read_fd_log_num;
-    uint32_t _read_offset;
     uint32_t _write_offset;
+    // amount of log data written to the current file, which differs
+    // from _write_offset when the log is compressed
+    uint32_t _write_data_size;
     volatile bool _open_error;
     const char *_log_directory;
     bool _last_write_failed;
@@ -108,11 +115,39 @@ private:
 #else
     const float min_avail_space_percent = 10.0f;
 #endif
-    // write buffer
-    ByteBuffer _writebuf;
+    // write buffer, written without locking from any thread
+    LogWriteBuffer _writebuf;
     const uint16_t _writebuf_chunk;
     uint32_t _last_write_time;
 
+    // block compression of the log being written
+    LogCompressor _compressor;
+    uint8_t *_compress_buf;
+    bool _compress_log;
+    // length of the block in _compress_buf still to be written, and
+    // how much of it has been written
+    uint16_t _compress_len;
+    uint16_t _compress_ofs;
+    // log data held in the pending block
+    uint16_t _compress_data_len;
+    // when the header was last updated with the amount of data written
+    uint32_t _compress_header_ms;
+    const uint32_t _compress_header_interval_ms = 5000;
+
+    // record the data written so far in the header of a compressed
+    // log, leaving the file positioned at its end
+    bool write_compress_header(int fd);
+
+    // reads log data from _read_fd, decompressing compressed logs
+    class FileDecompressor : public LogDecompressor {
+    public:
+        int fd = -1;
+    protected:
+        ssize_t read_raw(void *buf, uint32_t count) override;
+        bool seek_raw(uint32_t ofs) override;
+    };
+    FileDecompressor _reader;
+
     /* construct a file name given a log number. Caller must free. */
     char *_log_file_name(const uint16_t log_num) const;
     char *_log_file_name_long(const uint16_t log_num) const;
@@ -154,8 +189,6 @@ private:
     const uint32_t _free_space_check_interval = 1000UL; // milliseconds
     const uint32_t _free_space_min_avail = 8388608; // bytes
 
-    // semaphore mediates access to the ringbuffer
-    HAL_Semaphore semaphore;
     // write_fd_semaphore mediates access to write_fd so the frontend
     // can open/close files without causing the backend to write to a
     // bad fd
@@ -177,6 +210,7 @@ private:
         uint32_t buf_space_sigma;
     };
     struct df_stats stats;
+    uint32_t _df_stats_last_log_ms;
 
     void Write_AP_Logger_Stats_File(const struct df_stats &_stats);
     void df_stats_gather(uint16_t bytes_written);
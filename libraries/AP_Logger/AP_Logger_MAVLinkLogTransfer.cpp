@@ -19,11 +19,36 @@
 
 
 #include <AP_HAL/AP_HAL.h>
+#include <AP_HAL/utility/RingBuffer.h>
 #include <AP_Logger/AP_Logger.h>
 #include <GCS_MAVLink/GCS.h> // for LOG_ENTRY
 
 extern const AP_HAL::HAL& hal;
 
+// size of the buffer large downloads are read ahead into; zero
+// disables bulk downloads
+#ifndef HAL_LOGGER_READ_AHEAD_SIZE
+#if HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+#define HAL_LOGGER_READ_AHEAD_SIZE 65536
+#elif HAL_MEM_CLASS >= HAL_MEM_CLASS_300
+#define HAL_LOGGER_READ_AHEAD_SIZE 16384
+#else
+#define HAL_LOGGER_READ_AHEAD_SIZE 0
+#endif
+#endif
+
+// requests for at least this much data are sent as bulk downloads
+#define LOG_READ_AHEAD_MIN_REQUEST 16384
+
+// size of each read from the log
+#define LOG_READ_AHEAD_CHUNK 4096
+
+// maximum amount read ahead in one run of the IO thread
+#define LOG_READ_AHEAD_MAX_PER_RUN 16384
+
+// maximum number of LOG_DATA messages sent in one update
+#define LOG_BULK_MAX_SENDS 500
+
 // We avoid doing log messages when timing is critical:
 bool AP_Logger::should_handle_log_message()
 {
@@ -108,19 +133,45 @@ void AP_Logger::handle_log_request_data(GCS_MAVLINK &link, const mavlink_message
 {
     WITH_SEMAPHORE(_log_send_sem);
 
+    mavlink_log_request_data_t packet;
+    mavlink_msg_log_request_data_decode(&msg, &packet);
+
     if (_log_sending_link != nullptr) {
-        // some GCS (e.g. MAVProxy) attempt to stream request_data
-        // messages when they're filling gaps in the downloaded logs.
-        // This channel check avoids complaining to them, at the cost
-        // of silently dropping any repeated attempts to start logging
-        if (_log_sending_link->get_chan() != link.get_chan()) {
+        if (_log_sending_link->get_chan() == link.get_chan()) {
+            // some GCS (e.g. MAVProxy) attempt to stream request_data
+            // messages when they're filling gaps in the downloaded
+            // logs. Repeats of the current request are silently
+            // dropped
+            if (transfer_activity != TransferActivity::SENDING ||
+                packet.id != _log_num_data ||
+                packet.ofs == _log_data_request_ofs) {
+                return;
+            }
+            if (packet.count < LOG_READ_AHEAD_MIN_REQUEST) {
+                // a gap is sent alongside a bulk download, which
+                // carries on. Otherwise it waits for the GCS to ask
+                // again once the current request is complete
+                if (_log_read_active) {
+                    _log_gap_ofs = packet.ofs;
+                    _log_gap_remaining = 0;
+                    if (packet.ofs < _log_data_size) {
+                        _log_gap_remaining = MIN(packet.count, _log_data_size - packet.ofs);
+                    }
+                }
+                return;
+            }
+            // a large request for the same log at another offset
+            // restarts the download there, so a GCS can resume from
+            // the data it has
+        } else if (AP_HAL::millis() - _log_sending_link->get_last_received_ms() < 3000) {
             link.send_text(MAV_SEVERITY_INFO, "Log download in progress");
+            return;
         }
-        return;
+        // otherwise the GCS has gone quiet on the link the download
+        // was on and this link takes the download over
     }
 
-    mavlink_log_request_data_t packet;
-    mavlink_msg_log_request_data_decode(&msg, &packet);
+    stop_log_read_ahead();
 
     // consider opening or switching logs:
     if (transfer_activity != TransferActivity::SENDING || _log_num_data != packet.id) {
@@ -130,6 +181,7 @@ void AP_Logger::handle_log_request_data(GCS_MAVLINK &link, const mavlink_message
         if (packet.id > last_log || packet.id < (last_log - num_logs + 1)) {
             // request for an invalid log; cancel any current download
             transfer_activity = TransferActivity::IDLE;
+            _log_sending_link = nullptr;
             return;
         }
 
@@ -143,6 +195,7 @@ void AP_Logger::handle_log_request_data(GCS_MAVLINK &link, const mavlink_message
     }
 
     _log_data_offset = packet.ofs;
+    _log_data_request_ofs = packet.ofs;
     if (_log_data_offset >= _log_data_size) {
         _log_data_remaining = 0;
     } else {
@@ -155,6 +208,11 @@ void AP_Logger::handle_log_request_data(GCS_MAVLINK &link, const mavlink_message
     transfer_activity = TransferActivity::SENDING;
     _log_sending_link = &link;
 
+    if (_log_data_remaining >= LOG_READ_AHEAD_MIN_REQUEST) {
+        // falls back to reading in the main thread on failure
+        start_log_read_ahead();
+    }
+
     handle_log_send();
 }
 
@@ -166,6 +224,9 @@ void AP_Logger::handle_log_request_erase(GCS_MAVLINK &link, const mavlink_messag
     // mavlink_log_erase_t packet;
     // mavlink_msg_log_erase_decode(&msg, &packet);
 
+    // the IO thread must not be reading a log being erased
+    stop_log_read_ahead();
+
     EraseAll();
 }
 
@@ -178,6 +239,7 @@ void AP_Logger::handle_log_request_end(GCS_MAVLINK &link, const mavlink_message_
     mavlink_log_request_end_t packet;
     mavlink_msg_log_request_end_decode(&msg, &packet);
 
+    stop_log_read_ahead();
     transfer_activity = TransferActivity::IDLE;
     _log_sending_link = nullptr;
 }
@@ -193,7 +255,9 @@ void AP_Logger::handle_log_send()
         return;
     }
     if (hal.util->get_soft_armed()) {
-        // might be flying
+        // might be flying. Don't hold on to the read ahead buffer; a
+        // bulk download carries on from the main thread once disarmed
+        stop_log_read_ahead();
         return;
     }
     switch (transfer_activity) {
@@ -212,6 +276,11 @@ void AP_Logger::handle_log_sending()
 {
     WITH_SEMAPHORE(_log_send_sem);
 
+    if (_log_read_active) {
+        handle_log_send_bulk();
+        return;
+    }
+
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
     // assume USB speeds in SITL for the purposes of log download
     const uint8_t num_sends = 40;
@@ -327,3 +396,231 @@ bool AP_Logger::handle_log_send_data()
     }
     return true;
 }
+
+/*
+  start reading the current request ahead in the IO thread. Returns
+  false if there is no memory for the read ahead buffer
+ */
+bool AP_Logger::start_log_read_ahead()
+{
+#if HAL_LOGGER_READ_AHEAD_SIZE > 0
+    if (_log_read_buf == nullptr) {
+        _log_read_buf = new ByteBuffer(HAL_LOGGER_READ_AHEAD_SIZE);
+        if (_log_read_buf == nullptr) {
+            return false;
+        }
+        if (_log_read_buf->get_size() == 0) {
+            delete _log_read_buf;
+            _log_read_buf = nullptr;
+            return false;
+        }
+    }
+    if (!_log_read_registered) {
+        hal.scheduler->register_io_process(FUNCTOR_BIND_MEMBER(&AP_Logger::log_read_ahead, void));
+        _log_read_registered = true;
+    }
+
+    WITH_SEMAPHORE(_log_read_sem);
+    _log_read_buf->clear();
+    _log_gap_remaining = 0;
+    _log_read_ofs = _log_data_offset;
+    _log_read_remaining = _log_data_remaining;
+    _log_read_eof = false;
+    memset(&_log_bulk_stats, 0, sizeof(_log_bulk_stats));
+    _log_bulk_stats.start_ms = AP_HAL::millis();
+    _log_read_active = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+  stop reading ahead, waiting for any read in progress, and free the
+  read ahead buffer
+ */
+void AP_Logger::stop_log_read_ahead()
+{
+    if (!_log_read_active) {
+        return;
+    }
+    WITH_SEMAPHORE(_log_read_sem);
+    _log_read_active = false;
+    delete _log_read_buf;
+    _log_read_buf = nullptr;
+}
+
+/*
+  IO thread: fill the read ahead buffer from the log being downloaded
+ */
+void AP_Logger::log_read_ahead()
+{
+    if (!_log_read_active || _log_read_eof) {
+        return;
+    }
+    if (hal.util->get_soft_armed()) {
+        // logs are not read while we might be flying
+        return;
+    }
+    WITH_SEMAPHORE(_log_read_sem);
+    if (!_log_read_active) {
+        // stopped while we waited
+        return;
+    }
+
+    uint32_t budget = LOG_READ_AHEAD_MAX_PER_RUN;
+    while (budget > 0 && _log_read_remaining > 0) {
+        const uint32_t len = MIN(MIN(budget, _log_read_remaining), uint32_t(LOG_READ_AHEAD_CHUNK));
+        if (_log_read_buf->space() < len) {
+            // wait until the sender has made room
+            break;
+        }
+        ByteBuffer::IoVec vec[2];
+        if (_log_read_buf->reserve(vec, len) == 0) {
+            break;
+        }
+        // read into the first part; a wrapped remainder is read on
+        // the next pass
+        int16_t ret = get_log_data(_log_num_data, _log_data_page, _log_read_ofs, vec[0].len, vec[0].data);
+        if (ret < 0) {
+            // report as EOF on error
+            ret = 0;
+        }
+        _log_read_buf->commit(ret);
+        _log_read_ofs += ret;
+        _log_read_remaining -= ret;
+        budget -= MIN(budget, uint32_t(ret));
+        if (uint32_t(ret) < vec[0].len) {
+            // end of the log
+            _log_read_remaining = 0;
+        }
+    }
+    if (_log_read_remaining == 0) {
+        _log_read_eof = true;
+    }
+}
+
+/*
+  send read ahead log data for as long as the link has space for it
+ */
+void AP_Logger::handle_log_send_bulk()
+{
+    WITH_SEMAPHORE(_log_send_sem);
+
+    _log_bulk_stats.sends++;
+
+    for (uint16_t i=0; i<LOG_BULK_MAX_SENDS; i++) {
+        if (!HAVE_PAYLOAD_SPACE(_log_sending_link->get_chan(), LOG_DATA)) {
+            _log_bulk_stats.link_waits++;
+            return;
+        }
+        if (AP_HAL::millis() - _log_sending_link->get_last_heartbeat_time() > 3000) {
+            // give a heartbeat a chance
+            return;
+        }
+
+        if (_log_gap_remaining > 0) {
+            handle_log_send_gap();
+            continue;
+        }
+
+        // check for EOF before looking at what is buffered so we
+        // never see EOF without the data read before it
+        const bool eof = _log_read_eof;
+        const uint32_t available = _log_read_buf->available();
+        uint32_t len = MIN(_log_data_remaining, uint32_t(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN));
+        if (available < len) {
+            if (!eof) {
+                _log_bulk_stats.io_waits++;
+                return;
+            }
+            len = available;
+        }
+
+        mavlink_log_data_t packet;
+        _log_read_buf->read(packet.data, len);
+        if (len < MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN) {
+            memset(&packet.data[len], 0, MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN-len);
+        }
+        packet.ofs = _log_data_offset;
+        packet.id = _log_num_data;
+        packet.count = len;
+        _mav_finalize_message_chan_send(_log_sending_link->get_chan(),
+                                        MAVLINK_MSG_ID_LOG_DATA,
+                                        (const char *)&packet,
+                                        MAVLINK_MSG_ID_LOG_DATA_MIN_LEN,
+                                        MAVLINK_MSG_ID_LOG_DATA_LEN,
+                                        MAVLINK_MSG_ID_LOG_DATA_CRC);
+
+        _log_data_offset += len;
+        _log_data_remaining -= len;
+        _log_bulk_stats.bytes += len;
+        if (len < MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN || _log_data_remaining == 0) {
+            end_log_send_bulk();
+            return;
+        }
+    }
+}
+
+/*
+  send the next part of a gap the GCS asked for during a bulk
+  download. The log is read here, so the IO thread must not be reading
+  it at the same time
+ */
+void AP_Logger::handle_log_send_gap()
+{
+    WITH_SEMAPHORE(_log_send_sem);
+
+    const uint32_t len = MIN(_log_gap_remaining, uint32_t(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN));
+    mavlink_log_data_t packet;
+    int16_t ret;
+    {
+        WITH_SEMAPHORE(_log_read_sem);
+        ret = get_log_data(_log_num_data, _log_data_page, _log_gap_ofs, len, packet.data);
+    }
+    if (ret < 0) {
+        // report as EOF on error
+        ret = 0;
+    }
+    if (ret < MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN) {
+        memset(&packet.data[ret], 0, MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN-ret);
+    }
+    packet.ofs = _log_gap_ofs;
+    packet.id = _log_num_data;
+    packet.count = ret;
+    _mav_finalize_message_chan_send(_log_sending_link->get_chan(),
+                                    MAVLINK_MSG_ID_LOG_DATA,
+                                    (const char *)&packet,
+                                    MAVLINK_MSG_ID_LOG_DATA_MIN_LEN,
+                                    MAVLINK_MSG_ID_LOG_DATA_LEN,
+                                    MAVLINK_MSG_ID_LOG_DATA_CRC);
+
+    _log_gap_ofs += len;
+    _log_gap_remaining -= len;
+    if (uint32_t(ret) < len) {
+        _log_gap_remaining = 0;
+    }
+}
+
+/*
+  finish a bulk download, telling the GCS its throughput and whether
+  reading the log (io) or the link was the limit
+ */
+void AP_Logger::end_log_send_bulk()
+{
+    WITH_SEMAPHORE(_log_send_sem);
+
+    stop_log_read_ahead();
+
+    const uint32_t dt_ms = MAX(AP_HAL::millis() - _log_bulk_stats.start_ms, 1U);
+    const uint32_t sends = MAX(_log_bulk_stats.sends, 1U);
+    _log_sending_link->send_text(MAV_SEVERITY_INFO, "Log %u %ukB %ukB/s io:%u%% link:%u%%",
+                                 unsigned(_log_num_data),
+                                 unsigned(_log_bulk_stats.bytes / 1024),
+                                 unsigned(_log_bulk_stats.bytes / dt_ms),
+                                 unsigned(_log_bulk_stats.io_waits * 100 / sends),
+                                 unsigned(_log_bulk_stats.link_waits * 100 / sends));
+
+    transfer_activity = TransferActivity::IDLE;
+    _log_sending_link = nullptr;
+}
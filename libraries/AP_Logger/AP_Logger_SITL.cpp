@@ -22,6 +22,10 @@
 
 #define ERASE_TIME_MS 10000
 
+// typical times for a 4k sector erase and a page write
+#define SECTOR_ERASE_TIME_US 45000
+#define PAGE_WRITE_TIME_US 700
+
 extern const AP_HAL::HAL& hal;
 
 void AP_Logger_SITL::Init()
@@ -51,9 +55,26 @@ bool AP_Logger_SITL::CardInserted(void) const
     return df_NumPages > 0;
 }
 
+/*
+  emulate the chip being busy during erases and writes, as the
+  DataFlash backend waits for it
+ */
+bool AP_Logger_SITL::Busy()
+{
+    return AP_HAL::micros64() < busy_until_us;
+}
+
+void AP_Logger_SITL::WaitReady()
+{
+    while (Busy()) {
+        hal.scheduler->delay_microseconds(100);
+    }
+}
+
 void AP_Logger_SITL::PageToBuffer(uint32_t PageAdr)
 {
     assert(PageAdr>0 && PageAdr <= df_NumPages+1);
+    WaitReady();
     if (pread(flash_fd, buffer, DF_PAGE_SIZE, (PageAdr-1)*DF_PAGE_SIZE) != DF_PAGE_SIZE) {
         printf("Failed flash read");
     }
@@ -62,12 +83,28 @@ void AP_Logger_SITL::PageToBuffer(uint32_t PageAdr)
 void AP_Logger_SITL::BufferToPage(uint32_t PageAdr)
 {
     assert(PageAdr>0 && PageAdr <= df_NumPages+1);
+    WaitReady();
+
+    // writing can only clear bits, so writing a page which hasn't
+    // been erased corrupts it on a real chip. Catch the logger doing
+    // that here
+    uint8_t page[DF_PAGE_SIZE];
+    memset(page, 0xFF, sizeof(page));
+    if (pread(flash_fd, page, DF_PAGE_SIZE, (PageAdr-1)*DF_PAGE_SIZE) != DF_PAGE_SIZE) {
+        printf("Failed flash read");
+    }
+    for (uint16_t i=0; i<DF_PAGE_SIZE; i++) {
+        if (page[i] != 0xFF) {
+            AP_HAL::panic("Flash write to unerased page %u", unsigned(PageAdr));
+        }
+    }
     if (pwrite(flash_fd, buffer, DF_PAGE_SIZE, (PageAdr-1)*DF_PAGE_SIZE) != DF_PAGE_SIZE) {
         printf("Failed flash write");
     }
+    busy_until_us = AP_HAL::micros64() + PAGE_WRITE_TIME_US;
 }
 
-void AP_Logger_SITL::SectorErase(uint32_t SectorAdr)
+void AP_Logger_SITL::EraseSectorData(uint32_t SectorAdr)
 {
     uint8_t fill[DF_PAGE_SIZE*DF_PAGE_PER_SECTOR];
     memset(fill, 0xFF, sizeof(fill));
@@ -76,6 +113,13 @@ void AP_Logger_SITL::SectorErase(uint32_t SectorAdr)
     }
 }
 
+void AP_Logger_SITL::SectorErase(uint32_t SectorAdr)
+{
+    WaitReady();
+    EraseSectorData(SectorAdr);
+    busy_until_us = AP_HAL::micros64() + SECTOR_ERASE_TIME_US;
+}
+
 void AP_Logger_SITL::Sector4kErase(uint32_t SectorAdr)
 {
     SectorErase(SectorAdr);
@@ -83,8 +127,9 @@ void AP_Logger_SITL::Sector4kErase(uint32_t SectorAdr)
 
 void AP_Logger_SITL::StartErase()
 {
+    // chip erase time is emulated by InErase()
     for (uint32_t i=0; i<DF_NUM_PAGES/DF_PAGE_PER_SECTOR; i++) {
-        SectorErase(i);
+        EraseSectorData(i);
     }
     erase_started_ms = AP_HAL::millis();
 }
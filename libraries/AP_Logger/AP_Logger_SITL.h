@@ -25,9 +25,14 @@ private:
     void  Sector4kErase(uint32_t SectorAdr) override;
     void  StartErase() override;
     bool  InErase() override;
+    bool  Busy() override;
+    void  WaitReady();
+    void  EraseSectorData(uint32_t SectorAdr);
 
     int flash_fd;
     uint32_t erase_started_ms;
+    // emulated time the last erase or write completes at
+    uint64_t busy_until_us;
 };
 
 #endif // CONFIG_HAL_BOARD == HAL_BOARD_SITL
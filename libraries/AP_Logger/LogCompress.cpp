@@ -0,0 +1,495 @@
+/*
+  block compression of log files
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LogCompress.h"
+
+#include <AP_Math/AP_Math.h>
+#include <string.h>
+
+static_assert(LOG_COMPRESS_BLOCK_MAX <= UINT16_MAX, "block data length must fit in log_compress_block");
+
+/*
+  constants from the LZ4 block format. The last match must start at
+  least LZ4_MFLIMIT bytes before the end of the block and the last
+  LZ4_LASTLITERALS bytes are always literals
+ */
+#define LZ4_MINMATCH 4
+#define LZ4_MFLIMIT 12
+#define LZ4_LASTLITERALS 5
+
+static inline uint32_t read32(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint16_t lz4_hash(uint32_t seq)
+{
+    return (seq * 2654435761U) >> (32 - LOG_COMPRESS_HASH_BITS);
+}
+
+// write the extra length bytes of a literal or match length which
+// didn't fit in the token
+static inline uint8_t *lz4_put_length(uint8_t *op, uint32_t len)
+{
+    while (len >= 255) {
+        *op++ = 255;
+        len -= 255;
+    }
+    *op++ = len;
+    return op;
+}
+
+/*
+  emit one sequence: lit_len literals followed by a match of match_len
+  bytes at offset. A match_len of zero emits the final literal-only
+  sequence. Returns nullptr if the sequence does not fit before oend
+ */
+static uint8_t *lz4_emit(uint8_t *op, const uint8_t *oend,
+                         const uint8_t *lit, uint32_t lit_len,
+                         uint16_t offset, uint32_t match_len)
+{
+    // worst case encoded size of this sequence
+    const uint32_t need = 1 + lit_len/255 + 1 + lit_len + 2 + match_len/255 + 1;
+    if (need > uint32_t(oend - op)) {
+        return nullptr;
+    }
+    uint8_t *token = op++;
+    uint8_t t;
+    if (lit_len >= 15) {
+        t = 15 << 4;
+        op = lz4_put_length(op, lit_len - 15);
+    } else {
+        t = lit_len << 4;
+    }
+    memcpy(op, lit, lit_len);
+    op += lit_len;
+    if (match_len != 0) {
+        *op++ = offset & 0xFF;
+        *op++ = offset >> 8;
+        const uint32_t m = match_len - LZ4_MINMATCH;
+        if (m >= 15) {
+            t |= 15;
+            op = lz4_put_length(op, m - 15);
+        } else {
+            t |= m;
+        }
+    }
+    *token = t;
+    return op;
+}
+
+LogCompressor::~LogCompressor()
+{
+    delete[] hash_table;
+}
+
+bool LogCompressor::init()
+{
+    if (hash_table == nullptr) {
+        hash_table = new uint16_t[1U<<LOG_COMPRESS_HASH_BITS];
+    }
+    return hash_table != nullptr;
+}
+
+/*
+  greedy LZ4 compressor. Log data is dominated by repeated message
+  headers and slowly changing fields, so a single hash probe per
+  position finds most of the available matches
+ */
+uint16_t LogCompressor::lz4_compress(const uint8_t *src, uint16_t len, uint8_t *dst, uint16_t dst_size)
+{
+    // positions from a previous block would point at unrelated data
+    memset(hash_table, 0, sizeof(hash_table[0]) << LOG_COMPRESS_HASH_BITS);
+
+    uint8_t *op = dst;
+    const uint8_t *oend = dst + dst_size;
+    uint16_t ip = 0;
+    uint16_t anchor = 0;
+
+    if (len > LZ4_MFLIMIT) {
+        const uint16_t ip_limit = len - LZ4_MFLIMIT;
+        const uint16_t match_limit = len - LZ4_LASTLITERALS;
+        while (ip < ip_limit) {
+            const uint32_t seq = read32(&src[ip]);
+            const uint16_t h = lz4_hash(seq);
+            const uint16_t ref = hash_table[h];
+            hash_table[h] = ip;
+            if (ref >= ip || read32(&src[ref]) != seq) {
+                ip++;
+                continue;
+            }
+            uint16_t match_len = LZ4_MINMATCH;
+            while (ip + match_len < match_limit && src[ref + match_len] == src[ip + match_len]) {
+                match_len++;
+            }
+            op = lz4_emit(op, oend, &src[anchor], ip - anchor, ip - ref, match_len);
+            if (op == nullptr) {
+                return 0;
+            }
+            ip += match_len;
+            anchor = ip;
+        }
+    }
+
+    op = lz4_emit(op, oend, &src[anchor], len - anchor, 0, 0);
+    if (op == nullptr) {
+        return 0;
+    }
+    return op - dst;
+}
+
+uint16_t LogCompressor::compress_block(const uint8_t *src, uint16_t len, uint8_t *dst)
+{
+    struct log_compress_block blk;
+    blk.data_len = len;
+    // only keep the compressed data if it is smaller
+    blk.comp_len = lz4_compress(src, len, &dst[sizeof(blk)], len - 1);
+    if (blk.comp_len == 0) {
+        memcpy(&dst[sizeof(blk)], src, len);
+    }
+    memcpy(dst, &blk, sizeof(blk));
+    return sizeof(blk) + (blk.comp_len != 0 ? blk.comp_len : len);
+}
+
+int32_t log_lz4_decompress(const uint8_t *src, uint16_t src_len, uint8_t *dst, uint16_t dst_size)
+{
+    const uint8_t *ip = src;
+    const uint8_t *iend = src + src_len;
+    uint8_t *op = dst;
+    const uint8_t *oend = dst + dst_size;
+
+    while (ip < iend) {
+        const uint8_t token = *ip++;
+        uint32_t lit_len = token >> 4;
+        if (lit_len == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend) {
+                    return -1;
+                }
+                b = *ip++;
+                lit_len += b;
+            } while (b == 255);
+        }
+        if (lit_len > uint32_t(iend - ip) || lit_len > uint32_t(oend - op)) {
+            return -1;
+        }
+        memcpy(op, ip, lit_len);
+        op += lit_len;
+        ip += lit_len;
+        if (ip == iend) {
+            // the last sequence has no match
+            break;
+        }
+        if (iend - ip < 2) {
+            return -1;
+        }
+        const uint16_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > op - dst) {
+            return -1;
+        }
+        uint32_t match_len = token & 0x0F;
+        if (match_len == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend) {
+                    return -1;
+                }
+                b = *ip++;
+                match_len += b;
+            } while (b == 255);
+        }
+        match_len += LZ4_MINMATCH;
+        if (match_len > uint32_t(oend - op)) {
+            return -1;
+        }
+        // matches may overlap their own output so copy bytewise
+        const uint8_t *ref = op - offset;
+        while (match_len--) {
+            *op++ = *ref++;
+        }
+    }
+    return op - dst;
+}
+
+LogDecompressor::~LogDecompressor()
+{
+    delete[] data;
+    delete[] cbuf;
+}
+
+void LogDecompressor::reset()
+{
+    delete[] data;
+    data = nullptr;
+    delete[] cbuf;
+    cbuf = nullptr;
+    state = State::UNKNOWN;
+    peek_len = 0;
+    peek_ofs = 0;
+    header_data_size = 0;
+    header_data_end = 0;
+    data_len = 0;
+    data_ofs = 0;
+    block_start = 0;
+    offset = 0;
+    raw_pos = 0;
+}
+
+// read count bytes unless the end of the file is reached
+ssize_t LogDecompressor::read_full(void *buf, uint32_t count)
+{
+    uint8_t *b = (uint8_t *)buf;
+    uint32_t ret = 0;
+    while (ret < count) {
+        const ssize_t n = read_raw(&b[ret], count - ret);
+        if (n < 0) {
+            return -1;
+        }
+        if (n == 0) {
+            break;
+        }
+        ret += n;
+    }
+    raw_pos += ret;
+    return ret;
+}
+
+// look for the compressed log header at the start of the file
+bool LogDecompressor::detect()
+{
+    struct log_compress_header hdr;
+    const ssize_t n = read_full(&hdr, sizeof(hdr));
+    if (n < 0) {
+        return false;
+    }
+    if (n == sizeof(hdr) && hdr.magic == LOG_COMPRESS_MAGIC) {
+        state = State::COMPRESSED;
+        header_data_size = hdr.data_size;
+        header_data_end = hdr.data_end;
+        return true;
+    }
+    // an uncompressed log, hand back what we have read on the next read
+    memcpy(peek, &hdr, n);
+    peek_len = n;
+    peek_ofs = 0;
+    state = State::PLAIN;
+    return true;
+}
+
+int8_t LogDecompressor::read_block_header(struct log_compress_block &blk)
+{
+    block_start += data_len;
+    data_len = 0;
+    data_ofs = 0;
+    const ssize_t n = read_full(&blk, sizeof(blk));
+    if (n < 0) {
+        return -1;
+    }
+    if (n != sizeof(blk)) {
+        // end of the log
+        return 0;
+    }
+    if (blk.data_len == 0 || blk.data_len > LOG_COMPRESS_BLOCK_MAX ||
+        blk.comp_len >= blk.data_len) {
+        return -1;
+    }
+    return 1;
+}
+
+int8_t LogDecompressor::read_block_data(const struct log_compress_block &blk)
+{
+    if (data == nullptr) {
+        data = new uint8_t[LOG_COMPRESS_BLOCK_MAX];
+        if (data == nullptr) {
+            return -1;
+        }
+    }
+    if (blk.comp_len == 0) {
+        const ssize_t n = read_full(data, blk.data_len);
+        if (n < 0) {
+            return -1;
+        }
+        if (n != blk.data_len) {
+            // block cut short when the log was stopped
+            return 0;
+        }
+    } else {
+        if (cbuf == nullptr) {
+            cbuf = new uint8_t[LOG_COMPRESS_BLOCK_MAX];
+            if (cbuf == nullptr) {
+                return -1;
+            }
+        }
+        const ssize_t n = read_full(cbuf, blk.comp_len);
+        if (n < 0) {
+            return -1;
+        }
+        if (n != blk.comp_len) {
+            return 0;
+        }
+        if (log_lz4_decompress(cbuf, blk.comp_len, data, LOG_COMPRESS_BLOCK_MAX) != blk.data_len) {
+            return -1;
+        }
+    }
+    data_len = blk.data_len;
+    return 1;
+}
+
+int8_t LogDecompressor::next_block()
+{
+    struct log_compress_block blk;
+    const int8_t ret = read_block_header(blk);
+    if (ret <= 0) {
+        return ret;
+    }
+    return read_block_data(blk);
+}
+
+ssize_t LogDecompressor::read(void *buf, uint32_t count)
+{
+    if (state == State::UNKNOWN && !detect()) {
+        return -1;
+    }
+    uint8_t *b = (uint8_t *)buf;
+    uint32_t ret = 0;
+
+    if (state == State::PLAIN) {
+        ret = MIN(count, uint32_t(peek_len - peek_ofs));
+        memcpy(b, &peek[peek_ofs], ret);
+        peek_ofs += ret;
+        if (ret < count) {
+            const ssize_t n = read_raw(&b[ret], count - ret);
+            if (n < 0) {
+                return -1;
+            }
+            ret += n;
+            raw_pos += n;
+        }
+        offset += ret;
+        return ret;
+    }
+
+    while (ret < count) {
+        if (data_ofs == data_len) {
+            const int8_t r = next_block();
+            if (r < 0) {
+                return -1;
+            }
+            if (r == 0) {
+                break;
+            }
+        }
+        const uint32_t n = MIN(count - ret, uint32_t(data_len - data_ofs));
+        memcpy(&b[ret], &data[data_ofs], n);
+        data_ofs += n;
+        ret += n;
+    }
+    offset += ret;
+    return ret;
+}
+
+bool LogDecompressor::seek(uint32_t ofs)
+{
+    if (state == State::UNKNOWN && !detect()) {
+        return false;
+    }
+    if (ofs == offset) {
+        return true;
+    }
+
+    if (state == State::PLAIN) {
+        if (!seek_raw(ofs)) {
+            return false;
+        }
+        raw_pos = ofs;
+        peek_len = 0;
+        peek_ofs = 0;
+        offset = ofs;
+        return true;
+    }
+
+    if (ofs < block_start) {
+        // rewind to the first block
+        if (!seek_raw(sizeof(struct log_compress_header))) {
+            return false;
+        }
+        raw_pos = sizeof(struct log_compress_header);
+        block_start = 0;
+        data_len = 0;
+        data_ofs = 0;
+    }
+
+    // skip over whole blocks without decompressing them
+    while (ofs >= block_start + data_len) {
+        struct log_compress_block blk;
+        const int8_t r = read_block_header(blk);
+        if (r < 0) {
+            return false;
+        }
+        if (r == 0) {
+            // seeking past the end leaves us at the end
+            offset = block_start;
+            return true;
+        }
+        if (ofs < block_start + blk.data_len) {
+            if (read_block_data(blk) < 0) {
+                return false;
+            }
+            break;
+        }
+        raw_pos += blk.comp_len != 0 ? blk.comp_len : blk.data_len;
+        if (!seek_raw(raw_pos)) {
+            return false;
+        }
+        block_start += blk.data_len;
+    }
+
+    data_ofs = MIN(ofs - block_start, uint32_t(data_len));
+    offset = block_start + data_ofs;
+    return true;
+}
+
+bool LogDecompressor::get_data_size(uint32_t file_size, uint32_t &size)
+{
+    reset();
+    if (!seek_raw(0) || !detect() || state != State::COMPRESSED) {
+        return false;
+    }
+    size = 0;
+    if (header_data_end > raw_pos && header_data_end <= file_size) {
+        if (!seek_raw(header_data_end)) {
+            return false;
+        }
+        raw_pos = header_data_end;
+        size = header_data_size;
+    }
+
+    // add up the complete blocks written since the header was last
+    // updated, there are none if the log was closed cleanly
+    struct log_compress_block blk;
+    while (read_block_header(blk) > 0) {
+        raw_pos += blk.comp_len != 0 ? blk.comp_len : blk.data_len;
+        if (raw_pos > file_size || !seek_raw(raw_pos)) {
+            break;
+        }
+        size += blk.data_len;
+    }
+    return true;
+}
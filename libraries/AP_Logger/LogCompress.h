@@ -0,0 +1,166 @@
+/*
+  block compression of log files
+
+  A compressed log file starts with a log_compress_header followed by
+  a sequence of blocks. Each block is a log_compress_block header
+  followed by either the block data compressed in the LZ4 block format
+  or, when the data did not compress, the data itself. Blocks are
+  compressed independently so a log cut short by a power loss can be
+  read up to the last complete block.
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <AP_Common/AP_Common.h>
+
+// "APLZ" when read as little-endian. Can't be mistaken for the start
+// of an uncompressed log as that starts with HEAD_BYTE1
+#define LOG_COMPRESS_MAGIC 0x5A4C5041
+
+// maximum amount of log data in one block
+#ifndef LOG_COMPRESS_BLOCK_MAX
+#define LOG_COMPRESS_BLOCK_MAX 4096
+#endif
+
+// size of the compressor hash table is 2^LOG_COMPRESS_HASH_BITS entries
+#ifndef LOG_COMPRESS_HASH_BITS
+#define LOG_COMPRESS_HASH_BITS 12
+#endif
+
+struct PACKED log_compress_header {
+    uint32_t magic;
+    // amount of log data in the blocks before file offset data_end.
+    // The header is updated while logging and when the log is closed,
+    // so only the blocks from data_end on need to be walked to find
+    // the size of a log that was not closed cleanly
+    uint32_t data_size;
+    uint32_t data_end;
+};
+
+struct PACKED log_compress_block {
+    // amount of log data held in this block
+    uint16_t data_len;
+    // length of the compressed data, zero if the data is stored
+    // uncompressed
+    uint16_t comp_len;
+};
+
+// largest possible encoded block
+#define LOG_COMPRESS_BLOCK_BOUND (sizeof(struct log_compress_block) + LOG_COMPRESS_BLOCK_MAX)
+
+/*
+  decompress an LZ4 block. Returns the decompressed length or -1 if
+  the input is corrupt or does not fit in dst
+ */
+int32_t log_lz4_decompress(const uint8_t *src, uint16_t src_len, uint8_t *dst, uint16_t dst_size);
+
+class LogCompressor
+{
+public:
+    ~LogCompressor();
+
+    // allocate the hash table, returns false on allocation failure
+    bool init();
+
+    bool initialised() const { return hash_table != nullptr; }
+
+    /*
+      encode len bytes of log data as a block, including its block
+      header. len must be at most LOG_COMPRESS_BLOCK_MAX and dst must
+      have room for LOG_COMPRESS_BLOCK_BOUND bytes. Returns the number
+      of bytes placed in dst
+     */
+    uint16_t compress_block(const uint8_t *src, uint16_t len, uint8_t *dst);
+
+private:
+    // returns the compressed length, or zero if the output would not
+    // fit in dst_size bytes
+    uint16_t lz4_compress(const uint8_t *src, uint16_t len, uint8_t *dst, uint16_t dst_size);
+
+    uint16_t *hash_table = nullptr;
+};
+
+/*
+  reader for log files which transparently decompresses compressed
+  logs and passes other logs through unchanged. Subclasses provide
+  access to the underlying file
+ */
+class LogDecompressor
+{
+public:
+    virtual ~LogDecompressor();
+
+    // read up to count bytes of log data. Returns the number of bytes
+    // read, zero at the end of the log or -1 on error
+    ssize_t read(void *buf, uint32_t count);
+
+    // move to an offset in the log data. Moving backwards in a
+    // compressed log restarts from the first block
+    bool seek(uint32_t ofs);
+
+    // forget all state. The underlying file must be positioned at its
+    // start before the next read
+    void reset();
+
+    /*
+      find the amount of log data in a compressed log file of
+      file_size bytes. Returns false for uncompressed logs, whose size
+      is the file size
+     */
+    bool get_data_size(uint32_t file_size, uint32_t &size);
+
+protected:
+    virtual ssize_t read_raw(void *buf, uint32_t count) = 0;
+    virtual bool seek_raw(uint32_t ofs) = 0;
+
+private:
+    enum class State : uint8_t {
+        UNKNOWN,
+        PLAIN,
+        COMPRESSED,
+    } state = State::UNKNOWN;
+
+    bool detect();
+    ssize_t read_full(void *buf, uint32_t count);
+
+    // these return 1 on success, 0 at the end of the log and -1 on error
+    int8_t read_block_header(struct log_compress_block &blk);
+    int8_t read_block_data(const struct log_compress_block &blk);
+    int8_t next_block();
+
+    // bytes read from the start of an uncompressed log while looking
+    // for the header
+    uint8_t peek[sizeof(struct log_compress_header)];
+    uint8_t peek_len = 0;
+    uint8_t peek_ofs = 0;
+
+    uint32_t header_data_size = 0;
+    uint32_t header_data_end = 0;
+
+    // decompressed data of the current block
+    uint8_t *data = nullptr;
+    // compressed data of the current block
+    uint8_t *cbuf = nullptr;
+    uint16_t data_len = 0;
+    uint16_t data_ofs = 0;
+    // log data offset of the start of the current block
+    uint32_t block_start = 0;
+    // log data offset of the next read
+    uint32_t offset = 0;
+    // offset in the underlying file
+    uint32_t raw_pos = 0;
+};
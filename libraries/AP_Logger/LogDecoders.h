@@ -0,0 +1,3892 @@
+// auto generated decoders, don't manually edit. See README.md for details.
+#pragma once
+
+/*
+  typed decoders for the messages in LogStructure.h, generated by
+  generator/gen_log_decoders.py. Check a decoder with matches() against
+  the FMT message of the log being read before using it.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <AP_Common/AP_Common.h>
+#include "LogStructure.h"
+
+namespace LogDecode {
+
+// true if the format of a message in a log is the one compiled in
+static inline bool format_matches(const struct log_Format &f, uint8_t length,
+                                  const char *format, const char *labels)
+{
+    return f.length == length &&
+        strncmp(f.format, format, sizeof(f.format)) == 0 &&
+        strncmp(f.labels, labels, sizeof(f.labels)) == 0;
+}
+
+struct FMT {
+    static const char *name() { return "FMT"; }
+    static const char *format() { return "BBnNZ"; }
+    static const char *labels() { return "Type,Length,Name,Format,Columns"; }
+    static uint8_t length() { return 89; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint8_t Type;
+    uint8_t Length;
+    char Name[4];
+    char Format[16];
+    char Columns[64];
+
+    void decode(const uint8_t *msg) {
+        memcpy(&Type, &msg[3], sizeof(Type));
+        memcpy(&Length, &msg[4], sizeof(Length));
+        memcpy(&Name, &msg[5], sizeof(Name));
+        memcpy(&Format, &msg[9], sizeof(Format));
+        memcpy(&Columns, &msg[25], sizeof(Columns));
+    }
+};
+
+struct UNIT {
+    static const char *name() { return "UNIT"; }
+    static const char *format() { return "QbZ"; }
+    static const char *labels() { return "TimeUS,Id,Label"; }
+    static uint8_t length() { return 76; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int8_t Id;
+    char Label[64];
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Id, &msg[11], sizeof(Id));
+        memcpy(&Label, &msg[12], sizeof(Label));
+    }
+};
+
+struct FMTU {
+    static const char *name() { return "FMTU"; }
+    static const char *format() { return "QBNN"; }
+    static const char *labels() { return "TimeUS,FmtType,UnitIds,MultIds"; }
+    static uint8_t length() { return 44; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t FmtType;
+    char UnitIds[16];
+    char MultIds[16];
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&FmtType, &msg[11], sizeof(FmtType));
+        memcpy(&UnitIds, &msg[12], sizeof(UnitIds));
+        memcpy(&MultIds, &msg[28], sizeof(MultIds));
+    }
+};
+
+struct MULT {
+    static const char *name() { return "MULT"; }
+    static const char *format() { return "Qbd"; }
+    static const char *labels() { return "TimeUS,Id,Mult"; }
+    static uint8_t length() { return 20; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int8_t Id;
+    double Mult;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Id, &msg[11], sizeof(Id));
+        memcpy(&Mult, &msg[12], sizeof(Mult));
+    }
+};
+
+struct PARM {
+    static const char *name() { return "PARM"; }
+    static const char *format() { return "QNf"; }
+    static const char *labels() { return "TimeUS,Name,Value"; }
+    static uint8_t length() { return 31; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    char Name[16];
+    float Value;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Name, &msg[11], sizeof(Name));
+        memcpy(&Value, &msg[27], sizeof(Value));
+    }
+};
+
+struct GPS {
+    static const char *name() { return "GPS"; }
+    static const char *format() { return "QBIHBcLLeffffB"; }
+    static const char *labels() { return "TimeUS,Status,GMS,GWk,NSats,HDop,Lat,Lng,Alt,Spd,GCrs,VZ,Yaw,U"; }
+    static uint8_t length() { return 50; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Status;
+    uint32_t GMS;
+    uint16_t GWk;
+    uint8_t NSats;
+    int16_t HDop;
+    int32_t Lat;
+    int32_t Lng;
+    int32_t Alt;
+    float Spd;
+    float GCrs;
+    float VZ;
+    float Yaw;
+    uint8_t U;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Status, &msg[11], sizeof(Status));
+        memcpy(&GMS, &msg[12], sizeof(GMS));
+        memcpy(&GWk, &msg[16], sizeof(GWk));
+        memcpy(&NSats, &msg[18], sizeof(NSats));
+        memcpy(&HDop, &msg[19], sizeof(HDop));
+        memcpy(&Lat, &msg[21], sizeof(Lat));
+        memcpy(&Lng, &msg[25], sizeof(Lng));
+        memcpy(&Alt, &msg[29], sizeof(Alt));
+        memcpy(&Spd, &msg[33], sizeof(Spd));
+        memcpy(&GCrs, &msg[37], sizeof(GCrs));
+        memcpy(&VZ, &msg[41], sizeof(VZ));
+        memcpy(&Yaw, &msg[45], sizeof(Yaw));
+        memcpy(&U, &msg[49], sizeof(U));
+    }
+};
+
+struct GPS2 {
+    static const char *name() { return "GPS2"; }
+    static const char *format() { return "QBIHBcLLeffffB"; }
+    static const char *labels() { return "TimeUS,Status,GMS,GWk,NSats,HDop,Lat,Lng,Alt,Spd,GCrs,VZ,Yaw,U"; }
+    static uint8_t length() { return 50; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Status;
+    uint32_t GMS;
+    uint16_t GWk;
+    uint8_t NSats;
+    int16_t HDop;
+    int32_t Lat;
+    int32_t Lng;
+    int32_t Alt;
+    float Spd;
+    float GCrs;
+    float VZ;
+    float Yaw;
+    uint8_t U;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Status, &msg[11], sizeof(Status));
+        memcpy(&GMS, &msg[12], sizeof(GMS));
+        memcpy(&GWk, &msg[16], sizeof(GWk));
+        memcpy(&NSats, &msg[18], sizeof(NSats));
+        memcpy(&HDop, &msg[19], sizeof(HDop));
+        memcpy(&Lat, &msg[21], sizeof(Lat));
+        memcpy(&Lng, &msg[25], sizeof(Lng));
+        memcpy(&Alt, &msg[29], sizeof(Alt));
+        memcpy(&Spd, &msg[33], sizeof(Spd));
+        memcpy(&GCrs, &msg[37], sizeof(GCrs));
+        memcpy(&VZ, &msg[41], sizeof(VZ));
+        memcpy(&Yaw, &msg[45], sizeof(Yaw));
+        memcpy(&U, &msg[49], sizeof(U));
+    }
+};
+
+struct GPSB {
+    static const char *name() { return "GPSB"; }
+    static const char *format() { return "QBIHBcLLeffffB"; }
+    static const char *labels() { return "TimeUS,Status,GMS,GWk,NSats,HDop,Lat,Lng,Alt,Spd,GCrs,VZ,Yaw,U"; }
+    static uint8_t length() { return 50; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Status;
+    uint32_t GMS;
+    uint16_t GWk;
+    uint8_t NSats;
+    int16_t HDop;
+    int32_t Lat;
+    int32_t Lng;
+    int32_t Alt;
+    float Spd;
+    float GCrs;
+    float VZ;
+    float Yaw;
+    uint8_t U;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Status, &msg[11], sizeof(Status));
+        memcpy(&GMS, &msg[12], sizeof(GMS));
+        memcpy(&GWk, &msg[16], sizeof(GWk));
+        memcpy(&NSats, &msg[18], sizeof(NSats));
+        memcpy(&HDop, &msg[19], sizeof(HDop));
+        memcpy(&Lat, &msg[21], sizeof(Lat));
+        memcpy(&Lng, &msg[25], sizeof(Lng));
+        memcpy(&Alt, &msg[29], sizeof(Alt));
+        memcpy(&Spd, &msg[33], sizeof(Spd));
+        memcpy(&GCrs, &msg[37], sizeof(GCrs));
+        memcpy(&VZ, &msg[41], sizeof(VZ));
+        memcpy(&Yaw, &msg[45], sizeof(Yaw));
+        memcpy(&U, &msg[49], sizeof(U));
+    }
+};
+
+struct GPA {
+    static const char *name() { return "GPA"; }
+    static const char *format() { return "QCCCCfBIH"; }
+    static const char *labels() { return "TimeUS,VDop,HAcc,VAcc,SAcc,YAcc,VV,SMS,Delta"; }
+    static uint8_t length() { return 30; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint16_t VDop;
+    uint16_t HAcc;
+    uint16_t VAcc;
+    uint16_t SAcc;
+    float YAcc;
+    uint8_t VV;
+    uint32_t SMS;
+    uint16_t Delta;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&VDop, &msg[11], sizeof(VDop));
+        memcpy(&HAcc, &msg[13], sizeof(HAcc));
+        memcpy(&VAcc, &msg[15], sizeof(VAcc));
+        memcpy(&SAcc, &msg[17], sizeof(SAcc));
+        memcpy(&YAcc, &msg[19], sizeof(YAcc));
+        memcpy(&VV, &msg[23], sizeof(VV));
+        memcpy(&SMS, &msg[24], sizeof(SMS));
+        memcpy(&Delta, &msg[28], sizeof(Delta));
+    }
+};
+
+struct GPA2 {
+    static const char *name() { return "GPA2"; }
+    static const char *format() { return "QCCCCfBIH"; }
+    static const char *labels() { return "TimeUS,VDop,HAcc,VAcc,SAcc,YAcc,VV,SMS,Delta"; }
+    static uint8_t length() { return 30; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint16_t VDop;
+    uint16_t HAcc;
+    uint16_t VAcc;
+    uint16_t SAcc;
+    float YAcc;
+    uint8_t VV;
+    uint32_t SMS;
+    uint16_t Delta;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&VDop, &msg[11], sizeof(VDop));
+        memcpy(&HAcc, &msg[13], sizeof(HAcc));
+        memcpy(&VAcc, &msg[15], sizeof(VAcc));
+        memcpy(&SAcc, &msg[17], sizeof(SAcc));
+        memcpy(&YAcc, &msg[19], sizeof(YAcc));
+        memcpy(&VV, &msg[23], sizeof(VV));
+        memcpy(&SMS, &msg[24], sizeof(SMS));
+        memcpy(&Delta, &msg[28], sizeof(Delta));
+    }
+};
+
+struct GPAB {
+    static const char *name() { return "GPAB"; }
+    static const char *format() { return "QCCCCfBIH"; }
+    static const char *labels() { return "TimeUS,VDop,HAcc,VAcc,SAcc,YAcc,VV,SMS,Delta"; }
+    static uint8_t length() { return 30; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint16_t VDop;
+    uint16_t HAcc;
+    uint16_t VAcc;
+    uint16_t SAcc;
+    float YAcc;
+    uint8_t VV;
+    uint32_t SMS;
+    uint16_t Delta;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&VDop, &msg[11], sizeof(VDop));
+        memcpy(&HAcc, &msg[13], sizeof(HAcc));
+        memcpy(&VAcc, &msg[15], sizeof(VAcc));
+        memcpy(&SAcc, &msg[17], sizeof(SAcc));
+        memcpy(&YAcc, &msg[19], sizeof(YAcc));
+        memcpy(&VV, &msg[23], sizeof(VV));
+        memcpy(&SMS, &msg[24], sizeof(SMS));
+        memcpy(&Delta, &msg[28], sizeof(Delta));
+    }
+};
+
+struct IMU {
+    static const char *name() { return "IMU"; }
+    static const char *format() { return "QffffffIIfBBHH"; }
+    static const char *labels() { return "TimeUS,GyrX,GyrY,GyrZ,AccX,AccY,AccZ,EG,EA,T,GH,AH,GHz,AHz"; }
+    static uint8_t length() { return 53; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float GyrX;
+    float GyrY;
+    float GyrZ;
+    float AccX;
+    float AccY;
+    float AccZ;
+    uint32_t EG;
+    uint32_t EA;
+    float T;
+    uint8_t GH;
+    uint8_t AH;
+    uint16_t GHz;
+    uint16_t AHz;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&GyrX, &msg[11], sizeof(GyrX));
+        memcpy(&GyrY, &msg[15], sizeof(GyrY));
+        memcpy(&GyrZ, &msg[19], sizeof(GyrZ));
+        memcpy(&AccX, &msg[23], sizeof(AccX));
+        memcpy(&AccY, &msg[27], sizeof(AccY));
+        memcpy(&AccZ, &msg[31], sizeof(AccZ));
+        memcpy(&EG, &msg[35], sizeof(EG));
+        memcpy(&EA, &msg[39], sizeof(EA));
+        memcpy(&T, &msg[43], sizeof(T));
+        memcpy(&GH, &msg[47], sizeof(GH));
+        memcpy(&AH, &msg[48], sizeof(AH));
+        memcpy(&GHz, &msg[49], sizeof(GHz));
+        memcpy(&AHz, &msg[51], sizeof(AHz));
+    }
+};
+
+struct MSG {
+    static const char *name() { return "MSG"; }
+    static const char *format() { return "QZ"; }
+    static const char *labels() { return "TimeUS,Message"; }
+    static uint8_t length() { return 75; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    char Message[64];
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Message, &msg[11], sizeof(Message));
+    }
+};
+
+struct RCIN {
+    static const char *name() { return "RCIN"; }
+    static const char *format() { return "QHHHHHHHHHHHHHH"; }
+    static const char *labels() { return "TimeUS,C1,C2,C3,C4,C5,C6,C7,C8,C9,C10,C11,C12,C13,C14"; }
+    static uint8_t length() { return 39; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint16_t C1;
+    uint16_t C2;
+    uint16_t C3;
+    uint16_t C4;
+    uint16_t C5;
+    uint16_t C6;
+    uint16_t C7;
+    uint16_t C8;
+    uint16_t C9;
+    uint16_t C10;
+    uint16_t C11;
+    uint16_t C12;
+    uint16_t C13;
+    uint16_t C14;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&C1, &msg[11], sizeof(C1));
+        memcpy(&C2, &msg[13], sizeof(C2));
+        memcpy(&C3, &msg[15], sizeof(C3));
+        memcpy(&C4, &msg[17], sizeof(C4));
+        memcpy(&C5, &msg[19], sizeof(C5));
+        memcpy(&C6, &msg[21], sizeof(C6));
+        memcpy(&C7, &msg[23], sizeof(C7));
+        memcpy(&C8, &msg[25], sizeof(C8));
+        memcpy(&C9, &msg[27], sizeof(C9));
+        memcpy(&C10, &msg[29], sizeof(C10));
+        memcpy(&C11, &msg[31], sizeof(C11));
+        memcpy(&C12, &msg[33], sizeof(C12));
+        memcpy(&C13, &msg[35], sizeof(C13));
+        memcpy(&C14, &msg[37], sizeof(C14));
+    }
+};
+
+struct RCOU {
+    static const char *name() { return "RCOU"; }
+    static const char *format() { return "QHHHHHHHHHHHHHH"; }
+    static const char *labels() { return "TimeUS,C1,C2,C3,C4,C5,C6,C7,C8,C9,C10,C11,C12,C13,C14"; }
+    static uint8_t length() { return 39; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint16_t C1;
+    uint16_t C2;
+    uint16_t C3;
+    uint16_t C4;
+    uint16_t C5;
+    uint16_t C6;
+    uint16_t C7;
+    uint16_t C8;
+    uint16_t C9;
+    uint16_t C10;
+    uint16_t C11;
+    uint16_t C12;
+    uint16_t C13;
+    uint16_t C14;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&C1, &msg[11], sizeof(C1));
+        memcpy(&C2, &msg[13], sizeof(C2));
+        memcpy(&C3, &msg[15], sizeof(C3));
+        memcpy(&C4, &msg[17], sizeof(C4));
+        memcpy(&C5, &msg[19], sizeof(C5));
+        memcpy(&C6, &msg[21], sizeof(C6));
+        memcpy(&C7, &msg[23], sizeof(C7));
+        memcpy(&C8, &msg[25], sizeof(C8));
+        memcpy(&C9, &msg[27], sizeof(C9));
+        memcpy(&C10, &msg[29], sizeof(C10));
+        memcpy(&C11, &msg[31], sizeof(C11));
+        memcpy(&C12, &msg[33], sizeof(C12));
+        memcpy(&C13, &msg[35], sizeof(C13));
+        memcpy(&C14, &msg[37], sizeof(C14));
+    }
+};
+
+struct RSSI {
+    static const char *name() { return "RSSI"; }
+    static const char *format() { return "Qf"; }
+    static const char *labels() { return "TimeUS,RXRSSI"; }
+    static uint8_t length() { return 15; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float RXRSSI;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&RXRSSI, &msg[11], sizeof(RXRSSI));
+    }
+};
+
+struct BARO {
+    static const char *name() { return "BARO"; }
+    static const char *format() { return "QffcfIffB"; }
+    static const char *labels() { return "TimeUS,Alt,Press,Temp,CRt,SMS,Offset,GndTemp,Health"; }
+    static uint8_t length() { return 38; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float Alt;
+    float Press;
+    int16_t Temp;
+    float CRt;
+    uint32_t SMS;
+    float Offset;
+    float GndTemp;
+    uint8_t Health;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Alt, &msg[11], sizeof(Alt));
+        memcpy(&Press, &msg[15], sizeof(Press));
+        memcpy(&Temp, &msg[19], sizeof(Temp));
+        memcpy(&CRt, &msg[21], sizeof(CRt));
+        memcpy(&SMS, &msg[25], sizeof(SMS));
+        memcpy(&Offset, &msg[29], sizeof(Offset));
+        memcpy(&GndTemp, &msg[33], sizeof(GndTemp));
+        memcpy(&Health, &msg[37], sizeof(Health));
+    }
+};
+
+struct POWR {
+    static const char *name() { return "POWR"; }
+    static const char *format() { return "QffHB"; }
+    static const char *labels() { return "TimeUS,Vcc,VServo,Flags,Safety"; }
+    static uint8_t length() { return 22; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float Vcc;
+    float VServo;
+    uint16_t Flags;
+    uint8_t Safety;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Vcc, &msg[11], sizeof(Vcc));
+        memcpy(&VServo, &msg[15], sizeof(VServo));
+        memcpy(&Flags, &msg[19], sizeof(Flags));
+        memcpy(&Safety, &msg[21], sizeof(Safety));
+    }
+};
+
+struct CMD {
+    static const char *name() { return "CMD"; }
+    static const char *format() { return "QHHHffffLLfB"; }
+    static const char *labels() { return "TimeUS,CTot,CNum,CId,Prm1,Prm2,Prm3,Prm4,Lat,Lng,Alt,Frame"; }
+    static uint8_t length() { return 46; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint16_t CTot;
+    uint16_t CNum;
+    uint16_t CId;
+    float Prm1;
+    float Prm2;
+    float Prm3;
+    float Prm4;
+    int32_t Lat;
+    int32_t Lng;
+    float Alt;
+    uint8_t Frame;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&CTot, &msg[11], sizeof(CTot));
+        memcpy(&CNum, &msg[13], sizeof(CNum));
+        memcpy(&CId, &msg[15], sizeof(CId));
+        memcpy(&Prm1, &msg[17], sizeof(Prm1));
+        memcpy(&Prm2, &msg[21], sizeof(Prm2));
+        memcpy(&Prm3, &msg[25], sizeof(Prm3));
+        memcpy(&Prm4, &msg[29], sizeof(Prm4));
+        memcpy(&Lat, &msg[33], sizeof(Lat));
+        memcpy(&Lng, &msg[37], sizeof(Lng));
+        memcpy(&Alt, &msg[41], sizeof(Alt));
+        memcpy(&Frame, &msg[45], sizeof(Frame));
+    }
+};
+
+struct MAVC {
+    static const char *name() { return "MAVC"; }
+    static const char *format() { return "QBBBHBBffffiifBB"; }
+    static const char *labels() { return "TimeUS,TS,TC,Fr,Cmd,Cur,AC,P1,P2,P3,P4,X,Y,Z,Res,WL"; }
+    static uint8_t length() { return 48; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t TS;
+    uint8_t TC;
+    uint8_t Fr;
+    uint16_t Cmd;
+    uint8_t Cur;
+    uint8_t AC;
+    float P1;
+    float P2;
+    float P3;
+    float P4;
+    int32_t X;
+    int32_t Y;
+    float Z;
+    uint8_t Res;
+    uint8_t WL;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&TS, &msg[11], sizeof(TS));
+        memcpy(&TC, &msg[12], sizeof(TC));
+        memcpy(&Fr, &msg[13], sizeof(Fr));
+        memcpy(&Cmd, &msg[14], sizeof(Cmd));
+        memcpy(&Cur, &msg[16], sizeof(Cur));
+        memcpy(&AC, &msg[17], sizeof(AC));
+        memcpy(&P1, &msg[18], sizeof(P1));
+        memcpy(&P2, &msg[22], sizeof(P2));
+        memcpy(&P3, &msg[26], sizeof(P3));
+        memcpy(&P4, &msg[30], sizeof(P4));
+        memcpy(&X, &msg[34], sizeof(X));
+        memcpy(&Y, &msg[38], sizeof(Y));
+        memcpy(&Z, &msg[42], sizeof(Z));
+        memcpy(&Res, &msg[46], sizeof(Res));
+        memcpy(&WL, &msg[47], sizeof(WL));
+    }
+};
+
+struct RAD {
+    static const char *name() { return "RAD"; }
+    static const char *format() { return "QBBBBBHH"; }
+    static const char *labels() { return "TimeUS,RSSI,RemRSSI,TxBuf,Noise,RemNoise,RxErrors,Fixed"; }
+    static uint8_t length() { return 20; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t RSSI;
+    uint8_t RemRSSI;
+    uint8_t TxBuf;
+    uint8_t Noise;
+    uint8_t RemNoise;
+    uint16_t RxErrors;
+    uint16_t Fixed;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&RSSI, &msg[11], sizeof(RSSI));
+        memcpy(&RemRSSI, &msg[12], sizeof(RemRSSI));
+        memcpy(&TxBuf, &msg[13], sizeof(TxBuf));
+        memcpy(&Noise, &msg[14], sizeof(Noise));
+        memcpy(&RemNoise, &msg[15], sizeof(RemNoise));
+        memcpy(&RxErrors, &msg[16], sizeof(RxErrors));
+        memcpy(&Fixed, &msg[18], sizeof(Fixed));
+    }
+};
+
+struct CAM {
+    static const char *name() { return "CAM"; }
+    static const char *format() { return "QIHLLeeeccC"; }
+    static const char *labels() { return "TimeUS,GPSTime,GPSWeek,Lat,Lng,Alt,RelAlt,GPSAlt,Roll,Pitch,Yaw"; }
+    static uint8_t length() { return 43; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint32_t GPSTime;
+    uint16_t GPSWeek;
+    int32_t Lat;
+    int32_t Lng;
+    int32_t Alt;
+    int32_t RelAlt;
+    int32_t GPSAlt;
+    int16_t Roll;
+    int16_t Pitch;
+    uint16_t Yaw;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&GPSTime, &msg[11], sizeof(GPSTime));
+        memcpy(&GPSWeek, &msg[15], sizeof(GPSWeek));
+        memcpy(&Lat, &msg[17], sizeof(Lat));
+        memcpy(&Lng, &msg[21], sizeof(Lng));
+        memcpy(&Alt, &msg[25], sizeof(Alt));
+        memcpy(&RelAlt, &msg[29], sizeof(RelAlt));
+        memcpy(&GPSAlt, &msg[33], sizeof(GPSAlt));
+        memcpy(&Roll, &msg[37], sizeof(Roll));
+        memcpy(&Pitch, &msg[39], sizeof(Pitch));
+        memcpy(&Yaw, &msg[41], sizeof(Yaw));
+    }
+};
+
+struct TRIG {
+    static const char *name() { return "TRIG"; }
+    static const char *format() { return "QIHLLeeeccC"; }
+    static const char *labels() { return "TimeUS,GPSTime,GPSWeek,Lat,Lng,Alt,RelAlt,GPSAlt,Roll,Pitch,Yaw"; }
+    static uint8_t length() { return 43; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint32_t GPSTime;
+    uint16_t GPSWeek;
+    int32_t Lat;
+    int32_t Lng;
+    int32_t Alt;
+    int32_t RelAlt;
+    int32_t GPSAlt;
+    int16_t Roll;
+    int16_t Pitch;
+    uint16_t Yaw;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&GPSTime, &msg[11], sizeof(GPSTime));
+        memcpy(&GPSWeek, &msg[15], sizeof(GPSWeek));
+        memcpy(&Lat, &msg[17], sizeof(Lat));
+        memcpy(&Lng, &msg[21], sizeof(Lng));
+        memcpy(&Alt, &msg[25], sizeof(Alt));
+        memcpy(&RelAlt, &msg[29], sizeof(RelAlt));
+        memcpy(&GPSAlt, &msg[33], sizeof(GPSAlt));
+        memcpy(&Roll, &msg[37], sizeof(Roll));
+        memcpy(&Pitch, &msg[39], sizeof(Pitch));
+        memcpy(&Yaw, &msg[41], sizeof(Yaw));
+    }
+};
+
+struct ARSP {
+    static const char *name() { return "ARSP"; }
+    static const char *format() { return "QffcffBBfB"; }
+    static const char *labels() { return "TimeUS,Airspeed,DiffPress,Temp,RawPress,Offset,U,Health,Hfp,Pri"; }
+    static uint8_t length() { return 36; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float Airspeed;
+    float DiffPress;
+    int16_t Temp;
+    float RawPress;
+    float Offset;
+    uint8_t U;
+    uint8_t Health;
+    float Hfp;
+    uint8_t Pri;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Airspeed, &msg[11], sizeof(Airspeed));
+        memcpy(&DiffPress, &msg[15], sizeof(DiffPress));
+        memcpy(&Temp, &msg[19], sizeof(Temp));
+        memcpy(&RawPress, &msg[21], sizeof(RawPress));
+        memcpy(&Offset, &msg[25], sizeof(Offset));
+        memcpy(&U, &msg[29], sizeof(U));
+        memcpy(&Health, &msg[30], sizeof(Health));
+        memcpy(&Hfp, &msg[31], sizeof(Hfp));
+        memcpy(&Pri, &msg[35], sizeof(Pri));
+    }
+};
+
+struct ASP2 {
+    static const char *name() { return "ASP2"; }
+    static const char *format() { return "QffcffBBfB"; }
+    static const char *labels() { return "TimeUS,Airspeed,DiffPress,Temp,RawPress,Offset,U,Health,Hfp,Pri"; }
+    static uint8_t length() { return 36; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float Airspeed;
+    float DiffPress;
+    int16_t Temp;
+    float RawPress;
+    float Offset;
+    uint8_t U;
+    uint8_t Health;
+    float Hfp;
+    uint8_t Pri;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Airspeed, &msg[11], sizeof(Airspeed));
+        memcpy(&DiffPress, &msg[15], sizeof(DiffPress));
+        memcpy(&Temp, &msg[19], sizeof(Temp));
+        memcpy(&RawPress, &msg[21], sizeof(RawPress));
+        memcpy(&Offset, &msg[25], sizeof(Offset));
+        memcpy(&U, &msg[29], sizeof(U));
+        memcpy(&Health, &msg[30], sizeof(Health));
+        memcpy(&Hfp, &msg[31], sizeof(Hfp));
+        memcpy(&Pri, &msg[35], sizeof(Pri));
+    }
+};
+
+struct BAT {
+    static const char *name() { return "BAT"; }
+    static const char *format() { return "QBfffffcf"; }
+    static const char *labels() { return "TimeUS,Instance,Volt,VoltR,Curr,CurrTot,EnrgTot,Temp,Res"; }
+    static uint8_t length() { return 38; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Instance;
+    float Volt;
+    float VoltR;
+    float Curr;
+    float CurrTot;
+    float EnrgTot;
+    int16_t Temp;
+    float Res;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Instance, &msg[11], sizeof(Instance));
+        memcpy(&Volt, &msg[12], sizeof(Volt));
+        memcpy(&VoltR, &msg[16], sizeof(VoltR));
+        memcpy(&Curr, &msg[20], sizeof(Curr));
+        memcpy(&CurrTot, &msg[24], sizeof(CurrTot));
+        memcpy(&EnrgTot, &msg[28], sizeof(EnrgTot));
+        memcpy(&Temp, &msg[32], sizeof(Temp));
+        memcpy(&Res, &msg[34], sizeof(Res));
+    }
+};
+
+struct BCL {
+    static const char *name() { return "BCL"; }
+    static const char *format() { return "QBfHHHHHHHHHH"; }
+    static const char *labels() { return "TimeUS,Instance,Volt,V1,V2,V3,V4,V5,V6,V7,V8,V9,V10"; }
+    static uint8_t length() { return 36; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Instance;
+    float Volt;
+    uint16_t V1;
+    uint16_t V2;
+    uint16_t V3;
+    uint16_t V4;
+    uint16_t V5;
+    uint16_t V6;
+    uint16_t V7;
+    uint16_t V8;
+    uint16_t V9;
+    uint16_t V10;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Instance, &msg[11], sizeof(Instance));
+        memcpy(&Volt, &msg[12], sizeof(Volt));
+        memcpy(&V1, &msg[16], sizeof(V1));
+        memcpy(&V2, &msg[18], sizeof(V2));
+        memcpy(&V3, &msg[20], sizeof(V3));
+        memcpy(&V4, &msg[22], sizeof(V4));
+        memcpy(&V5, &msg[24], sizeof(V5));
+        memcpy(&V6, &msg[26], sizeof(V6));
+        memcpy(&V7, &msg[28], sizeof(V7));
+        memcpy(&V8, &msg[30], sizeof(V8));
+        memcpy(&V9, &msg[32], sizeof(V9));
+        memcpy(&V10, &msg[34], sizeof(V10));
+    }
+};
+
+struct ATT {
+    static const char *name() { return "ATT"; }
+    static const char *format() { return "QccccCCCC"; }
+    static const char *labels() { return "TimeUS,DesRoll,Roll,DesPitch,Pitch,DesYaw,Yaw,ErrRP,ErrYaw"; }
+    static uint8_t length() { return 27; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int16_t DesRoll;
+    int16_t Roll;
+    int16_t DesPitch;
+    int16_t Pitch;
+    uint16_t DesYaw;
+    uint16_t Yaw;
+    uint16_t ErrRP;
+    uint16_t ErrYaw;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&DesRoll, &msg[11], sizeof(DesRoll));
+        memcpy(&Roll, &msg[13], sizeof(Roll));
+        memcpy(&DesPitch, &msg[15], sizeof(DesPitch));
+        memcpy(&Pitch, &msg[17], sizeof(Pitch));
+        memcpy(&DesYaw, &msg[19], sizeof(DesYaw));
+        memcpy(&Yaw, &msg[21], sizeof(Yaw));
+        memcpy(&ErrRP, &msg[23], sizeof(ErrRP));
+        memcpy(&ErrYaw, &msg[25], sizeof(ErrYaw));
+    }
+};
+
+struct MAG {
+    static const char *name() { return "MAG"; }
+    static const char *format() { return "QhhhhhhhhhBI"; }
+    static const char *labels() { return "TimeUS,MagX,MagY,MagZ,OfsX,OfsY,OfsZ,MOfsX,MOfsY,MOfsZ,Health,S"; }
+    static uint8_t length() { return 34; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int16_t MagX;
+    int16_t MagY;
+    int16_t MagZ;
+    int16_t OfsX;
+    int16_t OfsY;
+    int16_t OfsZ;
+    int16_t MOfsX;
+    int16_t MOfsY;
+    int16_t MOfsZ;
+    uint8_t Health;
+    uint32_t S;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&MagX, &msg[11], sizeof(MagX));
+        memcpy(&MagY, &msg[13], sizeof(MagY));
+        memcpy(&MagZ, &msg[15], sizeof(MagZ));
+        memcpy(&OfsX, &msg[17], sizeof(OfsX));
+        memcpy(&OfsY, &msg[19], sizeof(OfsY));
+        memcpy(&OfsZ, &msg[21], sizeof(OfsZ));
+        memcpy(&MOfsX, &msg[23], sizeof(MOfsX));
+        memcpy(&MOfsY, &msg[25], sizeof(MOfsY));
+        memcpy(&MOfsZ, &msg[27], sizeof(MOfsZ));
+        memcpy(&Health, &msg[29], sizeof(Health));
+        memcpy(&S, &msg[30], sizeof(S));
+    }
+};
+
+struct MODE {
+    static const char *name() { return "MODE"; }
+    static const char *format() { return "QMBB"; }
+    static const char *labels() { return "TimeUS,Mode,ModeNum,Rsn"; }
+    static uint8_t length() { return 14; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Mode;
+    uint8_t ModeNum;
+    uint8_t Rsn;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Mode, &msg[11], sizeof(Mode));
+        memcpy(&ModeNum, &msg[12], sizeof(ModeNum));
+        memcpy(&Rsn, &msg[13], sizeof(Rsn));
+    }
+};
+
+struct RFND {
+    static const char *name() { return "RFND"; }
+    static const char *format() { return "QBCBB"; }
+    static const char *labels() { return "TimeUS,Instance,Dist,Stat,Orient"; }
+    static uint8_t length() { return 16; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Instance;
+    uint16_t Dist;
+    uint8_t Stat;
+    uint8_t Orient;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Instance, &msg[11], sizeof(Instance));
+        memcpy(&Dist, &msg[12], sizeof(Dist));
+        memcpy(&Stat, &msg[14], sizeof(Stat));
+        memcpy(&Orient, &msg[15], sizeof(Orient));
+    }
+};
+
+struct DMS {
+    static const char *name() { return "DMS"; }
+    static const char *format() { return "QIIIIBBBBBBBBB"; }
+    static const char *labels() { return "TimeUS,N,Dp,RT,RS,Fa,Fmn,Fmx,Pa,Pmn,Pmx,Sa,Smn,Smx"; }
+    static uint8_t length() { return 36; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint32_t N;
+    uint32_t Dp;
+    uint32_t RT;
+    uint32_t RS;
+    uint8_t Fa;
+    uint8_t Fmn;
+    uint8_t Fmx;
+    uint8_t Pa;
+    uint8_t Pmn;
+    uint8_t Pmx;
+    uint8_t Sa;
+    uint8_t Smn;
+    uint8_t Smx;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&N, &msg[11], sizeof(N));
+        memcpy(&Dp, &msg[15], sizeof(Dp));
+        memcpy(&RT, &msg[19], sizeof(RT));
+        memcpy(&RS, &msg[23], sizeof(RS));
+        memcpy(&Fa, &msg[27], sizeof(Fa));
+        memcpy(&Fmn, &msg[28], sizeof(Fmn));
+        memcpy(&Fmx, &msg[29], sizeof(Fmx));
+        memcpy(&Pa, &msg[30], sizeof(Pa));
+        memcpy(&Pmn, &msg[31], sizeof(Pmn));
+        memcpy(&Pmx, &msg[32], sizeof(Pmx));
+        memcpy(&Sa, &msg[33], sizeof(Sa));
+        memcpy(&Smn, &msg[34], sizeof(Smn));
+        memcpy(&Smx, &msg[35], sizeof(Smx));
+    }
+};
+
+struct BCN {
+    static const char *name() { return "BCN"; }
+    static const char *format() { return "QBBfffffff"; }
+    static const char *labels() { return "TimeUS,Health,Cnt,D0,D1,D2,D3,PosX,PosY,PosZ"; }
+    static uint8_t length() { return 41; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Health;
+    uint8_t Cnt;
+    float D0;
+    float D1;
+    float D2;
+    float D3;
+    float PosX;
+    float PosY;
+    float PosZ;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Health, &msg[11], sizeof(Health));
+        memcpy(&Cnt, &msg[12], sizeof(Cnt));
+        memcpy(&D0, &msg[13], sizeof(D0));
+        memcpy(&D1, &msg[17], sizeof(D1));
+        memcpy(&D2, &msg[21], sizeof(D2));
+        memcpy(&D3, &msg[25], sizeof(D3));
+        memcpy(&PosX, &msg[29], sizeof(PosX));
+        memcpy(&PosY, &msg[33], sizeof(PosY));
+        memcpy(&PosZ, &msg[37], sizeof(PosZ));
+    }
+};
+
+struct PRX {
+    static const char *name() { return "PRX"; }
+    static const char *format() { return "QBfffffffffff"; }
+    static const char *labels() { return "TimeUS,Health,D0,D45,D90,D135,D180,D225,D270,D315,DUp,CAn,CDis"; }
+    static uint8_t length() { return 56; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Health;
+    float D0;
+    float D45;
+    float D90;
+    float D135;
+    float D180;
+    float D225;
+    float D270;
+    float D315;
+    float DUp;
+    float CAn;
+    float CDis;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Health, &msg[11], sizeof(Health));
+        memcpy(&D0, &msg[12], sizeof(D0));
+        memcpy(&D45, &msg[16], sizeof(D45));
+        memcpy(&D90, &msg[20], sizeof(D90));
+        memcpy(&D135, &msg[24], sizeof(D135));
+        memcpy(&D180, &msg[28], sizeof(D180));
+        memcpy(&D225, &msg[32], sizeof(D225));
+        memcpy(&D270, &msg[36], sizeof(D270));
+        memcpy(&D315, &msg[40], sizeof(D315));
+        memcpy(&DUp, &msg[44], sizeof(DUp));
+        memcpy(&CAn, &msg[48], sizeof(CAn));
+        memcpy(&CDis, &msg[52], sizeof(CDis));
+    }
+};
+
+struct PM {
+    static const char *name() { return "PM"; }
+    static const char *format() { return "QHHIIHIIIIII"; }
+    static const char *labels() { return "TimeUS,NLon,NLoop,MaxT,Mem,Load,IntE,IntEC,SPIC,I2CC,I2CI,ExUS"; }
+    static uint8_t length() { return 49; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint16_t NLon;
+    uint16_t NLoop;
+    uint32_t MaxT;
+    uint32_t Mem;
+    uint16_t Load;
+    uint32_t IntE;
+    uint32_t IntEC;
+    uint32_t SPIC;
+    uint32_t I2CC;
+    uint32_t I2CI;
+    uint32_t ExUS;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&NLon, &msg[11], sizeof(NLon));
+        memcpy(&NLoop, &msg[13], sizeof(NLoop));
+        memcpy(&MaxT, &msg[15], sizeof(MaxT));
+        memcpy(&Mem, &msg[19], sizeof(Mem));
+        memcpy(&Load, &msg[23], sizeof(Load));
+        memcpy(&IntE, &msg[25], sizeof(IntE));
+        memcpy(&IntEC, &msg[29], sizeof(IntEC));
+        memcpy(&SPIC, &msg[33], sizeof(SPIC));
+        memcpy(&I2CC, &msg[37], sizeof(I2CC));
+        memcpy(&I2CI, &msg[41], sizeof(I2CI));
+        memcpy(&ExUS, &msg[45], sizeof(ExUS));
+    }
+};
+
+struct SLAT {
+    static const char *name() { return "SLAT"; }
+    static const char *format() { return "QII"; }
+    static const char *labels() { return "TimeUS,TLat,TLatM"; }
+    static uint8_t length() { return 19; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint32_t TLat;
+    uint32_t TLatM;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&TLat, &msg[11], sizeof(TLat));
+        memcpy(&TLatM, &msg[15], sizeof(TLatM));
+    }
+};
+
+struct LWC {
+    static const char *name() { return "LWC"; }
+    static const char *format() { return "QII"; }
+    static const char *labels() { return "TimeUS,LRet,LBsy"; }
+    static uint8_t length() { return 19; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint32_t LRet;
+    uint32_t LBsy;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&LRet, &msg[11], sizeof(LRet));
+        memcpy(&LBsy, &msg[15], sizeof(LBsy));
+    }
+};
+
+struct TSCH {
+    static const char *name() { return "TSCH"; }
+    static const char *format() { return "QBNIHHHHII"; }
+    static const char *labels() { return "TimeUS,Id,Name,N,Min,Avg,P99,Max,Slip,Ovr"; }
+    static uint8_t length() { return 48; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Id;
+    char Name[16];
+    uint32_t N;
+    uint16_t Min;
+    uint16_t Avg;
+    uint16_t P99;
+    uint16_t Max;
+    uint32_t Slip;
+    uint32_t Ovr;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Id, &msg[11], sizeof(Id));
+        memcpy(&Name, &msg[12], sizeof(Name));
+        memcpy(&N, &msg[28], sizeof(N));
+        memcpy(&Min, &msg[32], sizeof(Min));
+        memcpy(&Avg, &msg[34], sizeof(Avg));
+        memcpy(&P99, &msg[36], sizeof(P99));
+        memcpy(&Max, &msg[38], sizeof(Max));
+        memcpy(&Slip, &msg[40], sizeof(Slip));
+        memcpy(&Ovr, &msg[44], sizeof(Ovr));
+    }
+};
+
+struct SRTL {
+    static const char *name() { return "SRTL"; }
+    static const char *format() { return "QBHHBfff"; }
+    static const char *labels() { return "TimeUS,Active,NumPts,MaxPts,Action,N,E,D"; }
+    static uint8_t length() { return 29; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Active;
+    uint16_t NumPts;
+    uint16_t MaxPts;
+    uint8_t Action;
+    float N;
+    float E;
+    float D;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Active, &msg[11], sizeof(Active));
+        memcpy(&NumPts, &msg[12], sizeof(NumPts));
+        memcpy(&MaxPts, &msg[14], sizeof(MaxPts));
+        memcpy(&Action, &msg[16], sizeof(Action));
+        memcpy(&N, &msg[17], sizeof(N));
+        memcpy(&E, &msg[21], sizeof(E));
+        memcpy(&D, &msg[25], sizeof(D));
+    }
+};
+
+struct OABR {
+    static const char *name() { return "OABR"; }
+    static const char *format() { return "QBHHfLLLL"; }
+    static const char *labels() { return "TimeUS,Active,DesYaw,Yaw,Mar,DLat,DLng,OALat,OALng"; }
+    static uint8_t length() { return 36; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Active;
+    uint16_t DesYaw;
+    uint16_t Yaw;
+    float Mar;
+    int32_t DLat;
+    int32_t DLng;
+    int32_t OALat;
+    int32_t OALng;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Active, &msg[11], sizeof(Active));
+        memcpy(&DesYaw, &msg[12], sizeof(DesYaw));
+        memcpy(&Yaw, &msg[14], sizeof(Yaw));
+        memcpy(&Mar, &msg[16], sizeof(Mar));
+        memcpy(&DLat, &msg[20], sizeof(DLat));
+        memcpy(&DLng, &msg[24], sizeof(DLng));
+        memcpy(&OALat, &msg[28], sizeof(OALat));
+        memcpy(&OALng, &msg[32], sizeof(OALng));
+    }
+};
+
+struct OADJ {
+    static const char *name() { return "OADJ"; }
+    static const char *format() { return "QBBBBLLLL"; }
+    static const char *labels() { return "TimeUS,State,Err,CurrPoint,TotPoints,DLat,DLng,OALat,OALng"; }
+    static uint8_t length() { return 31; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t State;
+    uint8_t Err;
+    uint8_t CurrPoint;
+    uint8_t TotPoints;
+    int32_t DLat;
+    int32_t DLng;
+    int32_t OALat;
+    int32_t OALng;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&State, &msg[11], sizeof(State));
+        memcpy(&Err, &msg[12], sizeof(Err));
+        memcpy(&CurrPoint, &msg[13], sizeof(CurrPoint));
+        memcpy(&TotPoints, &msg[14], sizeof(TotPoints));
+        memcpy(&DLat, &msg[15], sizeof(DLat));
+        memcpy(&DLng, &msg[19], sizeof(DLng));
+        memcpy(&OALat, &msg[23], sizeof(OALat));
+        memcpy(&OALng, &msg[27], sizeof(OALng));
+    }
+};
+
+struct IMU2 {
+    static const char *name() { return "IMU2"; }
+    static const char *format() { return "QffffffIIfBBHH"; }
+    static const char *labels() { return "TimeUS,GyrX,GyrY,GyrZ,AccX,AccY,AccZ,EG,EA,T,GH,AH,GHz,AHz"; }
+    static uint8_t length() { return 53; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float GyrX;
+    float GyrY;
+    float GyrZ;
+    float AccX;
+    float AccY;
+    float AccZ;
+    uint32_t EG;
+    uint32_t EA;
+    float T;
+    uint8_t GH;
+    uint8_t AH;
+    uint16_t GHz;
+    uint16_t AHz;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&GyrX, &msg[11], sizeof(GyrX));
+        memcpy(&GyrY, &msg[15], sizeof(GyrY));
+        memcpy(&GyrZ, &msg[19], sizeof(GyrZ));
+        memcpy(&AccX, &msg[23], sizeof(AccX));
+        memcpy(&AccY, &msg[27], sizeof(AccY));
+        memcpy(&AccZ, &msg[31], sizeof(AccZ));
+        memcpy(&EG, &msg[35], sizeof(EG));
+        memcpy(&EA, &msg[39], sizeof(EA));
+        memcpy(&T, &msg[43], sizeof(T));
+        memcpy(&GH, &msg[47], sizeof(GH));
+        memcpy(&AH, &msg[48], sizeof(AH));
+        memcpy(&GHz, &msg[49], sizeof(GHz));
+        memcpy(&AHz, &msg[51], sizeof(AHz));
+    }
+};
+
+struct IMU3 {
+    static const char *name() { return "IMU3"; }
+    static const char *format() { return "QffffffIIfBBHH"; }
+    static const char *labels() { return "TimeUS,GyrX,GyrY,GyrZ,AccX,AccY,AccZ,EG,EA,T,GH,AH,GHz,AHz"; }
+    static uint8_t length() { return 53; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float GyrX;
+    float GyrY;
+    float GyrZ;
+    float AccX;
+    float AccY;
+    float AccZ;
+    uint32_t EG;
+    uint32_t EA;
+    float T;
+    uint8_t GH;
+    uint8_t AH;
+    uint16_t GHz;
+    uint16_t AHz;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&GyrX, &msg[11], sizeof(GyrX));
+        memcpy(&GyrY, &msg[15], sizeof(GyrY));
+        memcpy(&GyrZ, &msg[19], sizeof(GyrZ));
+        memcpy(&AccX, &msg[23], sizeof(AccX));
+        memcpy(&AccY, &msg[27], sizeof(AccY));
+        memcpy(&AccZ, &msg[31], sizeof(AccZ));
+        memcpy(&EG, &msg[35], sizeof(EG));
+        memcpy(&EA, &msg[39], sizeof(EA));
+        memcpy(&T, &msg[43], sizeof(T));
+        memcpy(&GH, &msg[47], sizeof(GH));
+        memcpy(&AH, &msg[48], sizeof(AH));
+        memcpy(&GHz, &msg[49], sizeof(GHz));
+        memcpy(&AHz, &msg[51], sizeof(AHz));
+    }
+};
+
+struct AHR2 {
+    static const char *name() { return "AHR2"; }
+    static const char *format() { return "QccCfLLffff"; }
+    static const char *labels() { return "TimeUS,Roll,Pitch,Yaw,Alt,Lat,Lng,Q1,Q2,Q3,Q4"; }
+    static uint8_t length() { return 45; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int16_t Roll;
+    int16_t Pitch;
+    uint16_t Yaw;
+    float Alt;
+    int32_t Lat;
+    int32_t Lng;
+    float Q1;
+    float Q2;
+    float Q3;
+    float Q4;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Roll, &msg[11], sizeof(Roll));
+        memcpy(&Pitch, &msg[13], sizeof(Pitch));
+        memcpy(&Yaw, &msg[15], sizeof(Yaw));
+        memcpy(&Alt, &msg[17], sizeof(Alt));
+        memcpy(&Lat, &msg[21], sizeof(Lat));
+        memcpy(&Lng, &msg[25], sizeof(Lng));
+        memcpy(&Q1, &msg[29], sizeof(Q1));
+        memcpy(&Q2, &msg[33], sizeof(Q2));
+        memcpy(&Q3, &msg[37], sizeof(Q3));
+        memcpy(&Q4, &msg[41], sizeof(Q4));
+    }
+};
+
+struct POS {
+    static const char *name() { return "POS"; }
+    static const char *format() { return "QLLfff"; }
+    static const char *labels() { return "TimeUS,Lat,Lng,Alt,RelHomeAlt,RelOriginAlt"; }
+    static uint8_t length() { return 31; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int32_t Lat;
+    int32_t Lng;
+    float Alt;
+    float RelHomeAlt;
+    float RelOriginAlt;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Lat, &msg[11], sizeof(Lat));
+        memcpy(&Lng, &msg[15], sizeof(Lng));
+        memcpy(&Alt, &msg[19], sizeof(Alt));
+        memcpy(&RelHomeAlt, &msg[23], sizeof(RelHomeAlt));
+        memcpy(&RelOriginAlt, &msg[27], sizeof(RelOriginAlt));
+    }
+};
+
+struct SIM {
+    static const char *name() { return "SIM"; }
+    static const char *format() { return "QccCfLLffff"; }
+    static const char *labels() { return "TimeUS,Roll,Pitch,Yaw,Alt,Lat,Lng,Q1,Q2,Q3,Q4"; }
+    static uint8_t length() { return 45; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int16_t Roll;
+    int16_t Pitch;
+    uint16_t Yaw;
+    float Alt;
+    int32_t Lat;
+    int32_t Lng;
+    float Q1;
+    float Q2;
+    float Q3;
+    float Q4;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Roll, &msg[11], sizeof(Roll));
+        memcpy(&Pitch, &msg[13], sizeof(Pitch));
+        memcpy(&Yaw, &msg[15], sizeof(Yaw));
+        memcpy(&Alt, &msg[17], sizeof(Alt));
+        memcpy(&Lat, &msg[21], sizeof(Lat));
+        memcpy(&Lng, &msg[25], sizeof(Lng));
+        memcpy(&Q1, &msg[29], sizeof(Q1));
+        memcpy(&Q2, &msg[33], sizeof(Q2));
+        memcpy(&Q3, &msg[37], sizeof(Q3));
+        memcpy(&Q4, &msg[41], sizeof(Q4));
+    }
+};
+
+struct NKF1 {
+    static const char *name() { return "NKF1"; }
+    static const char *format() { return "QBccCfffffffccce"; }
+    static const char *labels() { return "TimeUS,C,Roll,Pitch,Yaw,VN,VE,VD,dPD,PN,PE,PD,GX,GY,GZ,OH"; }
+    static uint8_t length() { return 56; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t C;
+    int16_t Roll;
+    int16_t Pitch;
+    uint16_t Yaw;
+    float VN;
+    float VE;
+    float VD;
+    float dPD;
+    float PN;
+    float PE;
+    float PD;
+    int16_t GX;
+    int16_t GY;
+    int16_t GZ;
+    int32_t OH;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&C, &msg[11], sizeof(C));
+        memcpy(&Roll, &msg[12], sizeof(Roll));
+        memcpy(&Pitch, &msg[14], sizeof(Pitch));
+        memcpy(&Yaw, &msg[16], sizeof(Yaw));
+        memcpy(&VN, &msg[18], sizeof(VN));
+        memcpy(&VE, &msg[22], sizeof(VE));
+        memcpy(&VD, &msg[26], sizeof(VD));
+        memcpy(&dPD, &msg[30], sizeof(dPD));
+        memcpy(&PN, &msg[34], sizeof(PN));
+        memcpy(&PE, &msg[38], sizeof(PE));
+        memcpy(&PD, &msg[42], sizeof(PD));
+        memcpy(&GX, &msg[46], sizeof(GX));
+        memcpy(&GY, &msg[48], sizeof(GY));
+        memcpy(&GZ, &msg[50], sizeof(GZ));
+        memcpy(&OH, &msg[52], sizeof(OH));
+    }
+};
+
+struct NKF2 {
+    static const char *name() { return "NKF2"; }
+    static const char *format() { return "QBbccccchhhhhhB"; }
+    static const char *labels() { return "TimeUS,C,AZbias,GSX,GSY,GSZ,VWN,VWE,MN,ME,MD,MX,MY,MZ,MI"; }
+    static uint8_t length() { return 36; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t C;
+    int8_t AZbias;
+    int16_t GSX;
+    int16_t GSY;
+    int16_t GSZ;
+    int16_t VWN;
+    int16_t VWE;
+    int16_t MN;
+    int16_t ME;
+    int16_t MD;
+    int16_t MX;
+    int16_t MY;
+    int16_t MZ;
+    uint8_t MI;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&C, &msg[11], sizeof(C));
+        memcpy(&AZbias, &msg[12], sizeof(AZbias));
+        memcpy(&GSX, &msg[13], sizeof(GSX));
+        memcpy(&GSY, &msg[15], sizeof(GSY));
+        memcpy(&GSZ, &msg[17], sizeof(GSZ));
+        memcpy(&VWN, &msg[19], sizeof(VWN));
+        memcpy(&VWE, &msg[21], sizeof(VWE));
+        memcpy(&MN, &msg[23], sizeof(MN));
+        memcpy(&ME, &msg[25], sizeof(ME));
+        memcpy(&MD, &msg[27], sizeof(MD));
+        memcpy(&MX, &msg[29], sizeof(MX));
+        memcpy(&MY, &msg[31], sizeof(MY));
+        memcpy(&MZ, &msg[33], sizeof(MZ));
+        memcpy(&MI, &msg[35], sizeof(MI));
+    }
+};
+
+struct NKF3 {
+    static const char *name() { return "NKF3"; }
+    static const char *format() { return "QBcccccchhhcc"; }
+    static const char *labels() { return "TimeUS,C,IVN,IVE,IVD,IPN,IPE,IPD,IMX,IMY,IMZ,IYAW,IVT"; }
+    static uint8_t length() { return 34; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t C;
+    int16_t IVN;
+    int16_t IVE;
+    int16_t IVD;
+    int16_t IPN;
+    int16_t IPE;
+    int16_t IPD;
+    int16_t IMX;
+    int16_t IMY;
+    int16_t IMZ;
+    int16_t IYAW;
+    int16_t IVT;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&C, &msg[11], sizeof(C));
+        memcpy(&IVN, &msg[12], sizeof(IVN));
+        memcpy(&IVE, &msg[14], sizeof(IVE));
+        memcpy(&IVD, &msg[16], sizeof(IVD));
+        memcpy(&IPN, &msg[18], sizeof(IPN));
+        memcpy(&IPE, &msg[20], sizeof(IPE));
+        memcpy(&IPD, &msg[22], sizeof(IPD));
+        memcpy(&IMX, &msg[24], sizeof(IMX));
+        memcpy(&IMY, &msg[26], sizeof(IMY));
+        memcpy(&IMZ, &msg[28], sizeof(IMZ));
+        memcpy(&IYAW, &msg[30], sizeof(IYAW));
+        memcpy(&IVT, &msg[32], sizeof(IVT));
+    }
+};
+
+struct NKF4 {
+    static const char *name() { return "NKF4"; }
+    static const char *format() { return "QBcccccfbbHBIHb"; }
+    static const char *labels() { return "TimeUS,C,SV,SP,SH,SM,SVT,errRP,OFN,OFE,FS,TS,SS,GPS,PI"; }
+    static uint8_t length() { return 38; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t C;
+    int16_t SV;
+    int16_t SP;
+    int16_t SH;
+    int16_t SM;
+    int16_t SVT;
+    float errRP;
+    int8_t OFN;
+    int8_t OFE;
+    uint16_t FS;
+    uint8_t TS;
+    uint32_t SS;
+    uint16_t GPS;
+    int8_t PI;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&C, &msg[11], sizeof(C));
+        memcpy(&SV, &msg[12], sizeof(SV));
+        memcpy(&SP, &msg[14], sizeof(SP));
+        memcpy(&SH, &msg[16], sizeof(SH));
+        memcpy(&SM, &msg[18], sizeof(SM));
+        memcpy(&SVT, &msg[20], sizeof(SVT));
+        memcpy(&errRP, &msg[22], sizeof(errRP));
+        memcpy(&OFN, &msg[26], sizeof(OFN));
+        memcpy(&OFE, &msg[27], sizeof(OFE));
+        memcpy(&FS, &msg[28], sizeof(FS));
+        memcpy(&TS, &msg[30], sizeof(TS));
+        memcpy(&SS, &msg[31], sizeof(SS));
+        memcpy(&GPS, &msg[35], sizeof(GPS));
+        memcpy(&PI, &msg[37], sizeof(PI));
+    }
+};
+
+struct NKF5 {
+    static const char *name() { return "NKF5"; }
+    static const char *format() { return "QBhhhcccCCfff"; }
+    static const char *labels() { return "TimeUS,NI,FIX,FIY,AFI,HAGL,offset,RI,rng,Herr,eAng,eVel,ePos"; }
+    static uint8_t length() { return 40; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t NI;
+    int16_t FIX;
+    int16_t FIY;
+    int16_t AFI;
+    int16_t HAGL;
+    int16_t offset;
+    int16_t RI;
+    uint16_t rng;
+    uint16_t Herr;
+    float eAng;
+    float eVel;
+    float ePos;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&NI, &msg[11], sizeof(NI));
+        memcpy(&FIX, &msg[12], sizeof(FIX));
+        memcpy(&FIY, &msg[14], sizeof(FIY));
+        memcpy(&AFI, &msg[16], sizeof(AFI));
+        memcpy(&HAGL, &msg[18], sizeof(HAGL));
+        memcpy(&offset, &msg[20], sizeof(offset));
+        memcpy(&RI, &msg[22], sizeof(RI));
+        memcpy(&rng, &msg[24], sizeof(rng));
+        memcpy(&Herr, &msg[26], sizeof(Herr));
+        memcpy(&eAng, &msg[28], sizeof(eAng));
+        memcpy(&eVel, &msg[32], sizeof(eVel));
+        memcpy(&ePos, &msg[36], sizeof(ePos));
+    }
+};
+
+struct NKF0 {
+    static const char *name() { return "NKF0"; }
+    static const char *format() { return "QBccCCcccccccc"; }
+    static const char *labels() { return "TimeUS,ID,rng,innov,SIV,TR,BPN,BPE,BPD,OFH,OFL,OFN,OFE,OFD"; }
+    static uint8_t length() { return 36; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t ID;
+    int16_t rng;
+    int16_t innov;
+    uint16_t SIV;
+    uint16_t TR;
+    int16_t BPN;
+    int16_t BPE;
+    int16_t BPD;
+    int16_t OFH;
+    int16_t OFL;
+    int16_t OFN;
+    int16_t OFE;
+    int16_t OFD;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&ID, &msg[11], sizeof(ID));
+        memcpy(&rng, &msg[12], sizeof(rng));
+        memcpy(&innov, &msg[14], sizeof(innov));
+        memcpy(&SIV, &msg[16], sizeof(SIV));
+        memcpy(&TR, &msg[18], sizeof(TR));
+        memcpy(&BPN, &msg[20], sizeof(BPN));
+        memcpy(&BPE, &msg[22], sizeof(BPE));
+        memcpy(&BPD, &msg[24], sizeof(BPD));
+        memcpy(&OFH, &msg[26], sizeof(OFH));
+        memcpy(&OFL, &msg[28], sizeof(OFL));
+        memcpy(&OFN, &msg[30], sizeof(OFN));
+        memcpy(&OFE, &msg[32], sizeof(OFE));
+        memcpy(&OFD, &msg[34], sizeof(OFD));
+    }
+};
+
+struct NKQ {
+    static const char *name() { return "NKQ"; }
+    static const char *format() { return "QBffff"; }
+    static const char *labels() { return "TimeUS,C,Q1,Q2,Q3,Q4"; }
+    static uint8_t length() { return 28; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t C;
+    float Q1;
+    float Q2;
+    float Q3;
+    float Q4;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&C, &msg[11], sizeof(C));
+        memcpy(&Q1, &msg[12], sizeof(Q1));
+        memcpy(&Q2, &msg[16], sizeof(Q2));
+        memcpy(&Q3, &msg[20], sizeof(Q3));
+        memcpy(&Q4, &msg[24], sizeof(Q4));
+    }
+};
+
+struct XKF1 {
+    static const char *name() { return "XKF1"; }
+    static const char *format() { return "QBccCfffffffccce"; }
+    static const char *labels() { return "TimeUS,C,Roll,Pitch,Yaw,VN,VE,VD,dPD,PN,PE,PD,GX,GY,GZ,OH"; }
+    static uint8_t length() { return 56; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t C;
+    int16_t Roll;
+    int16_t Pitch;
+    uint16_t Yaw;
+    float VN;
+    float VE;
+    float VD;
+    float dPD;
+    float PN;
+    float PE;
+    float PD;
+    int16_t GX;
+    int16_t GY;
+    int16_t GZ;
+    int32_t OH;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&C, &msg[11], sizeof(C));
+        memcpy(&Roll, &msg[12], sizeof(Roll));
+        memcpy(&Pitch, &msg[14], sizeof(Pitch));
+        memcpy(&Yaw, &msg[16], sizeof(Yaw));
+        memcpy(&VN, &msg[18], sizeof(VN));
+        memcpy(&VE, &msg[22], sizeof(VE));
+        memcpy(&VD, &msg[26], sizeof(VD));
+        memcpy(&dPD, &msg[30], sizeof(dPD));
+        memcpy(&PN, &msg[34], sizeof(PN));
+        memcpy(&PE, &msg[38], sizeof(PE));
+        memcpy(&PD, &msg[42], sizeof(PD));
+        memcpy(&GX, &msg[46], sizeof(GX));
+        memcpy(&GY, &msg[48], sizeof(GY));
+        memcpy(&GZ, &msg[50], sizeof(GZ));
+        memcpy(&OH, &msg[52], sizeof(OH));
+    }
+};
+
+struct XKF2 {
+    static const char *name() { return "XKF2"; }
+    static const char *format() { return "QBccccchhhhhhB"; }
+    static const char *labels() { return "TimeUS,C,AX,AY,AZ,VWN,VWE,MN,ME,MD,MX,MY,MZ,MI"; }
+    static uint8_t length() { return 35; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t C;
+    int16_t AX;
+    int16_t AY;
+    int16_t AZ;
+    int16_t VWN;
+    int16_t VWE;
+    int16_t MN;
+    int16_t ME;
+    int16_t MD;
+    int16_t MX;
+    int16_t MY;
+    int16_t MZ;
+    uint8_t MI;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&C, &msg[11], sizeof(C));
+        memcpy(&AX, &msg[12], sizeof(AX));
+        memcpy(&AY, &msg[14], sizeof(AY));
+        memcpy(&AZ, &msg[16], sizeof(AZ));
+        memcpy(&VWN, &msg[18], sizeof(VWN));
+        memcpy(&VWE, &msg[20], sizeof(VWE));
+        memcpy(&MN, &msg[22], sizeof(MN));
+        memcpy(&ME, &msg[24], sizeof(ME));
+        memcpy(&MD, &msg[26], sizeof(MD));
+        memcpy(&MX, &msg[28], sizeof(MX));
+        memcpy(&MY, &msg[30], sizeof(MY));
+        memcpy(&MZ, &msg[32], sizeof(MZ));
+        memcpy(&MI, &msg[34], sizeof(MI));
+    }
+};
+
+struct XKF3 {
+    static const char *name() { return "XKF3"; }
+    static const char *format() { return "QBcccccchhhcc"; }
+    static const char *labels() { return "TimeUS,C,IVN,IVE,IVD,IPN,IPE,IPD,IMX,IMY,IMZ,IYAW,IVT"; }
+    static uint8_t length() { return 34; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t C;
+    int16_t IVN;
+    int16_t IVE;
+    int16_t IVD;
+    int16_t IPN;
+    int16_t IPE;
+    int16_t IPD;
+    int16_t IMX;
+    int16_t IMY;
+    int16_t IMZ;
+    int16_t IYAW;
+    int16_t IVT;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&C, &msg[11], sizeof(C));
+        memcpy(&IVN, &msg[12], sizeof(IVN));
+        memcpy(&IVE, &msg[14], sizeof(IVE));
+        memcpy(&IVD, &msg[16], sizeof(IVD));
+        memcpy(&IPN, &msg[18], sizeof(IPN));
+        memcpy(&IPE, &msg[20], sizeof(IPE));
+        memcpy(&IPD, &msg[22], sizeof(IPD));
+        memcpy(&IMX, &msg[24], sizeof(IMX));
+        memcpy(&IMY, &msg[26], sizeof(IMY));
+        memcpy(&IMZ, &msg[28], sizeof(IMZ));
+        memcpy(&IYAW, &msg[30], sizeof(IYAW));
+        memcpy(&IVT, &msg[32], sizeof(IVT));
+    }
+};
+
+struct XKF4 {
+    static const char *name() { return "XKF4"; }
+    static const char *format() { return "QBcccccfbbHBIHb"; }
+    static const char *labels() { return "TimeUS,C,SV,SP,SH,SM,SVT,errRP,OFN,OFE,FS,TS,SS,GPS,PI"; }
+    static uint8_t length() { return 38; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t C;
+    int16_t SV;
+    int16_t SP;
+    int16_t SH;
+    int16_t SM;
+    int16_t SVT;
+    float errRP;
+    int8_t OFN;
+    int8_t OFE;
+    uint16_t FS;
+    uint8_t TS;
+    uint32_t SS;
+    uint16_t GPS;
+    int8_t PI;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&C, &msg[11], sizeof(C));
+        memcpy(&SV, &msg[12], sizeof(SV));
+        memcpy(&SP, &msg[14], sizeof(SP));
+        memcpy(&SH, &msg[16], sizeof(SH));
+        memcpy(&SM, &msg[18], sizeof(SM));
+        memcpy(&SVT, &msg[20], sizeof(SVT));
+        memcpy(&errRP, &msg[22], sizeof(errRP));
+        memcpy(&OFN, &msg[26], sizeof(OFN));
+        memcpy(&OFE, &msg[27], sizeof(OFE));
+        memcpy(&FS, &msg[28], sizeof(FS));
+        memcpy(&TS, &msg[30], sizeof(TS));
+        memcpy(&SS, &msg[31], sizeof(SS));
+        memcpy(&GPS, &msg[35], sizeof(GPS));
+        memcpy(&PI, &msg[37], sizeof(PI));
+    }
+};
+
+struct XKF5 {
+    static const char *name() { return "XKF5"; }
+    static const char *format() { return "QBhhhcccCCfff"; }
+    static const char *labels() { return "TimeUS,NI,FIX,FIY,AFI,HAGL,offset,RI,rng,Herr,eAng,eVel,ePos"; }
+    static uint8_t length() { return 40; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t NI;
+    int16_t FIX;
+    int16_t FIY;
+    int16_t AFI;
+    int16_t HAGL;
+    int16_t offset;
+    int16_t RI;
+    uint16_t rng;
+    uint16_t Herr;
+    float eAng;
+    float eVel;
+    float ePos;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&NI, &msg[11], sizeof(NI));
+        memcpy(&FIX, &msg[12], sizeof(FIX));
+        memcpy(&FIY, &msg[14], sizeof(FIY));
+        memcpy(&AFI, &msg[16], sizeof(AFI));
+        memcpy(&HAGL, &msg[18], sizeof(HAGL));
+        memcpy(&offset, &msg[20], sizeof(offset));
+        memcpy(&RI, &msg[22], sizeof(RI));
+        memcpy(&rng, &msg[24], sizeof(rng));
+        memcpy(&Herr, &msg[26], sizeof(Herr));
+        memcpy(&eAng, &msg[28], sizeof(eAng));
+        memcpy(&eVel, &msg[32], sizeof(eVel));
+        memcpy(&ePos, &msg[36], sizeof(ePos));
+    }
+};
+
+struct XKF0 {
+    static const char *name() { return "XKF0"; }
+    static const char *format() { return "QBccCCcccccccc"; }
+    static const char *labels() { return "TimeUS,ID,rng,innov,SIV,TR,BPN,BPE,BPD,OFH,OFL,OFN,OFE,OFD"; }
+    static uint8_t length() { return 36; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t ID;
+    int16_t rng;
+    int16_t innov;
+    uint16_t SIV;
+    uint16_t TR;
+    int16_t BPN;
+    int16_t BPE;
+    int16_t BPD;
+    int16_t OFH;
+    int16_t OFL;
+    int16_t OFN;
+    int16_t OFE;
+    int16_t OFD;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&ID, &msg[11], sizeof(ID));
+        memcpy(&rng, &msg[12], sizeof(rng));
+        memcpy(&innov, &msg[14], sizeof(innov));
+        memcpy(&SIV, &msg[16], sizeof(SIV));
+        memcpy(&TR, &msg[18], sizeof(TR));
+        memcpy(&BPN, &msg[20], sizeof(BPN));
+        memcpy(&BPE, &msg[22], sizeof(BPE));
+        memcpy(&BPD, &msg[24], sizeof(BPD));
+        memcpy(&OFH, &msg[26], sizeof(OFH));
+        memcpy(&OFL, &msg[28], sizeof(OFL));
+        memcpy(&OFN, &msg[30], sizeof(OFN));
+        memcpy(&OFE, &msg[32], sizeof(OFE));
+        memcpy(&OFD, &msg[34], sizeof(OFD));
+    }
+};
+
+struct XKQ {
+    static const char *name() { return "XKQ"; }
+    static const char *format() { return "QBffff"; }
+    static const char *labels() { return "TimeUS,C,Q1,Q2,Q3,Q4"; }
+    static uint8_t length() { return 28; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t C;
+    float Q1;
+    float Q2;
+    float Q3;
+    float Q4;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&C, &msg[11], sizeof(C));
+        memcpy(&Q1, &msg[12], sizeof(Q1));
+        memcpy(&Q2, &msg[16], sizeof(Q2));
+        memcpy(&Q3, &msg[20], sizeof(Q3));
+        memcpy(&Q4, &msg[24], sizeof(Q4));
+    }
+};
+
+struct XKFD {
+    static const char *name() { return "XKFD"; }
+    static const char *format() { return "Qffffff"; }
+    static const char *labels() { return "TimeUS,IX,IY,IZ,IVX,IVY,IVZ"; }
+    static uint8_t length() { return 35; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float IX;
+    float IY;
+    float IZ;
+    float IVX;
+    float IVY;
+    float IVZ;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&IX, &msg[11], sizeof(IX));
+        memcpy(&IY, &msg[15], sizeof(IY));
+        memcpy(&IZ, &msg[19], sizeof(IZ));
+        memcpy(&IVX, &msg[23], sizeof(IVX));
+        memcpy(&IVY, &msg[27], sizeof(IVY));
+        memcpy(&IVZ, &msg[31], sizeof(IVZ));
+    }
+};
+
+struct XKV1 {
+    static const char *name() { return "XKV1"; }
+    static const char *format() { return "Qffffffffffff"; }
+    static const char *labels() { return "TimeUS,V00,V01,V02,V03,V04,V05,V06,V07,V08,V09,V10,V11"; }
+    static uint8_t length() { return 59; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float V00;
+    float V01;
+    float V02;
+    float V03;
+    float V04;
+    float V05;
+    float V06;
+    float V07;
+    float V08;
+    float V09;
+    float V10;
+    float V11;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&V00, &msg[11], sizeof(V00));
+        memcpy(&V01, &msg[15], sizeof(V01));
+        memcpy(&V02, &msg[19], sizeof(V02));
+        memcpy(&V03, &msg[23], sizeof(V03));
+        memcpy(&V04, &msg[27], sizeof(V04));
+        memcpy(&V05, &msg[31], sizeof(V05));
+        memcpy(&V06, &msg[35], sizeof(V06));
+        memcpy(&V07, &msg[39], sizeof(V07));
+        memcpy(&V08, &msg[43], sizeof(V08));
+        memcpy(&V09, &msg[47], sizeof(V09));
+        memcpy(&V10, &msg[51], sizeof(V10));
+        memcpy(&V11, &msg[55], sizeof(V11));
+    }
+};
+
+struct XKV2 {
+    static const char *name() { return "XKV2"; }
+    static const char *format() { return "Qffffffffffff"; }
+    static const char *labels() { return "TimeUS,V12,V13,V14,V15,V16,V17,V18,V19,V20,V21,V22,V23"; }
+    static uint8_t length() { return 59; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float V12;
+    float V13;
+    float V14;
+    float V15;
+    float V16;
+    float V17;
+    float V18;
+    float V19;
+    float V20;
+    float V21;
+    float V22;
+    float V23;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&V12, &msg[11], sizeof(V12));
+        memcpy(&V13, &msg[15], sizeof(V13));
+        memcpy(&V14, &msg[19], sizeof(V14));
+        memcpy(&V15, &msg[23], sizeof(V15));
+        memcpy(&V16, &msg[27], sizeof(V16));
+        memcpy(&V17, &msg[31], sizeof(V17));
+        memcpy(&V18, &msg[35], sizeof(V18));
+        memcpy(&V19, &msg[39], sizeof(V19));
+        memcpy(&V20, &msg[43], sizeof(V20));
+        memcpy(&V21, &msg[47], sizeof(V21));
+        memcpy(&V22, &msg[51], sizeof(V22));
+        memcpy(&V23, &msg[55], sizeof(V23));
+    }
+};
+
+struct TERR {
+    static const char *name() { return "TERR"; }
+    static const char *format() { return "QBLLHffHH"; }
+    static const char *labels() { return "TimeUS,Status,Lat,Lng,Spacing,TerrH,CHeight,Pending,Loaded"; }
+    static uint8_t length() { return 34; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Status;
+    int32_t Lat;
+    int32_t Lng;
+    uint16_t Spacing;
+    float TerrH;
+    float CHeight;
+    uint16_t Pending;
+    uint16_t Loaded;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Status, &msg[11], sizeof(Status));
+        memcpy(&Lat, &msg[12], sizeof(Lat));
+        memcpy(&Lng, &msg[16], sizeof(Lng));
+        memcpy(&Spacing, &msg[20], sizeof(Spacing));
+        memcpy(&TerrH, &msg[22], sizeof(TerrH));
+        memcpy(&CHeight, &msg[26], sizeof(CHeight));
+        memcpy(&Pending, &msg[30], sizeof(Pending));
+        memcpy(&Loaded, &msg[32], sizeof(Loaded));
+    }
+};
+
+struct UBX1 {
+    static const char *name() { return "UBX1"; }
+    static const char *format() { return "QBHBBHI"; }
+    static const char *labels() { return "TimeUS,Instance,noisePerMS,jamInd,aPower,agcCnt,config"; }
+    static uint8_t length() { return 22; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Instance;
+    uint16_t noisePerMS;
+    uint8_t jamInd;
+    uint8_t aPower;
+    uint16_t agcCnt;
+    uint32_t config;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Instance, &msg[11], sizeof(Instance));
+        memcpy(&noisePerMS, &msg[12], sizeof(noisePerMS));
+        memcpy(&jamInd, &msg[14], sizeof(jamInd));
+        memcpy(&aPower, &msg[15], sizeof(aPower));
+        memcpy(&agcCnt, &msg[16], sizeof(agcCnt));
+        memcpy(&config, &msg[18], sizeof(config));
+    }
+};
+
+struct UBX2 {
+    static const char *name() { return "UBX2"; }
+    static const char *format() { return "QBbBbB"; }
+    static const char *labels() { return "TimeUS,Instance,ofsI,magI,ofsQ,magQ"; }
+    static uint8_t length() { return 16; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Instance;
+    int8_t ofsI;
+    uint8_t magI;
+    int8_t ofsQ;
+    uint8_t magQ;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Instance, &msg[11], sizeof(Instance));
+        memcpy(&ofsI, &msg[12], sizeof(ofsI));
+        memcpy(&magI, &msg[13], sizeof(magI));
+        memcpy(&ofsQ, &msg[14], sizeof(ofsQ));
+        memcpy(&magQ, &msg[15], sizeof(magQ));
+    }
+};
+
+struct UBY1 {
+    static const char *name() { return "UBY1"; }
+    static const char *format() { return "QBHBBHI"; }
+    static const char *labels() { return "TimeUS,Instance,noisePerMS,jamInd,aPower,agcCnt,config"; }
+    static uint8_t length() { return 22; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Instance;
+    uint16_t noisePerMS;
+    uint8_t jamInd;
+    uint8_t aPower;
+    uint16_t agcCnt;
+    uint32_t config;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Instance, &msg[11], sizeof(Instance));
+        memcpy(&noisePerMS, &msg[12], sizeof(noisePerMS));
+        memcpy(&jamInd, &msg[14], sizeof(jamInd));
+        memcpy(&aPower, &msg[15], sizeof(aPower));
+        memcpy(&agcCnt, &msg[16], sizeof(agcCnt));
+        memcpy(&config, &msg[18], sizeof(config));
+    }
+};
+
+struct UBY2 {
+    static const char *name() { return "UBY2"; }
+    static const char *format() { return "QBbBbB"; }
+    static const char *labels() { return "TimeUS,Instance,ofsI,magI,ofsQ,magQ"; }
+    static uint8_t length() { return 16; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Instance;
+    int8_t ofsI;
+    uint8_t magI;
+    int8_t ofsQ;
+    uint8_t magQ;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Instance, &msg[11], sizeof(Instance));
+        memcpy(&ofsI, &msg[12], sizeof(ofsI));
+        memcpy(&magI, &msg[13], sizeof(magI));
+        memcpy(&ofsQ, &msg[14], sizeof(ofsQ));
+        memcpy(&magQ, &msg[15], sizeof(magQ));
+    }
+};
+
+struct GRAW {
+    static const char *name() { return "GRAW"; }
+    static const char *format() { return "QIHBBddfBbB"; }
+    static const char *labels() { return "TimeUS,WkMS,Week,numSV,sv,cpMes,prMes,doMes,mesQI,cno,lli"; }
+    static uint8_t length() { return 42; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint32_t WkMS;
+    uint16_t Week;
+    uint8_t numSV;
+    uint8_t sv;
+    double cpMes;
+    double prMes;
+    float doMes;
+    uint8_t mesQI;
+    int8_t cno;
+    uint8_t lli;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&WkMS, &msg[11], sizeof(WkMS));
+        memcpy(&Week, &msg[15], sizeof(Week));
+        memcpy(&numSV, &msg[17], sizeof(numSV));
+        memcpy(&sv, &msg[18], sizeof(sv));
+        memcpy(&cpMes, &msg[19], sizeof(cpMes));
+        memcpy(&prMes, &msg[27], sizeof(prMes));
+        memcpy(&doMes, &msg[35], sizeof(doMes));
+        memcpy(&mesQI, &msg[39], sizeof(mesQI));
+        memcpy(&cno, &msg[40], sizeof(cno));
+        memcpy(&lli, &msg[41], sizeof(lli));
+    }
+};
+
+struct GRXH {
+    static const char *name() { return "GRXH"; }
+    static const char *format() { return "QdHbBB"; }
+    static const char *labels() { return "TimeUS,rcvTime,week,leapS,numMeas,recStat"; }
+    static uint8_t length() { return 24; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    double rcvTime;
+    uint16_t week;
+    int8_t leapS;
+    uint8_t numMeas;
+    uint8_t recStat;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&rcvTime, &msg[11], sizeof(rcvTime));
+        memcpy(&week, &msg[19], sizeof(week));
+        memcpy(&leapS, &msg[21], sizeof(leapS));
+        memcpy(&numMeas, &msg[22], sizeof(numMeas));
+        memcpy(&recStat, &msg[23], sizeof(recStat));
+    }
+};
+
+struct GRXS {
+    static const char *name() { return "GRXS"; }
+    static const char *format() { return "QddfBBBHBBBBB"; }
+    static const char *labels() { return "TimeUS,prMes,cpMes,doMes,gnss,sv,freq,lock,cno,prD,cpD,doD,trk"; }
+    static uint8_t length() { return 41; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    double prMes;
+    double cpMes;
+    float doMes;
+    uint8_t gnss;
+    uint8_t sv;
+    uint8_t freq;
+    uint16_t lock;
+    uint8_t cno;
+    uint8_t prD;
+    uint8_t cpD;
+    uint8_t doD;
+    uint8_t trk;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&prMes, &msg[11], sizeof(prMes));
+        memcpy(&cpMes, &msg[19], sizeof(cpMes));
+        memcpy(&doMes, &msg[27], sizeof(doMes));
+        memcpy(&gnss, &msg[31], sizeof(gnss));
+        memcpy(&sv, &msg[32], sizeof(sv));
+        memcpy(&freq, &msg[33], sizeof(freq));
+        memcpy(&lock, &msg[34], sizeof(lock));
+        memcpy(&cno, &msg[36], sizeof(cno));
+        memcpy(&prD, &msg[37], sizeof(prD));
+        memcpy(&cpD, &msg[38], sizeof(cpD));
+        memcpy(&doD, &msg[39], sizeof(doD));
+        memcpy(&trk, &msg[40], sizeof(trk));
+    }
+};
+
+struct SBFE {
+    static const char *name() { return "SBFE"; }
+    static const char *format() { return "QIHBBdddfffff"; }
+    static const char *labels() { return "TimeUS,TOW,WN,Mode,Err,Lat,Lng,Height,Undul,Vn,Ve,Vu,COG"; }
+    static uint8_t length() { return 63; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint32_t TOW;
+    uint16_t WN;
+    uint8_t Mode;
+    uint8_t Err;
+    double Lat;
+    double Lng;
+    double Height;
+    float Undul;
+    float Vn;
+    float Ve;
+    float Vu;
+    float COG;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&TOW, &msg[11], sizeof(TOW));
+        memcpy(&WN, &msg[15], sizeof(WN));
+        memcpy(&Mode, &msg[17], sizeof(Mode));
+        memcpy(&Err, &msg[18], sizeof(Err));
+        memcpy(&Lat, &msg[19], sizeof(Lat));
+        memcpy(&Lng, &msg[27], sizeof(Lng));
+        memcpy(&Height, &msg[35], sizeof(Height));
+        memcpy(&Undul, &msg[43], sizeof(Undul));
+        memcpy(&Vn, &msg[47], sizeof(Vn));
+        memcpy(&Ve, &msg[51], sizeof(Ve));
+        memcpy(&Vu, &msg[55], sizeof(Vu));
+        memcpy(&COG, &msg[59], sizeof(COG));
+    }
+};
+
+struct ESC1 {
+    static const char *name() { return "ESC1"; }
+    static const char *format() { return "QeCCcHc"; }
+    static const char *labels() { return "TimeUS,RPM,Volt,Curr,Temp,CTot,MotTemp"; }
+    static uint8_t length() { return 25; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int32_t RPM;
+    uint16_t Volt;
+    uint16_t Curr;
+    int16_t Temp;
+    uint16_t CTot;
+    int16_t MotTemp;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&RPM, &msg[11], sizeof(RPM));
+        memcpy(&Volt, &msg[15], sizeof(Volt));
+        memcpy(&Curr, &msg[17], sizeof(Curr));
+        memcpy(&Temp, &msg[19], sizeof(Temp));
+        memcpy(&CTot, &msg[21], sizeof(CTot));
+        memcpy(&MotTemp, &msg[23], sizeof(MotTemp));
+    }
+};
+
+struct ESC2 {
+    static const char *name() { return "ESC2"; }
+    static const char *format() { return "QeCCcHc"; }
+    static const char *labels() { return "TimeUS,RPM,Volt,Curr,Temp,CTot,MotTemp"; }
+    static uint8_t length() { return 25; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int32_t RPM;
+    uint16_t Volt;
+    uint16_t Curr;
+    int16_t Temp;
+    uint16_t CTot;
+    int16_t MotTemp;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&RPM, &msg[11], sizeof(RPM));
+        memcpy(&Volt, &msg[15], sizeof(Volt));
+        memcpy(&Curr, &msg[17], sizeof(Curr));
+        memcpy(&Temp, &msg[19], sizeof(Temp));
+        memcpy(&CTot, &msg[21], sizeof(CTot));
+        memcpy(&MotTemp, &msg[23], sizeof(MotTemp));
+    }
+};
+
+struct ESC3 {
+    static const char *name() { return "ESC3"; }
+    static const char *format() { return "QeCCcHc"; }
+    static const char *labels() { return "TimeUS,RPM,Volt,Curr,Temp,CTot,MotTemp"; }
+    static uint8_t length() { return 25; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int32_t RPM;
+    uint16_t Volt;
+    uint16_t Curr;
+    int16_t Temp;
+    uint16_t CTot;
+    int16_t MotTemp;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&RPM, &msg[11], sizeof(RPM));
+        memcpy(&Volt, &msg[15], sizeof(Volt));
+        memcpy(&Curr, &msg[17], sizeof(Curr));
+        memcpy(&Temp, &msg[19], sizeof(Temp));
+        memcpy(&CTot, &msg[21], sizeof(CTot));
+        memcpy(&MotTemp, &msg[23], sizeof(MotTemp));
+    }
+};
+
+struct ESC4 {
+    static const char *name() { return "ESC4"; }
+    static const char *format() { return "QeCCcHc"; }
+    static const char *labels() { return "TimeUS,RPM,Volt,Curr,Temp,CTot,MotTemp"; }
+    static uint8_t length() { return 25; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int32_t RPM;
+    uint16_t Volt;
+    uint16_t Curr;
+    int16_t Temp;
+    uint16_t CTot;
+    int16_t MotTemp;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&RPM, &msg[11], sizeof(RPM));
+        memcpy(&Volt, &msg[15], sizeof(Volt));
+        memcpy(&Curr, &msg[17], sizeof(Curr));
+        memcpy(&Temp, &msg[19], sizeof(Temp));
+        memcpy(&CTot, &msg[21], sizeof(CTot));
+        memcpy(&MotTemp, &msg[23], sizeof(MotTemp));
+    }
+};
+
+struct ESC5 {
+    static const char *name() { return "ESC5"; }
+    static const char *format() { return "QeCCcHc"; }
+    static const char *labels() { return "TimeUS,RPM,Volt,Curr,Temp,CTot,MotTemp"; }
+    static uint8_t length() { return 25; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int32_t RPM;
+    uint16_t Volt;
+    uint16_t Curr;
+    int16_t Temp;
+    uint16_t CTot;
+    int16_t MotTemp;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&RPM, &msg[11], sizeof(RPM));
+        memcpy(&Volt, &msg[15], sizeof(Volt));
+        memcpy(&Curr, &msg[17], sizeof(Curr));
+        memcpy(&Temp, &msg[19], sizeof(Temp));
+        memcpy(&CTot, &msg[21], sizeof(CTot));
+        memcpy(&MotTemp, &msg[23], sizeof(MotTemp));
+    }
+};
+
+struct ESC6 {
+    static const char *name() { return "ESC6"; }
+    static const char *format() { return "QeCCcHc"; }
+    static const char *labels() { return "TimeUS,RPM,Volt,Curr,Temp,CTot,MotTemp"; }
+    static uint8_t length() { return 25; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int32_t RPM;
+    uint16_t Volt;
+    uint16_t Curr;
+    int16_t Temp;
+    uint16_t CTot;
+    int16_t MotTemp;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&RPM, &msg[11], sizeof(RPM));
+        memcpy(&Volt, &msg[15], sizeof(Volt));
+        memcpy(&Curr, &msg[17], sizeof(Curr));
+        memcpy(&Temp, &msg[19], sizeof(Temp));
+        memcpy(&CTot, &msg[21], sizeof(CTot));
+        memcpy(&MotTemp, &msg[23], sizeof(MotTemp));
+    }
+};
+
+struct ESC7 {
+    static const char *name() { return "ESC7"; }
+    static const char *format() { return "QeCCcHc"; }
+    static const char *labels() { return "TimeUS,RPM,Volt,Curr,Temp,CTot,MotTemp"; }
+    static uint8_t length() { return 25; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int32_t RPM;
+    uint16_t Volt;
+    uint16_t Curr;
+    int16_t Temp;
+    uint16_t CTot;
+    int16_t MotTemp;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&RPM, &msg[11], sizeof(RPM));
+        memcpy(&Volt, &msg[15], sizeof(Volt));
+        memcpy(&Curr, &msg[17], sizeof(Curr));
+        memcpy(&Temp, &msg[19], sizeof(Temp));
+        memcpy(&CTot, &msg[21], sizeof(CTot));
+        memcpy(&MotTemp, &msg[23], sizeof(MotTemp));
+    }
+};
+
+struct ESC8 {
+    static const char *name() { return "ESC8"; }
+    static const char *format() { return "QeCCcHc"; }
+    static const char *labels() { return "TimeUS,RPM,Volt,Curr,Temp,CTot,MotTemp"; }
+    static uint8_t length() { return 25; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int32_t RPM;
+    uint16_t Volt;
+    uint16_t Curr;
+    int16_t Temp;
+    uint16_t CTot;
+    int16_t MotTemp;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&RPM, &msg[11], sizeof(RPM));
+        memcpy(&Volt, &msg[15], sizeof(Volt));
+        memcpy(&Curr, &msg[17], sizeof(Curr));
+        memcpy(&Temp, &msg[19], sizeof(Temp));
+        memcpy(&CTot, &msg[21], sizeof(CTot));
+        memcpy(&MotTemp, &msg[23], sizeof(MotTemp));
+    }
+};
+
+struct CSRV {
+    static const char *name() { return "CSRV"; }
+    static const char *format() { return "QBfffB"; }
+    static const char *labels() { return "TimeUS,Id,Pos,Force,Speed,Pow"; }
+    static uint8_t length() { return 25; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Id;
+    float Pos;
+    float Force;
+    float Speed;
+    uint8_t Pow;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Id, &msg[11], sizeof(Id));
+        memcpy(&Pos, &msg[12], sizeof(Pos));
+        memcpy(&Force, &msg[16], sizeof(Force));
+        memcpy(&Speed, &msg[20], sizeof(Speed));
+        memcpy(&Pow, &msg[24], sizeof(Pow));
+    }
+};
+
+struct CESC {
+    static const char *name() { return "CESC"; }
+    static const char *format() { return "QBIfffiB"; }
+    static const char *labels() { return "TimeUS,Id,ECnt,Voltage,Curr,Temp,RPM,Pow"; }
+    static uint8_t length() { return 33; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Id;
+    uint32_t ECnt;
+    float Voltage;
+    float Curr;
+    float Temp;
+    int32_t RPM;
+    uint8_t Pow;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Id, &msg[11], sizeof(Id));
+        memcpy(&ECnt, &msg[12], sizeof(ECnt));
+        memcpy(&Voltage, &msg[16], sizeof(Voltage));
+        memcpy(&Curr, &msg[20], sizeof(Curr));
+        memcpy(&Temp, &msg[24], sizeof(Temp));
+        memcpy(&RPM, &msg[28], sizeof(RPM));
+        memcpy(&Pow, &msg[32], sizeof(Pow));
+    }
+};
+
+struct MAG2 {
+    static const char *name() { return "MAG2"; }
+    static const char *format() { return "QhhhhhhhhhBI"; }
+    static const char *labels() { return "TimeUS,MagX,MagY,MagZ,OfsX,OfsY,OfsZ,MOfsX,MOfsY,MOfsZ,Health,S"; }
+    static uint8_t length() { return 34; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int16_t MagX;
+    int16_t MagY;
+    int16_t MagZ;
+    int16_t OfsX;
+    int16_t OfsY;
+    int16_t OfsZ;
+    int16_t MOfsX;
+    int16_t MOfsY;
+    int16_t MOfsZ;
+    uint8_t Health;
+    uint32_t S;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&MagX, &msg[11], sizeof(MagX));
+        memcpy(&MagY, &msg[13], sizeof(MagY));
+        memcpy(&MagZ, &msg[15], sizeof(MagZ));
+        memcpy(&OfsX, &msg[17], sizeof(OfsX));
+        memcpy(&OfsY, &msg[19], sizeof(OfsY));
+        memcpy(&OfsZ, &msg[21], sizeof(OfsZ));
+        memcpy(&MOfsX, &msg[23], sizeof(MOfsX));
+        memcpy(&MOfsY, &msg[25], sizeof(MOfsY));
+        memcpy(&MOfsZ, &msg[27], sizeof(MOfsZ));
+        memcpy(&Health, &msg[29], sizeof(Health));
+        memcpy(&S, &msg[30], sizeof(S));
+    }
+};
+
+struct MAG3 {
+    static const char *name() { return "MAG3"; }
+    static const char *format() { return "QhhhhhhhhhBI"; }
+    static const char *labels() { return "TimeUS,MagX,MagY,MagZ,OfsX,OfsY,OfsZ,MOfsX,MOfsY,MOfsZ,Health,S"; }
+    static uint8_t length() { return 34; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    int16_t MagX;
+    int16_t MagY;
+    int16_t MagZ;
+    int16_t OfsX;
+    int16_t OfsY;
+    int16_t OfsZ;
+    int16_t MOfsX;
+    int16_t MOfsY;
+    int16_t MOfsZ;
+    uint8_t Health;
+    uint32_t S;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&MagX, &msg[11], sizeof(MagX));
+        memcpy(&MagY, &msg[13], sizeof(MagY));
+        memcpy(&MagZ, &msg[15], sizeof(MagZ));
+        memcpy(&OfsX, &msg[17], sizeof(OfsX));
+        memcpy(&OfsY, &msg[19], sizeof(OfsY));
+        memcpy(&OfsZ, &msg[21], sizeof(OfsZ));
+        memcpy(&MOfsX, &msg[23], sizeof(MOfsX));
+        memcpy(&MOfsY, &msg[25], sizeof(MOfsY));
+        memcpy(&MOfsZ, &msg[27], sizeof(MOfsZ));
+        memcpy(&Health, &msg[29], sizeof(Health));
+        memcpy(&S, &msg[30], sizeof(S));
+    }
+};
+
+struct ACC1 {
+    static const char *name() { return "ACC1"; }
+    static const char *format() { return "QQfff"; }
+    static const char *labels() { return "TimeUS,SampleUS,AccX,AccY,AccZ"; }
+    static uint8_t length() { return 31; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint64_t SampleUS;
+    float AccX;
+    float AccY;
+    float AccZ;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&SampleUS, &msg[11], sizeof(SampleUS));
+        memcpy(&AccX, &msg[19], sizeof(AccX));
+        memcpy(&AccY, &msg[23], sizeof(AccY));
+        memcpy(&AccZ, &msg[27], sizeof(AccZ));
+    }
+};
+
+struct ACC2 {
+    static const char *name() { return "ACC2"; }
+    static const char *format() { return "QQfff"; }
+    static const char *labels() { return "TimeUS,SampleUS,AccX,AccY,AccZ"; }
+    static uint8_t length() { return 31; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint64_t SampleUS;
+    float AccX;
+    float AccY;
+    float AccZ;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&SampleUS, &msg[11], sizeof(SampleUS));
+        memcpy(&AccX, &msg[19], sizeof(AccX));
+        memcpy(&AccY, &msg[23], sizeof(AccY));
+        memcpy(&AccZ, &msg[27], sizeof(AccZ));
+    }
+};
+
+struct ACC3 {
+    static const char *name() { return "ACC3"; }
+    static const char *format() { return "QQfff"; }
+    static const char *labels() { return "TimeUS,SampleUS,AccX,AccY,AccZ"; }
+    static uint8_t length() { return 31; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint64_t SampleUS;
+    float AccX;
+    float AccY;
+    float AccZ;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&SampleUS, &msg[11], sizeof(SampleUS));
+        memcpy(&AccX, &msg[19], sizeof(AccX));
+        memcpy(&AccY, &msg[23], sizeof(AccY));
+        memcpy(&AccZ, &msg[27], sizeof(AccZ));
+    }
+};
+
+struct GYR1 {
+    static const char *name() { return "GYR1"; }
+    static const char *format() { return "QQfff"; }
+    static const char *labels() { return "TimeUS,SampleUS,GyrX,GyrY,GyrZ"; }
+    static uint8_t length() { return 31; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint64_t SampleUS;
+    float GyrX;
+    float GyrY;
+    float GyrZ;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&SampleUS, &msg[11], sizeof(SampleUS));
+        memcpy(&GyrX, &msg[19], sizeof(GyrX));
+        memcpy(&GyrY, &msg[23], sizeof(GyrY));
+        memcpy(&GyrZ, &msg[27], sizeof(GyrZ));
+    }
+};
+
+struct GYR2 {
+    static const char *name() { return "GYR2"; }
+    static const char *format() { return "QQfff"; }
+    static const char *labels() { return "TimeUS,SampleUS,GyrX,GyrY,GyrZ"; }
+    static uint8_t length() { return 31; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint64_t SampleUS;
+    float GyrX;
+    float GyrY;
+    float GyrZ;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&SampleUS, &msg[11], sizeof(SampleUS));
+        memcpy(&GyrX, &msg[19], sizeof(GyrX));
+        memcpy(&GyrY, &msg[23], sizeof(GyrY));
+        memcpy(&GyrZ, &msg[27], sizeof(GyrZ));
+    }
+};
+
+struct GYR3 {
+    static const char *name() { return "GYR3"; }
+    static const char *format() { return "QQfff"; }
+    static const char *labels() { return "TimeUS,SampleUS,GyrX,GyrY,GyrZ"; }
+    static uint8_t length() { return 31; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint64_t SampleUS;
+    float GyrX;
+    float GyrY;
+    float GyrZ;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&SampleUS, &msg[11], sizeof(SampleUS));
+        memcpy(&GyrX, &msg[19], sizeof(GyrX));
+        memcpy(&GyrY, &msg[23], sizeof(GyrY));
+        memcpy(&GyrZ, &msg[27], sizeof(GyrZ));
+    }
+};
+
+struct PIDR {
+    static const char *name() { return "PIDR"; }
+    static const char *format() { return "Qfffffff"; }
+    static const char *labels() { return "TimeUS,Tar,Act,Err,P,I,D,FF"; }
+    static uint8_t length() { return 39; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float Tar;
+    float Act;
+    float Err;
+    float P;
+    float I;
+    float D;
+    float FF;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Tar, &msg[11], sizeof(Tar));
+        memcpy(&Act, &msg[15], sizeof(Act));
+        memcpy(&Err, &msg[19], sizeof(Err));
+        memcpy(&P, &msg[23], sizeof(P));
+        memcpy(&I, &msg[27], sizeof(I));
+        memcpy(&D, &msg[31], sizeof(D));
+        memcpy(&FF, &msg[35], sizeof(FF));
+    }
+};
+
+struct PIDP {
+    static const char *name() { return "PIDP"; }
+    static const char *format() { return "Qfffffff"; }
+    static const char *labels() { return "TimeUS,Tar,Act,Err,P,I,D,FF"; }
+    static uint8_t length() { return 39; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float Tar;
+    float Act;
+    float Err;
+    float P;
+    float I;
+    float D;
+    float FF;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Tar, &msg[11], sizeof(Tar));
+        memcpy(&Act, &msg[15], sizeof(Act));
+        memcpy(&Err, &msg[19], sizeof(Err));
+        memcpy(&P, &msg[23], sizeof(P));
+        memcpy(&I, &msg[27], sizeof(I));
+        memcpy(&D, &msg[31], sizeof(D));
+        memcpy(&FF, &msg[35], sizeof(FF));
+    }
+};
+
+struct PIDY {
+    static const char *name() { return "PIDY"; }
+    static const char *format() { return "Qfffffff"; }
+    static const char *labels() { return "TimeUS,Tar,Act,Err,P,I,D,FF"; }
+    static uint8_t length() { return 39; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float Tar;
+    float Act;
+    float Err;
+    float P;
+    float I;
+    float D;
+    float FF;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Tar, &msg[11], sizeof(Tar));
+        memcpy(&Act, &msg[15], sizeof(Act));
+        memcpy(&Err, &msg[19], sizeof(Err));
+        memcpy(&P, &msg[23], sizeof(P));
+        memcpy(&I, &msg[27], sizeof(I));
+        memcpy(&D, &msg[31], sizeof(D));
+        memcpy(&FF, &msg[35], sizeof(FF));
+    }
+};
+
+struct PIDA {
+    static const char *name() { return "PIDA"; }
+    static const char *format() { return "Qfffffff"; }
+    static const char *labels() { return "TimeUS,Tar,Act,Err,P,I,D,FF"; }
+    static uint8_t length() { return 39; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float Tar;
+    float Act;
+    float Err;
+    float P;
+    float I;
+    float D;
+    float FF;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Tar, &msg[11], sizeof(Tar));
+        memcpy(&Act, &msg[15], sizeof(Act));
+        memcpy(&Err, &msg[19], sizeof(Err));
+        memcpy(&P, &msg[23], sizeof(P));
+        memcpy(&I, &msg[27], sizeof(I));
+        memcpy(&D, &msg[31], sizeof(D));
+        memcpy(&FF, &msg[35], sizeof(FF));
+    }
+};
+
+struct PIDS {
+    static const char *name() { return "PIDS"; }
+    static const char *format() { return "Qfffffff"; }
+    static const char *labels() { return "TimeUS,Tar,Act,Err,P,I,D,FF"; }
+    static uint8_t length() { return 39; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float Tar;
+    float Act;
+    float Err;
+    float P;
+    float I;
+    float D;
+    float FF;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Tar, &msg[11], sizeof(Tar));
+        memcpy(&Act, &msg[15], sizeof(Act));
+        memcpy(&Err, &msg[19], sizeof(Err));
+        memcpy(&P, &msg[23], sizeof(P));
+        memcpy(&I, &msg[27], sizeof(I));
+        memcpy(&D, &msg[31], sizeof(D));
+        memcpy(&FF, &msg[35], sizeof(FF));
+    }
+};
+
+struct DSTL {
+    static const char *name() { return "DSTL"; }
+    static const char *format() { return "QBfLLeccfeffff"; }
+    static const char *labels() { return "TimeUS,Stg,THdg,Lat,Lng,Alt,XT,Travel,L1I,Loiter,Des,P,I,D"; }
+    static uint8_t length() { return 56; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Stg;
+    float THdg;
+    int32_t Lat;
+    int32_t Lng;
+    int32_t Alt;
+    int16_t XT;
+    int16_t Travel;
+    float L1I;
+    int32_t Loiter;
+    float Des;
+    float P;
+    float I;
+    float D;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Stg, &msg[11], sizeof(Stg));
+        memcpy(&THdg, &msg[12], sizeof(THdg));
+        memcpy(&Lat, &msg[16], sizeof(Lat));
+        memcpy(&Lng, &msg[20], sizeof(Lng));
+        memcpy(&Alt, &msg[24], sizeof(Alt));
+        memcpy(&XT, &msg[28], sizeof(XT));
+        memcpy(&Travel, &msg[30], sizeof(Travel));
+        memcpy(&L1I, &msg[32], sizeof(L1I));
+        memcpy(&Loiter, &msg[36], sizeof(Loiter));
+        memcpy(&Des, &msg[40], sizeof(Des));
+        memcpy(&P, &msg[44], sizeof(P));
+        memcpy(&I, &msg[48], sizeof(I));
+        memcpy(&D, &msg[52], sizeof(D));
+    }
+};
+
+struct BAR2 {
+    static const char *name() { return "BAR2"; }
+    static const char *format() { return "QffcfIffB"; }
+    static const char *labels() { return "TimeUS,Alt,Press,Temp,CRt,SMS,Offset,GndTemp,Health"; }
+    static uint8_t length() { return 38; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float Alt;
+    float Press;
+    int16_t Temp;
+    float CRt;
+    uint32_t SMS;
+    float Offset;
+    float GndTemp;
+    uint8_t Health;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Alt, &msg[11], sizeof(Alt));
+        memcpy(&Press, &msg[15], sizeof(Press));
+        memcpy(&Temp, &msg[19], sizeof(Temp));
+        memcpy(&CRt, &msg[21], sizeof(CRt));
+        memcpy(&SMS, &msg[25], sizeof(SMS));
+        memcpy(&Offset, &msg[29], sizeof(Offset));
+        memcpy(&GndTemp, &msg[33], sizeof(GndTemp));
+        memcpy(&Health, &msg[37], sizeof(Health));
+    }
+};
+
+struct BAR3 {
+    static const char *name() { return "BAR3"; }
+    static const char *format() { return "QffcfIffB"; }
+    static const char *labels() { return "TimeUS,Alt,Press,Temp,CRt,SMS,Offset,GndTemp,Health"; }
+    static uint8_t length() { return 38; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float Alt;
+    float Press;
+    int16_t Temp;
+    float CRt;
+    uint32_t SMS;
+    float Offset;
+    float GndTemp;
+    uint8_t Health;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Alt, &msg[11], sizeof(Alt));
+        memcpy(&Press, &msg[15], sizeof(Press));
+        memcpy(&Temp, &msg[19], sizeof(Temp));
+        memcpy(&CRt, &msg[21], sizeof(CRt));
+        memcpy(&SMS, &msg[25], sizeof(SMS));
+        memcpy(&Offset, &msg[29], sizeof(Offset));
+        memcpy(&GndTemp, &msg[33], sizeof(GndTemp));
+        memcpy(&Health, &msg[37], sizeof(Health));
+    }
+};
+
+struct VIBE {
+    static const char *name() { return "VIBE"; }
+    static const char *format() { return "QfffIII"; }
+    static const char *labels() { return "TimeUS,VibeX,VibeY,VibeZ,Clip0,Clip1,Clip2"; }
+    static uint8_t length() { return 35; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float VibeX;
+    float VibeY;
+    float VibeZ;
+    uint32_t Clip0;
+    uint32_t Clip1;
+    uint32_t Clip2;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&VibeX, &msg[11], sizeof(VibeX));
+        memcpy(&VibeY, &msg[15], sizeof(VibeY));
+        memcpy(&VibeZ, &msg[19], sizeof(VibeZ));
+        memcpy(&Clip0, &msg[23], sizeof(Clip0));
+        memcpy(&Clip1, &msg[27], sizeof(Clip1));
+        memcpy(&Clip2, &msg[31], sizeof(Clip2));
+    }
+};
+
+struct IMT {
+    static const char *name() { return "IMT"; }
+    static const char *format() { return "Qfffffffff"; }
+    static const char *labels() { return "TimeUS,DelT,DelvT,DelaT,DelAX,DelAY,DelAZ,DelVX,DelVY,DelVZ"; }
+    static uint8_t length() { return 47; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float DelT;
+    float DelvT;
+    float DelaT;
+    float DelAX;
+    float DelAY;
+    float DelAZ;
+    float DelVX;
+    float DelVY;
+    float DelVZ;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&DelT, &msg[11], sizeof(DelT));
+        memcpy(&DelvT, &msg[15], sizeof(DelvT));
+        memcpy(&DelaT, &msg[19], sizeof(DelaT));
+        memcpy(&DelAX, &msg[23], sizeof(DelAX));
+        memcpy(&DelAY, &msg[27], sizeof(DelAY));
+        memcpy(&DelAZ, &msg[31], sizeof(DelAZ));
+        memcpy(&DelVX, &msg[35], sizeof(DelVX));
+        memcpy(&DelVY, &msg[39], sizeof(DelVY));
+        memcpy(&DelVZ, &msg[43], sizeof(DelVZ));
+    }
+};
+
+struct IMT2 {
+    static const char *name() { return "IMT2"; }
+    static const char *format() { return "Qfffffffff"; }
+    static const char *labels() { return "TimeUS,DelT,DelvT,DelaT,DelAX,DelAY,DelAZ,DelVX,DelVY,DelVZ"; }
+    static uint8_t length() { return 47; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float DelT;
+    float DelvT;
+    float DelaT;
+    float DelAX;
+    float DelAY;
+    float DelAZ;
+    float DelVX;
+    float DelVY;
+    float DelVZ;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&DelT, &msg[11], sizeof(DelT));
+        memcpy(&DelvT, &msg[15], sizeof(DelvT));
+        memcpy(&DelaT, &msg[19], sizeof(DelaT));
+        memcpy(&DelAX, &msg[23], sizeof(DelAX));
+        memcpy(&DelAY, &msg[27], sizeof(DelAY));
+        memcpy(&DelAZ, &msg[31], sizeof(DelAZ));
+        memcpy(&DelVX, &msg[35], sizeof(DelVX));
+        memcpy(&DelVY, &msg[39], sizeof(DelVY));
+        memcpy(&DelVZ, &msg[43], sizeof(DelVZ));
+    }
+};
+
+struct IMT3 {
+    static const char *name() { return "IMT3"; }
+    static const char *format() { return "Qfffffffff"; }
+    static const char *labels() { return "TimeUS,DelT,DelvT,DelaT,DelAX,DelAY,DelAZ,DelVX,DelVY,DelVZ"; }
+    static uint8_t length() { return 47; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float DelT;
+    float DelvT;
+    float DelaT;
+    float DelAX;
+    float DelAY;
+    float DelAZ;
+    float DelVX;
+    float DelVY;
+    float DelVZ;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&DelT, &msg[11], sizeof(DelT));
+        memcpy(&DelvT, &msg[15], sizeof(DelvT));
+        memcpy(&DelaT, &msg[19], sizeof(DelaT));
+        memcpy(&DelAX, &msg[23], sizeof(DelAX));
+        memcpy(&DelAY, &msg[27], sizeof(DelAY));
+        memcpy(&DelAZ, &msg[31], sizeof(DelAZ));
+        memcpy(&DelVX, &msg[35], sizeof(DelVX));
+        memcpy(&DelVY, &msg[39], sizeof(DelVY));
+        memcpy(&DelVZ, &msg[43], sizeof(DelVZ));
+    }
+};
+
+struct ISBH {
+    static const char *name() { return "ISBH"; }
+    static const char *format() { return "QHBBHHQf"; }
+    static const char *labels() { return "TimeUS,N,type,instance,mul,smp_cnt,SampleUS,smp_rate"; }
+    static uint8_t length() { return 31; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint16_t N;
+    uint8_t type;
+    uint8_t instance;
+    uint16_t mul;
+    uint16_t smp_cnt;
+    uint64_t SampleUS;
+    float smp_rate;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&N, &msg[11], sizeof(N));
+        memcpy(&type, &msg[13], sizeof(type));
+        memcpy(&instance, &msg[14], sizeof(instance));
+        memcpy(&mul, &msg[15], sizeof(mul));
+        memcpy(&smp_cnt, &msg[17], sizeof(smp_cnt));
+        memcpy(&SampleUS, &msg[19], sizeof(SampleUS));
+        memcpy(&smp_rate, &msg[27], sizeof(smp_rate));
+    }
+};
+
+struct ISBD {
+    static const char *name() { return "ISBD"; }
+    static const char *format() { return "QHHaaa"; }
+    static const char *labels() { return "TimeUS,N,seqno,x,y,z"; }
+    static uint8_t length() { return 207; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint16_t N;
+    uint16_t seqno;
+    int16_t x[32];
+    int16_t y[32];
+    int16_t z[32];
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&N, &msg[11], sizeof(N));
+        memcpy(&seqno, &msg[13], sizeof(seqno));
+        memcpy(&x, &msg[15], sizeof(x));
+        memcpy(&y, &msg[79], sizeof(y));
+        memcpy(&z, &msg[143], sizeof(z));
+    }
+};
+
+struct DBAT {
+    static const char *name() { return "DBAT"; }
+    static const char *format() { return "BBBaaa"; }
+    static const char *labels() { return "Type,N,Len,D0,D1,D2"; }
+    static uint8_t length() { return 198; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint8_t Type;
+    uint8_t N;
+    uint8_t Len;
+    int16_t D0[32];
+    int16_t D1[32];
+    int16_t D2[32];
+
+    void decode(const uint8_t *msg) {
+        memcpy(&Type, &msg[3], sizeof(Type));
+        memcpy(&N, &msg[4], sizeof(N));
+        memcpy(&Len, &msg[5], sizeof(Len));
+        memcpy(&D0, &msg[6], sizeof(D0));
+        memcpy(&D1, &msg[70], sizeof(D1));
+        memcpy(&D2, &msg[134], sizeof(D2));
+    }
+};
+
+struct ORGN {
+    static const char *name() { return "ORGN"; }
+    static const char *format() { return "QBLLe"; }
+    static const char *labels() { return "TimeUS,Type,Lat,Lng,Alt"; }
+    static uint8_t length() { return 24; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Type;
+    int32_t Lat;
+    int32_t Lng;
+    int32_t Alt;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Type, &msg[11], sizeof(Type));
+        memcpy(&Lat, &msg[12], sizeof(Lat));
+        memcpy(&Lng, &msg[16], sizeof(Lng));
+        memcpy(&Alt, &msg[20], sizeof(Alt));
+    }
+};
+
+struct DSF {
+    static const char *name() { return "DSF"; }
+    static const char *format() { return "QIHIIII"; }
+    static const char *labels() { return "TimeUS,Dp,Blk,Bytes,FMn,FMx,FAv"; }
+    static uint8_t length() { return 33; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint32_t Dp;
+    uint16_t Blk;
+    uint32_t Bytes;
+    uint32_t FMn;
+    uint32_t FMx;
+    uint32_t FAv;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Dp, &msg[11], sizeof(Dp));
+        memcpy(&Blk, &msg[15], sizeof(Blk));
+        memcpy(&Bytes, &msg[17], sizeof(Bytes));
+        memcpy(&FMn, &msg[21], sizeof(FMn));
+        memcpy(&FMx, &msg[25], sizeof(FMx));
+        memcpy(&FAv, &msg[29], sizeof(FAv));
+    }
+};
+
+struct RPM {
+    static const char *name() { return "RPM"; }
+    static const char *format() { return "Qff"; }
+    static const char *labels() { return "TimeUS,rpm1,rpm2"; }
+    static uint8_t length() { return 19; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float rpm1;
+    float rpm2;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&rpm1, &msg[11], sizeof(rpm1));
+        memcpy(&rpm2, &msg[15], sizeof(rpm2));
+    }
+};
+
+struct GMB1 {
+    static const char *name() { return "GMB1"; }
+    static const char *format() { return "Qffffffffff"; }
+    static const char *labels() { return "TimeUS,dt,dax,day,daz,dvx,dvy,dvz,jx,jy,jz"; }
+    static uint8_t length() { return 51; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float dt;
+    float dax;
+    float day;
+    float daz;
+    float dvx;
+    float dvy;
+    float dvz;
+    float jx;
+    float jy;
+    float jz;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&dt, &msg[11], sizeof(dt));
+        memcpy(&dax, &msg[15], sizeof(dax));
+        memcpy(&day, &msg[19], sizeof(day));
+        memcpy(&daz, &msg[23], sizeof(daz));
+        memcpy(&dvx, &msg[27], sizeof(dvx));
+        memcpy(&dvy, &msg[31], sizeof(dvy));
+        memcpy(&dvz, &msg[35], sizeof(dvz));
+        memcpy(&jx, &msg[39], sizeof(jx));
+        memcpy(&jy, &msg[43], sizeof(jy));
+        memcpy(&jz, &msg[47], sizeof(jz));
+    }
+};
+
+struct GMB2 {
+    static const char *name() { return "GMB2"; }
+    static const char *format() { return "QBfffffffff"; }
+    static const char *labels() { return "TimeUS,es,ex,ey,ez,rx,ry,rz,tx,ty,tz"; }
+    static uint8_t length() { return 48; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t es;
+    float ex;
+    float ey;
+    float ez;
+    float rx;
+    float ry;
+    float rz;
+    float tx;
+    float ty;
+    float tz;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&es, &msg[11], sizeof(es));
+        memcpy(&ex, &msg[12], sizeof(ex));
+        memcpy(&ey, &msg[16], sizeof(ey));
+        memcpy(&ez, &msg[20], sizeof(ez));
+        memcpy(&rx, &msg[24], sizeof(rx));
+        memcpy(&ry, &msg[28], sizeof(ry));
+        memcpy(&rz, &msg[32], sizeof(rz));
+        memcpy(&tx, &msg[36], sizeof(tx));
+        memcpy(&ty, &msg[40], sizeof(ty));
+        memcpy(&tz, &msg[44], sizeof(tz));
+    }
+};
+
+struct RATE {
+    static const char *name() { return "RATE"; }
+    static const char *format() { return "Qffffffffffff"; }
+    static const char *labels() { return "TimeUS,RDes,R,ROut,PDes,P,POut,YDes,Y,YOut,ADes,A,AOut"; }
+    static uint8_t length() { return 59; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float RDes;
+    float R;
+    float ROut;
+    float PDes;
+    float P;
+    float POut;
+    float YDes;
+    float Y;
+    float YOut;
+    float ADes;
+    float A;
+    float AOut;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&RDes, &msg[11], sizeof(RDes));
+        memcpy(&R, &msg[15], sizeof(R));
+        memcpy(&ROut, &msg[19], sizeof(ROut));
+        memcpy(&PDes, &msg[23], sizeof(PDes));
+        memcpy(&P, &msg[27], sizeof(P));
+        memcpy(&POut, &msg[31], sizeof(POut));
+        memcpy(&YDes, &msg[35], sizeof(YDes));
+        memcpy(&Y, &msg[39], sizeof(Y));
+        memcpy(&YOut, &msg[43], sizeof(YOut));
+        memcpy(&ADes, &msg[47], sizeof(ADes));
+        memcpy(&A, &msg[51], sizeof(A));
+        memcpy(&AOut, &msg[55], sizeof(AOut));
+    }
+};
+
+struct RALY {
+    static const char *name() { return "RALY"; }
+    static const char *format() { return "QBBLLh"; }
+    static const char *labels() { return "TimeUS,Tot,Seq,Lat,Lng,Alt"; }
+    static uint8_t length() { return 23; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Tot;
+    uint8_t Seq;
+    int32_t Lat;
+    int32_t Lng;
+    int16_t Alt;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Tot, &msg[11], sizeof(Tot));
+        memcpy(&Seq, &msg[12], sizeof(Seq));
+        memcpy(&Lat, &msg[13], sizeof(Lat));
+        memcpy(&Lng, &msg[17], sizeof(Lng));
+        memcpy(&Alt, &msg[21], sizeof(Alt));
+    }
+};
+
+struct MAV {
+    static const char *name() { return "MAV"; }
+    static const char *format() { return "QBHHHBHH"; }
+    static const char *labels() { return "TimeUS,chan,txp,rxp,rxdp,flags,ss,tf"; }
+    static uint8_t length() { return 23; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t chan;
+    uint16_t txp;
+    uint16_t rxp;
+    uint16_t rxdp;
+    uint8_t flags;
+    uint16_t ss;
+    uint16_t tf;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&chan, &msg[11], sizeof(chan));
+        memcpy(&txp, &msg[12], sizeof(txp));
+        memcpy(&rxp, &msg[14], sizeof(rxp));
+        memcpy(&rxdp, &msg[16], sizeof(rxdp));
+        memcpy(&flags, &msg[18], sizeof(flags));
+        memcpy(&ss, &msg[19], sizeof(ss));
+        memcpy(&tf, &msg[21], sizeof(tf));
+    }
+};
+
+struct VISO {
+    static const char *name() { return "VISO"; }
+    static const char *format() { return "Qffffffff"; }
+    static const char *labels() { return "TimeUS,dt,AngDX,AngDY,AngDZ,PosDX,PosDY,PosDZ,conf"; }
+    static uint8_t length() { return 43; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float dt;
+    float AngDX;
+    float AngDY;
+    float AngDZ;
+    float PosDX;
+    float PosDY;
+    float PosDZ;
+    float conf;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&dt, &msg[11], sizeof(dt));
+        memcpy(&AngDX, &msg[15], sizeof(AngDX));
+        memcpy(&AngDY, &msg[19], sizeof(AngDY));
+        memcpy(&AngDZ, &msg[23], sizeof(AngDZ));
+        memcpy(&PosDX, &msg[27], sizeof(PosDX));
+        memcpy(&PosDY, &msg[31], sizeof(PosDY));
+        memcpy(&PosDZ, &msg[35], sizeof(PosDZ));
+        memcpy(&conf, &msg[39], sizeof(conf));
+    }
+};
+
+struct VISP {
+    static const char *name() { return "VISP"; }
+    static const char *format() { return "QQIffffffb"; }
+    static const char *labels() { return "TimeUS,RemTimeUS,CTimeMS,PX,PY,PZ,Roll,Pitch,Yaw,ResetCnt"; }
+    static uint8_t length() { return 48; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint64_t RemTimeUS;
+    uint32_t CTimeMS;
+    float PX;
+    float PY;
+    float PZ;
+    float Roll;
+    float Pitch;
+    float Yaw;
+    int8_t ResetCnt;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&RemTimeUS, &msg[11], sizeof(RemTimeUS));
+        memcpy(&CTimeMS, &msg[19], sizeof(CTimeMS));
+        memcpy(&PX, &msg[23], sizeof(PX));
+        memcpy(&PY, &msg[27], sizeof(PY));
+        memcpy(&PZ, &msg[31], sizeof(PZ));
+        memcpy(&Roll, &msg[35], sizeof(Roll));
+        memcpy(&Pitch, &msg[39], sizeof(Pitch));
+        memcpy(&Yaw, &msg[43], sizeof(Yaw));
+        memcpy(&ResetCnt, &msg[47], sizeof(ResetCnt));
+    }
+};
+
+struct OF {
+    static const char *name() { return "OF"; }
+    static const char *format() { return "QBffff"; }
+    static const char *labels() { return "TimeUS,Qual,flowX,flowY,bodyX,bodyY"; }
+    static uint8_t length() { return 28; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Qual;
+    float flowX;
+    float flowY;
+    float bodyX;
+    float bodyY;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Qual, &msg[11], sizeof(Qual));
+        memcpy(&flowX, &msg[12], sizeof(flowX));
+        memcpy(&flowY, &msg[16], sizeof(flowY));
+        memcpy(&bodyX, &msg[20], sizeof(bodyX));
+        memcpy(&bodyY, &msg[24], sizeof(bodyY));
+    }
+};
+
+struct WENC {
+    static const char *name() { return "WENC"; }
+    static const char *format() { return "Qfbfb"; }
+    static const char *labels() { return "TimeUS,Dist0,Qual0,Dist1,Qual1"; }
+    static uint8_t length() { return 21; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    float Dist0;
+    int8_t Qual0;
+    float Dist1;
+    int8_t Qual1;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Dist0, &msg[11], sizeof(Dist0));
+        memcpy(&Qual0, &msg[15], sizeof(Qual0));
+        memcpy(&Dist1, &msg[16], sizeof(Dist1));
+        memcpy(&Qual1, &msg[20], sizeof(Qual1));
+    }
+};
+
+struct ADSB {
+    static const char *name() { return "ADSB"; }
+    static const char *format() { return "QIiiiHHhH"; }
+    static const char *labels() { return "TimeUS,ICAO_address,Lat,Lng,Alt,Heading,Hor_vel,Ver_vel,Squark"; }
+    static uint8_t length() { return 35; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint32_t ICAO_address;
+    int32_t Lat;
+    int32_t Lng;
+    int32_t Alt;
+    uint16_t Heading;
+    uint16_t Hor_vel;
+    int16_t Ver_vel;
+    uint16_t Squark;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&ICAO_address, &msg[11], sizeof(ICAO_address));
+        memcpy(&Lat, &msg[15], sizeof(Lat));
+        memcpy(&Lng, &msg[19], sizeof(Lng));
+        memcpy(&Alt, &msg[23], sizeof(Alt));
+        memcpy(&Heading, &msg[27], sizeof(Heading));
+        memcpy(&Hor_vel, &msg[29], sizeof(Hor_vel));
+        memcpy(&Ver_vel, &msg[31], sizeof(Ver_vel));
+        memcpy(&Squark, &msg[33], sizeof(Squark));
+    }
+};
+
+struct EV {
+    static const char *name() { return "EV"; }
+    static const char *format() { return "QB"; }
+    static const char *labels() { return "TimeUS,Id"; }
+    static uint8_t length() { return 12; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Id;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Id, &msg[11], sizeof(Id));
+    }
+};
+
+struct ARM {
+    static const char *name() { return "ARM"; }
+    static const char *format() { return "QBIBB"; }
+    static const char *labels() { return "TimeUS,ArmState,ArmChecks,Forced,Method"; }
+    static uint8_t length() { return 18; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t ArmState;
+    uint32_t ArmChecks;
+    uint8_t Forced;
+    uint8_t Method;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&ArmState, &msg[11], sizeof(ArmState));
+        memcpy(&ArmChecks, &msg[12], sizeof(ArmChecks));
+        memcpy(&Forced, &msg[16], sizeof(Forced));
+        memcpy(&Method, &msg[17], sizeof(Method));
+    }
+};
+
+struct ERR {
+    static const char *name() { return "ERR"; }
+    static const char *format() { return "QBB"; }
+    static const char *labels() { return "TimeUS,Subsys,ECode"; }
+    static uint8_t length() { return 13; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint8_t Subsys;
+    uint8_t ECode;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&Subsys, &msg[11], sizeof(Subsys));
+        memcpy(&ECode, &msg[12], sizeof(ECode));
+    }
+};
+
+struct SBPH {
+    static const char *name() { return "SBPH"; }
+    static const char *format() { return "QIII"; }
+    static const char *labels() { return "TimeUS,CrcError,LastInject,IARhyp"; }
+    static uint8_t length() { return 23; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint32_t CrcError;
+    uint32_t LastInject;
+    uint32_t IARhyp;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&CrcError, &msg[11], sizeof(CrcError));
+        memcpy(&LastInject, &msg[15], sizeof(LastInject));
+        memcpy(&IARhyp, &msg[19], sizeof(IARhyp));
+    }
+};
+
+struct SBRH {
+    static const char *name() { return "SBRH"; }
+    static const char *format() { return "QQQQQQQQ"; }
+    static const char *labels() { return "TimeUS,msg_flag,1,2,3,4,5,6"; }
+    static uint8_t length() { return 67; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint64_t msg_flag;
+    uint64_t f1;
+    uint64_t f2;
+    uint64_t f3;
+    uint64_t f4;
+    uint64_t f5;
+    uint64_t f6;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&msg_flag, &msg[11], sizeof(msg_flag));
+        memcpy(&f1, &msg[19], sizeof(f1));
+        memcpy(&f2, &msg[27], sizeof(f2));
+        memcpy(&f3, &msg[35], sizeof(f3));
+        memcpy(&f4, &msg[43], sizeof(f4));
+        memcpy(&f5, &msg[51], sizeof(f5));
+        memcpy(&f6, &msg[59], sizeof(f6));
+    }
+};
+
+struct SBRM {
+    static const char *name() { return "SBRM"; }
+    static const char *format() { return "QQQQQQQQQQQQQQQ"; }
+    static const char *labels() { return "TimeUS,msg_flag,1,2,3,4,5,6,7,8,9,10,11,12,13"; }
+    static uint8_t length() { return 123; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint64_t msg_flag;
+    uint64_t f1;
+    uint64_t f2;
+    uint64_t f3;
+    uint64_t f4;
+    uint64_t f5;
+    uint64_t f6;
+    uint64_t f7;
+    uint64_t f8;
+    uint64_t f9;
+    uint64_t f10;
+    uint64_t f11;
+    uint64_t f12;
+    uint64_t f13;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&msg_flag, &msg[11], sizeof(msg_flag));
+        memcpy(&f1, &msg[19], sizeof(f1));
+        memcpy(&f2, &msg[27], sizeof(f2));
+        memcpy(&f3, &msg[35], sizeof(f3));
+        memcpy(&f4, &msg[43], sizeof(f4));
+        memcpy(&f5, &msg[51], sizeof(f5));
+        memcpy(&f6, &msg[59], sizeof(f6));
+        memcpy(&f7, &msg[67], sizeof(f7));
+        memcpy(&f8, &msg[75], sizeof(f8));
+        memcpy(&f9, &msg[83], sizeof(f9));
+        memcpy(&f10, &msg[91], sizeof(f10));
+        memcpy(&f11, &msg[99], sizeof(f11));
+        memcpy(&f12, &msg[107], sizeof(f12));
+        memcpy(&f13, &msg[115], sizeof(f13));
+    }
+};
+
+struct SBRE {
+    static const char *name() { return "SBRE"; }
+    static const char *format() { return "QHIiBB"; }
+    static const char *labels() { return "TimeUS,GWk,GMS,ns_residual,level,quality"; }
+    static uint8_t length() { return 23; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+    uint64_t TimeUS;
+    uint16_t GWk;
+    uint32_t GMS;
+    int32_t ns_residual;
+    uint8_t level;
+    uint8_t quality;
+
+    void decode(const uint8_t *msg) {
+        memcpy(&TimeUS, &msg[3], sizeof(TimeUS));
+        memcpy(&GWk, &msg[11], sizeof(GWk));
+        memcpy(&GMS, &msg[13], sizeof(GMS));
+        memcpy(&ns_residual, &msg[17], sizeof(ns_residual));
+        memcpy(&level, &msg[21], sizeof(level));
+        memcpy(&quality, &msg[22], sizeof(quality));
+    }
+};
+
+} // namespace LogDecode
+
+// call X(name) for each decoder
+#define LOG_DECODE_FOREACH(X) \
+    X(FMT) \
+    X(UNIT) \
+    X(FMTU) \
+    X(MULT) \
+    X(PARM) \
+    X(GPS) \
+    X(GPS2) \
+    X(GPSB) \
+    X(GPA) \
+    X(GPA2) \
+    X(GPAB) \
+    X(IMU) \
+    X(MSG) \
+    X(RCIN) \
+    X(RCOU) \
+    X(RSSI) \
+    X(BARO) \
+    X(POWR) \
+    X(CMD) \
+    X(MAVC) \
+    X(RAD) \
+    X(CAM) \
+    X(TRIG) \
+    X(ARSP) \
+    X(ASP2) \
+    X(BAT) \
+    X(BCL) \
+    X(ATT) \
+    X(MAG) \
+    X(MODE) \
+    X(RFND) \
+    X(DMS) \
+    X(BCN) \
+    X(PRX) \
+    X(PM) \
+    X(SLAT) \
+    X(LWC) \
+    X(TSCH) \
+    X(SRTL) \
+    X(OABR) \
+    X(OADJ) \
+    X(IMU2) \
+    X(IMU3) \
+    X(AHR2) \
+    X(POS) \
+    X(SIM) \
+    X(NKF1) \
+    X(NKF2) \
+    X(NKF3) \
+    X(NKF4) \
+    X(NKF5) \
+    X(NKF0) \
+    X(NKQ) \
+    X(XKF1) \
+    X(XKF2) \
+    X(XKF3) \
+    X(XKF4) \
+    X(XKF5) \
+    X(XKF0) \
+    X(XKQ) \
+    X(XKFD) \
+    X(XKV1) \
+    X(XKV2) \
+    X(TERR) \
+    X(UBX1) \
+    X(UBX2) \
+    X(UBY1) \
+    X(UBY2) \
+    X(GRAW) \
+    X(GRXH) \
+    X(GRXS) \
+    X(SBFE) \
+    X(ESC1) \
+    X(ESC2) \
+    X(ESC3) \
+    X(ESC4) \
+    X(ESC5) \
+    X(ESC6) \
+    X(ESC7) \
+    X(ESC8) \
+    X(CSRV) \
+    X(CESC) \
+    X(MAG2) \
+    X(MAG3) \
+    X(ACC1) \
+    X(ACC2) \
+    X(ACC3) \
+    X(GYR1) \
+    X(GYR2) \
+    X(GYR3) \
+    X(PIDR) \
+    X(PIDP) \
+    X(PIDY) \
+    X(PIDA) \
+    X(PIDS) \
+    X(DSTL) \
+    X(BAR2) \
+    X(BAR3) \
+    X(VIBE) \
+    X(IMT) \
+    X(IMT2) \
+    X(IMT3) \
+    X(ISBH) \
+    X(ISBD) \
+    X(DBAT) \
+    X(ORGN) \
+    X(DSF) \
+    X(RPM) \
+    X(GMB1) \
+    X(GMB2) \
+    X(RATE) \
+    X(RALY) \
+    X(MAV) \
+    X(VISO) \
+    X(VISP) \
+    X(OF) \
+    X(WENC) \
+    X(ADSB) \
+    X(EV) \
+    X(ARM) \
+    X(ERR) \
+    X(SBPH) \
+    X(SBRH) \
+    X(SBRM) \
+    X(SBRE)
@@ -0,0 +1,259 @@
+/*
+  column-wise delta encoding of batches of log messages
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LogDeltaBatch.h"
+
+#include <AP_Common/AP_Common.h>
+#include <string.h>
+
+// values are loaded as little-endian integers of their field's width,
+// floats included, so the encoding is exact for every field type
+static inline uint64_t load_word(const uint8_t *p, uint8_t size)
+{
+    uint64_t v = 0;
+    memcpy(&v, p, size);
+    return v;
+}
+
+static inline void store_word(uint8_t *p, uint8_t size, uint64_t v)
+{
+    memcpy(p, &v, size);
+}
+
+// difference between two values of size bytes, zigzag encoded so
+// that small negative differences are small numbers
+static inline uint64_t zigzag_delta(uint64_t value, uint64_t prev, uint8_t size)
+{
+    const uint8_t shift = 64 - 8*size;
+    const int64_t d = int64_t((value - prev) << shift) >> shift;
+    return (uint64_t(d) << 1) ^ uint64_t(d >> 63);
+}
+
+static inline uint64_t unzigzag(uint64_t z)
+{
+    return (z >> 1) ^ -(z & 1);
+}
+
+static inline uint8_t varint_len(uint64_t v)
+{
+    uint8_t len = 1;
+    while (v >= 0x80) {
+        v >>= 7;
+        len++;
+    }
+    return len;
+}
+
+bool LogDeltaFormat::init(const char *fmt, uint8_t fmt_len)
+{
+    num_fields = 0;
+    _body_len = 0;
+    uint16_t body_len = 0;
+    uint16_t max_encoded_len = 0;
+    for (uint8_t i=0; i<fmt_len && fmt[i] != 0; i++) {
+        if (num_fields >= ARRAY_SIZE(fields)) {
+            return false;
+        }
+        Field &f = fields[num_fields++];
+        f.word_count = 1;
+        switch (fmt[i]) {
+        case 'a':
+            f.word_size = 2;
+            f.word_count = 32;
+            break;
+        case 'b':
+        case 'B':
+        case 'M':
+            f.word_size = 1;
+            break;
+        case 'c':
+        case 'C':
+        case 'h':
+        case 'H':
+            f.word_size = 2;
+            break;
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'i':
+        case 'I':
+        case 'L':
+            f.word_size = 4;
+            break;
+        case 'd':
+        case 'q':
+        case 'Q':
+            f.word_size = 8;
+            break;
+        case 'n':
+            f.word_size = 1;
+            f.word_count = 4;
+            break;
+        case 'N':
+            f.word_size = 1;
+            f.word_count = 16;
+            break;
+        case 'Z':
+            f.word_size = 1;
+            f.word_count = 64;
+            break;
+        default:
+            return false;
+        }
+        body_len += f.word_size * f.word_count;
+        // a varint holds 7 bits per byte
+        max_encoded_len += (8*f.word_size + 6)/7 * f.word_count;
+    }
+    if (num_fields == 0 ||
+        body_len + LOG_PACKET_HEADER_LEN > UINT8_MAX ||
+        max_encoded_len > sizeof(log_DeltaBatch::data)) {
+        return false;
+    }
+    _body_len = body_len;
+    return true;
+}
+
+uint16_t LogDeltaFormat::encoded_len(const uint8_t *body, const uint8_t *prev) const
+{
+    uint16_t len = 0;
+    uint8_t ofs = 0;
+    for (uint8_t i=0; i<num_fields; i++) {
+        const Field &f = fields[i];
+        for (uint8_t k=0; k<f.word_count; k++, ofs += f.word_size) {
+            const uint64_t p = prev ? load_word(&prev[ofs], f.word_size) : 0;
+            len += varint_len(zigzag_delta(load_word(&body[ofs], f.word_size), p, f.word_size));
+        }
+    }
+    return len;
+}
+
+uint16_t LogDeltaFormat::encode(const uint8_t *bodies, uint8_t count, uint8_t *out, uint16_t out_size) const
+{
+    uint16_t len = 0;
+    uint8_t ofs = 0;
+    for (uint8_t i=0; i<num_fields; i++) {
+        const Field &f = fields[i];
+        for (uint8_t k=0; k<f.word_count; k++, ofs += f.word_size) {
+            // one column: this value in each message of the batch
+            uint64_t prev = 0;
+            for (uint8_t r=0; r<count; r++) {
+                const uint64_t value = load_word(&bodies[r*_body_len + ofs], f.word_size);
+                uint64_t z = zigzag_delta(value, prev, f.word_size);
+                prev = value;
+                do {
+                    if (len >= out_size) {
+                        return 0;
+                    }
+                    out[len++] = (z & 0x7F) | (z >= 0x80 ? 0x80 : 0);
+                    z >>= 7;
+                } while (z != 0);
+            }
+        }
+    }
+    return len;
+}
+
+bool LogDeltaFormat::decode(const uint8_t *in, uint16_t in_len, uint8_t count, uint8_t *bodies) const
+{
+    uint16_t pos = 0;
+    uint8_t ofs = 0;
+    for (uint8_t i=0; i<num_fields; i++) {
+        const Field &f = fields[i];
+        for (uint8_t k=0; k<f.word_count; k++, ofs += f.word_size) {
+            uint64_t prev = 0;
+            for (uint8_t r=0; r<count; r++) {
+                uint64_t z = 0;
+                uint8_t shift = 0;
+                uint8_t b;
+                do {
+                    if (pos >= in_len || shift >= 64) {
+                        return false;
+                    }
+                    b = in[pos++];
+                    z |= uint64_t(b & 0x7F) << shift;
+                    shift += 7;
+                } while (b & 0x80);
+                prev += unzigzag(z);
+                store_word(&bodies[r*_body_len + ofs], f.word_size, prev);
+            }
+        }
+    }
+    return pos == in_len;
+}
+
+LogDeltaBatch::LogDeltaBatch(const char *fmt) :
+    next(nullptr),
+    _valid(false),
+    msg_type(0),
+    count(0),
+    batch_len(0),
+    bodies(nullptr)
+{
+    if (!format.init(fmt, strlen(fmt))) {
+        return;
+    }
+    bodies = new uint8_t[LOG_DELTA_BATCH_MAX_ROWS * format.body_len()];
+    _valid = (bodies != nullptr);
+}
+
+LogDeltaBatch::~LogDeltaBatch()
+{
+    delete[] bodies;
+}
+
+bool LogDeltaBatch::flush(struct log_DeltaBatch &pkt)
+{
+    if (count == 0) {
+        return false;
+    }
+    pkt.head1 = HEAD_BYTE1;
+    pkt.head2 = HEAD_BYTE2;
+    pkt.msgid = LOG_DELTA_BATCH_MSG;
+    pkt.msg_type = msg_type;
+    pkt.count = count;
+    pkt.length = format.encode(bodies, count, pkt.data, sizeof(pkt.data));
+    memset(&pkt.data[pkt.length], 0, sizeof(pkt.data) - pkt.length);
+    count = 0;
+    batch_len = 0;
+    return true;
+}
+
+bool LogDeltaBatch::add(const void *msg, uint8_t len, struct log_DeltaBatch &pkt)
+{
+    if (!accepts(len)) {
+        return false;
+    }
+    const uint8_t *m = (const uint8_t *)msg;
+    const uint8_t *body = &m[LOG_PACKET_HEADER_LEN];
+    bool ret = false;
+
+    // a batch holds a single message type
+    if (count > 0 && m[2] != msg_type) {
+        ret = flush(pkt);
+    }
+
+    uint16_t row_len = format.encoded_len(body, count ? &bodies[(count-1)*format.body_len()] : nullptr);
+    if (count == LOG_DELTA_BATCH_MAX_ROWS || batch_len + row_len > sizeof(pkt.data)) {
+        ret = flush(pkt);
+        row_len = format.encoded_len(body, nullptr);
+    }
+
+    msg_type = m[2];
+    memcpy(&bodies[count*format.body_len()], body, format.body_len());
+    count++;
+    batch_len += row_len;
+    return ret;
+}
@@ -0,0 +1,115 @@
+/*
+  column-wise delta encoding of batches of log messages
+
+  High rate messages such as the raw IMU messages change very little
+  from one sample to the next. A batch holds up to
+  LOG_DELTA_BATCH_MAX_ROWS messages of one type and is written as a
+  single DBAT message. The batched messages are laid out column by
+  column, each value stored as the zigzag varint encoded difference from
+  the same value in the previous message of the batch. The encoding is
+  derived from the message's format string, so any message made of the
+  standard format types can be batched and decoded losslessly using the
+  FMT message already in the log.
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <AP_Common/AP_Common.h>
+#include "LogStructure.h"
+
+// maximum number of messages in one batch
+#define LOG_DELTA_BATCH_MAX_ROWS 32
+
+// the encoding of one message type, compiled from its format string
+class LogDeltaFormat
+{
+public:
+    /*
+      compile a format string of up to fmt_len characters. Returns
+      false if the format is invalid or a single message could not fit
+      in a batch
+     */
+    bool init(const char *fmt, uint8_t fmt_len);
+
+    // length of a message without its packet header
+    uint8_t body_len() const { return _body_len; }
+
+    // encoded length of one message body given the previous one in the
+    // batch, or nullptr for the first message
+    uint16_t encoded_len(const uint8_t *body, const uint8_t *prev) const;
+
+    /*
+      encode count message bodies held one after another in bodies.
+      Returns the encoded length or zero if it exceeds out_size
+     */
+    uint16_t encode(const uint8_t *bodies, uint8_t count, uint8_t *out, uint16_t out_size) const;
+
+    /*
+      decode count message bodies into bodies, which must have room for
+      count*body_len() bytes. Returns false if the data is corrupt
+     */
+    bool decode(const uint8_t *in, uint16_t in_len, uint8_t count, uint8_t *bodies) const;
+
+private:
+    // a field is word_count values of word_size bytes each, e.g. 'a'
+    // is 32 two byte values
+    struct Field {
+        uint8_t word_size;
+        uint8_t word_count;
+    } fields[16];
+    uint8_t num_fields;
+    uint8_t _body_len;
+};
+
+/*
+  accumulates messages of one type into batches
+ */
+class LogDeltaBatch
+{
+public:
+    // fmt is the format string of the messages to be batched
+    LogDeltaBatch(const char *fmt);
+    ~LogDeltaBatch();
+
+    // false if a message of len bytes can't be batched and should be
+    // written directly
+    bool accepts(uint16_t len) const {
+        return _valid && len == LOG_PACKET_HEADER_LEN + format.body_len();
+    }
+
+    /*
+      add a message, including its packet header, to the batch. If
+      the message doesn't fit then the batch so far is encoded into pkt
+      and true is returned; the message then starts the next batch
+     */
+    bool add(const void *msg, uint8_t len, struct log_DeltaBatch &pkt);
+
+    // encode the messages in the batch into pkt. Returns false if the
+    // batch is empty
+    bool flush(struct log_DeltaBatch &pkt);
+
+    // next batch in the list of the logger that allocated this one
+    LogDeltaBatch *next;
+
+private:
+    LogDeltaFormat format;
+    bool _valid;
+    uint8_t msg_type;
+    uint8_t count;
+    uint16_t batch_len;
+    // message bodies of the batch
+    uint8_t *bodies;
+};
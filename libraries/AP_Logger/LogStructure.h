@@ -278,6 +278,16 @@ struct PACKED log_ISBD {
 };
 static_assert(sizeof(log_ISBD) < 256, "log_ISBD is over-size");
 
+// a batch of delta encoded messages, see LogDeltaBatch.h
+struct PACKED log_DeltaBatch {
+    LOG_PACKET_HEADER;
+    uint8_t msg_type;
+    uint8_t count;
+    uint8_t length;
+    uint8_t data[3*sizeof(int16_t[32])];
+};
+static_assert(sizeof(log_DeltaBatch) < 256, "log_DeltaBatch is over-size");
+
 struct PACKED log_Vibe {
     LOG_PACKET_HEADER;
     uint64_t time_us;
@@ -1185,6 +1195,34 @@ struct PACKED log_Performance {
     uint32_t extra_loop_us;
 };
 
+struct PACKED log_SchedLatency {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint32_t avg_lateness_us;
+    uint32_t max_lateness_us;
+};
+
+struct PACKED log_WriteContention {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint32_t retries;
+    uint32_t busy;
+};
+
+struct PACKED log_TaskInfo {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t task_id;
+    char name[16];
+    uint32_t tick_count;
+    uint16_t min_time_us;
+    uint16_t avg_time_us;
+    uint16_t p99_time_us;
+    uint16_t max_time_us;
+    uint32_t slip_count;
+    uint32_t overrun_count;
+};
+
 struct PACKED log_SRTL {
     LOG_PACKET_HEADER;
     uint64_t time_us;
@@ -1901,6 +1939,18 @@ struct PACKED log_Arm_Disarm {
 // @Field: I2CI: Number of i2c interrupts serviced
 // @Field: ExUS: number of microseconds being added to each loop to address scheduler overruns
 
+// @LoggerMessage: SLAT
+// @Description: Scheduler task latency, used to compare scheduling policies
+// @Field: TimeUS: Time since system startup
+// @Field: TLat: average time between scheduler tasks becoming due and starting to run
+// @Field: TLatM: maximum time between a scheduler task becoming due and starting to run
+
+// @LoggerMessage: LWC
+// @Description: Contention between threads writing log messages
+// @Field: TimeUS: Time since system startup
+// @Field: LRet: number of times a log write had to retry reserving buffer space because another thread was writing
+// @Field: LBsy: number of log writes dropped because too many other threads were writing at once
+
 // @LoggerMessage: POS
 // @Description: Canonical vehicle position
 // @Field: TimeUS: Time since system startup
@@ -2064,6 +2114,28 @@ struct PACKED log_Arm_Disarm {
 // @Field: Pending: Number of tile requests outstanding
 // @Field: Loaded: Number of tiles in memory
 
+// @LoggerMessage: TSCH
+// @Description: Scheduler task execution time statistics, enabled by SCHED_OPTIONS
+// @Field: TimeUS: Time since system startup
+// @Field: Id: task index in the scheduler table
+// @Field: Name: task name
+// @Field: N: number of times the task has run
+// @Field: Min: minimum task execution time
+// @Field: Avg: average task execution time
+// @Field: P99: 99th percentile task execution time, estimated from a log2 scaled histogram so may read up to twice the true value
+// @Field: Max: maximum task execution time
+// @Field: Slip: number of times the task missed a whole scheduled run
+// @Field: Ovr: number of times the task ran longer than its time allowance
+
+// @LoggerMessage: DBAT
+// @Description: Batch of delta encoded messages, see LogDeltaBatch.h for the encoding
+// @Field: Type: message type of the batched messages
+// @Field: N: number of messages in the batch
+// @Field: Len: number of bytes of data used
+// @Field: D0: encoded data
+// @Field: D1: encoded data
+// @Field: D2: encoded data
+
 // @LoggerMessage: TSYN
 // @Description: Time synchronisation response information
 // @Field: TimeUS: Time since system startup
@@ -2362,6 +2434,12 @@ struct PACKED log_Arm_Disarm {
       "PRX", "QBfffffffffff", "TimeUS,Health,D0,D45,D90,D135,D180,D225,D270,D315,DUp,CAn,CDis", "s-mmmmmmmmmhm", "F-00000000000" }, \
     { LOG_PERFORMANCE_MSG, sizeof(log_Performance),                     \
       "PM",  "QHHIIHIIIIII", "TimeUS,NLon,NLoop,MaxT,Mem,Load,IntE,IntEC,SPIC,I2CC,I2CI,ExUS", "s---b%-----s", "F---0A-----F" }, \
+    { LOG_SCHED_LATENCY_MSG, sizeof(log_SchedLatency),                  \
+      "SLAT", "QII", "TimeUS,TLat,TLatM", "sss", "FFF" }, \
+    { LOG_WRITE_CONTENTION_MSG, sizeof(log_WriteContention),            \
+      "LWC", "QII", "TimeUS,LRet,LBsy", "s--", "F--" }, \
+    { LOG_TASKINFO_MSG, sizeof(log_TaskInfo),                           \
+      "TSCH", "QBNIHHHHII", "TimeUS,Id,Name,N,Min,Avg,P99,Max,Slip,Ovr", "s---ssss--", "F---FFFF--" }, \
     { LOG_SRTL_MSG, sizeof(log_SRTL), \
       "SRTL", "QBHHBfff", "TimeUS,Active,NumPts,MaxPts,Action,N,E,D", "s----mmm", "F----000" }, \
     { LOG_OA_BENDYRULER_MSG, sizeof(log_OABendyRuler), \
@@ -2492,6 +2570,8 @@ struct PACKED log_Arm_Disarm {
       "ISBH",ISBH_FMT,ISBH_LABELS,ISBH_UNITS,ISBH_MULTS },  \
     { LOG_ISBD_MSG, sizeof(log_ISBD), \
       "ISBD",ISBD_FMT,ISBD_LABELS, ISBD_UNITS, ISBD_MULTS }, \
+    { LOG_DELTA_BATCH_MSG, sizeof(log_DeltaBatch), \
+      "DBAT", "BBBaaa", "Type,N,Len,D0,D1,D2", "------", "------" }, \
     { LOG_ORGN_MSG, sizeof(log_ORGN), \
       "ORGN","QBLLe","TimeUS,Type,Lat,Lng,Alt", "s-DUm", "F-GGB" },   \
     { LOG_DF_FILE_STATS, sizeof(log_DSF), \
@@ -2664,8 +2744,12 @@ enum LogMessages : uint8_t {
     LOG_SRTL_MSG,
     LOG_ISBH_MSG,
     LOG_ISBD_MSG,
+    LOG_DELTA_BATCH_MSG,
     LOG_ASP2_MSG,
     LOG_PERFORMANCE_MSG,
+    LOG_SCHED_LATENCY_MSG,
+    LOG_WRITE_CONTENTION_MSG,
+    LOG_TASKINFO_MSG,
     LOG_OPTFLOW_MSG,
     LOG_EVENT_MSG,
     LOG_WHEELENCODER_MSG,
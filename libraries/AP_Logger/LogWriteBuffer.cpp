@@ -0,0 +1,208 @@
+/*
+  lock-free multi-producer single-consumer byte buffer for log writes
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LogWriteBuffer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define POS_BITS 24
+#define POS_MASK ((1U<<POS_BITS)-1)
+// buffers are limited so that positions are never ambiguous
+#define MAX_SIZE (1U<<(POS_BITS-1))
+
+// a committed slot holds its sequence number and message length
+#define SLOT_COMMITTED (1U<<31)
+
+static inline uint32_t pack(uint8_t seq, uint32_t pos)
+{
+    return (uint32_t(seq) << POS_BITS) | pos;
+}
+
+static inline uint8_t get_seq(uint32_t v)
+{
+    return v >> POS_BITS;
+}
+
+static inline uint32_t get_pos(uint32_t v)
+{
+    return v & POS_MASK;
+}
+
+LogWriteBuffer::LogWriteBuffer(uint32_t _size) :
+    buf(nullptr),
+    size(0),
+    pos_modulus(1)
+{
+    set_size(_size);
+}
+
+LogWriteBuffer::~LogWriteBuffer(void)
+{
+    free(buf);
+}
+
+bool LogWriteBuffer::set_size(uint32_t _size)
+{
+    if (_size > MAX_SIZE) {
+        return false;
+    }
+    if (_size != size) {
+        free(buf);
+        buf = (uint8_t*)calloc(1, _size);
+        size = buf ? _size : 0;
+    }
+    pos_modulus = size ? size * ((POS_MASK+1) / size) : 1;
+    _reserve = 0;
+    _commit = 0;
+    _read_pos = 0;
+    for (uint8_t i=0; i<LOG_WRITE_BUFFER_SLOTS; i++) {
+        slots[i] = 0;
+    }
+    return size != 0 || _size == 0;
+}
+
+uint32_t LogWriteBuffer::pos_add(uint32_t pos, uint32_t n) const
+{
+    return (pos + n) % pos_modulus;
+}
+
+uint32_t LogWriteBuffer::pos_diff(uint32_t from, uint32_t to) const
+{
+    return (to + pos_modulus - from) % pos_modulus;
+}
+
+uint32_t LogWriteBuffer::space(void) const
+{
+    return size - pos_diff(_read_pos, get_pos(_reserve));
+}
+
+bool LogWriteBuffer::write(const uint8_t *data, uint16_t len)
+{
+    if (len == 0) {
+        return true;
+    }
+
+    // reserve a sequence number and len bytes
+    uint32_t reserve = _reserve;
+    uint8_t seq;
+    uint32_t pos;
+    while (true) {
+        seq = get_seq(reserve);
+        pos = get_pos(reserve);
+        if (uint8_t(seq - get_seq(_commit)) >= LOG_WRITE_BUFFER_SLOTS) {
+            // the slot for this sequence number is still in use
+            _busy++;
+            return false;
+        }
+        if (size - pos_diff(_read_pos, pos) < len) {
+            return false;
+        }
+        if (_reserve.compare_exchange_weak(reserve, pack(seq+1, pos_add(pos, len)))) {
+            break;
+        }
+        _retries++;
+    }
+
+    // copy in the message, wrapping at the end of the buffer
+    const uint32_t ofs = pos % size;
+    const uint32_t n = size - ofs;
+    if (n >= len) {
+        memcpy(&buf[ofs], data, len);
+    } else {
+        memcpy(&buf[ofs], data, n);
+        memcpy(buf, &data[n], len - n);
+    }
+
+    // publish it
+    slots[seq % LOG_WRITE_BUFFER_SLOTS] = SLOT_COMMITTED | (uint32_t(seq) << 16) | len;
+    advance_commit();
+    return true;
+}
+
+/*
+  move the commit word past all consecutive committed
+  reservations. Any writer may do this on behalf of the others; the
+  sequentially consistent slot store and commit load in write() mean
+  that at least one of two racing writers sees the other's commit
+ */
+void LogWriteBuffer::advance_commit(void)
+{
+    uint32_t commit = _commit;
+    while (get_seq(commit) != get_seq(_reserve)) {
+        const uint8_t seq = get_seq(commit);
+        const uint32_t slot = slots[seq % LOG_WRITE_BUFFER_SLOTS];
+        if ((slot & SLOT_COMMITTED) == 0 || uint8_t(slot >> 16) != seq) {
+            // not committed yet; its writer will advance when it is
+            return;
+        }
+        const uint32_t next = pack(seq+1, pos_add(get_pos(commit), slot & 0xFFFF));
+        if (_commit.compare_exchange_weak(commit, next)) {
+            commit = next;
+        }
+    }
+}
+
+uint32_t LogWriteBuffer::available(void) const
+{
+    return pos_diff(_read_pos, get_pos(_commit));
+}
+
+const uint8_t *LogWriteBuffer::readptr(uint32_t &available_bytes)
+{
+    available_bytes = available();
+    if (available_bytes == 0) {
+        return nullptr;
+    }
+    const uint32_t ofs = _read_pos % size;
+    if (available_bytes > size - ofs) {
+        available_bytes = size - ofs;
+    }
+    return &buf[ofs];
+}
+
+bool LogWriteBuffer::advance(uint32_t n)
+{
+    if (n > available()) {
+        return false;
+    }
+    _read_pos = pos_add(_read_pos, n);
+    return true;
+}
+
+uint32_t LogWriteBuffer::read(uint8_t *data, uint32_t len)
+{
+    uint32_t ret = 0;
+    while (ret < len) {
+        uint32_t n;
+        const uint8_t *p = readptr(n);
+        if (p == nullptr) {
+            break;
+        }
+        if (n > len - ret) {
+            n = len - ret;
+        }
+        memcpy(&data[ret], p, n);
+        advance(n);
+        ret += n;
+    }
+    return ret;
+}
+
+void LogWriteBuffer::clear(void)
+{
+    _read_pos = get_pos(_commit);
+}
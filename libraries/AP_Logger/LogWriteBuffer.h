@@ -0,0 +1,114 @@
+/*
+  lock-free multi-producer single-consumer byte buffer for log writes
+
+  Any thread may write log messages without taking a lock. A writer
+  reserves space for its message by compare-and-swap on the reserve
+  word, copies the message in and then publishes it by setting the
+  commit flag in the slot of its reservation sequence number. Messages
+  become readable in reservation order: whichever writer finds the
+  oldest outstanding reservation committed advances the commit word
+  past it, so a writer preempted part way through a copy delays the
+  reader but never blocks other writers.
+
+  There is a single reader, the logging IO thread.
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+// maximum number of writes which may be in progress at once
+#define LOG_WRITE_BUFFER_SLOTS 64
+
+class LogWriteBuffer
+{
+public:
+    LogWriteBuffer(uint32_t size);
+    ~LogWriteBuffer(void);
+
+    /*
+      writer interface, safe to call from any thread
+     */
+
+    // write a message of len bytes. Returns false if it was dropped
+    // for lack of space or because too many writes are in progress
+    bool write(const uint8_t *data, uint16_t len);
+
+    // number of bytes space available to write
+    uint32_t space(void) const;
+
+    // failed reservation attempts due to another writer reserving
+    // at the same time
+    uint32_t get_retries(void) const { return _retries; }
+
+    // writes dropped because LOG_WRITE_BUFFER_SLOTS writes were
+    // already in progress
+    uint32_t get_busy(void) const { return _busy; }
+
+    /*
+      reader interface, only to be called from the reading thread
+     */
+
+    // number of committed bytes available to be read
+    uint32_t available(void) const;
+
+    // pointer to the next committed bytes and the number of them
+    // which are contiguous
+    const uint8_t *readptr(uint32_t &available_bytes);
+
+    // discard n bytes which have been read
+    bool advance(uint32_t n);
+
+    // read up to len bytes, returns the number read
+    uint32_t read(uint8_t *data, uint32_t len);
+
+    // discard all committed bytes
+    void clear(void);
+
+    /*
+      size management, not safe while there are writers
+     */
+    bool set_size(uint32_t size);
+    uint32_t get_size(void) const { return size; }
+
+private:
+    uint8_t *buf;
+    uint32_t size;
+
+    // positions run modulo a multiple of the buffer size which fits
+    // in 24 bits, leaving room for an 8 bit sequence number
+    uint32_t pos_modulus;
+
+    uint32_t pos_add(uint32_t pos, uint32_t n) const;
+    uint32_t pos_diff(uint32_t from, uint32_t to) const;
+
+    // [seq:8 | pos:24] of the next reservation
+    std::atomic<uint32_t> _reserve{0};
+    // [seq:8 | pos:24] of the oldest reservation not yet committed;
+    // all bytes before pos are readable
+    std::atomic<uint32_t> _commit{0};
+    // position of the next byte to read
+    std::atomic<uint32_t> _read_pos{0};
+
+    // commit flags, indexed by sequence number
+    std::atomic<uint32_t> slots[LOG_WRITE_BUFFER_SLOTS];
+
+    // contention counters
+    std::atomic<uint32_t> _retries{0};
+    std::atomic<uint32_t> _busy{0};
+
+    void advance_commit(void);
+};
@@ -0,0 +1,69 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Logger/AP_Logger.h>
+
+/*
+  compare the per-call cost of writing a runtime format message by
+  name, which looks the format up on every call, against writing
+  through a handle from RegisterFormat(). Other formats are registered
+  first so the name lookup walks a list of realistic length. No
+  backends are started, so this measures the frontend cost only
+ */
+
+static AP_Int32 log_bitmask;
+static AP_Logger logger{log_bitmask};
+
+#define REGISTER_OTHER(name) logger.RegisterFormat(name, "TimeUS,A,B,C", "s---", "F---", "Qfff")
+
+static void register_other_formats()
+{
+    static bool done;
+    if (done) {
+        return;
+    }
+    done = true;
+    REGISTER_OTHER("BM00");
+    REGISTER_OTHER("BM01");
+    REGISTER_OTHER("BM02");
+    REGISTER_OTHER("BM03");
+    REGISTER_OTHER("BM04");
+    REGISTER_OTHER("BM05");
+    REGISTER_OTHER("BM06");
+    REGISTER_OTHER("BM07");
+    REGISTER_OTHER("BM08");
+    REGISTER_OTHER("BM09");
+    REGISTER_OTHER("BM10");
+    REGISTER_OTHER("BM11");
+    REGISTER_OTHER("BM12");
+    REGISTER_OTHER("BM13");
+    REGISTER_OTHER("BM14");
+    REGISTER_OTHER("BM15");
+}
+
+static void BM_WriteByName(benchmark::State& state)
+{
+    uint64_t t = 0;
+    // register this format before the others so it is at the end of
+    // the list
+    logger.RegisterFormat("BMN", "TimeUS,Roll,Pitch,Yaw,Id", "sddd-", "F000-", "QfffB");
+    register_other_formats();
+    while (state.KeepRunning()) {
+        logger.Write("BMN", "TimeUS,Roll,Pitch,Yaw,Id", "sddd-", "F000-", "QfffB",
+                     t++, 1.0f, 2.0f, 3.0f, 4);
+    }
+}
+
+static void BM_WriteRegistered(benchmark::State& state)
+{
+    uint64_t t = 0;
+    AP_Logger::FormatHandle f = logger.RegisterFormat("BMR", "TimeUS,Roll,Pitch,Yaw,Id", "sddd-", "F000-", "QfffB");
+    register_other_formats();
+    while (state.KeepRunning()) {
+        logger.WriteRegistered(f, t++, 1.0f, 2.0f, 3.0f, 4);
+    }
+}
+
+BENCHMARK(BM_WriteByName);
+BENCHMARK(BM_WriteRegistered);
+
+BENCHMARK_MAIN()
@@ -0,0 +1,192 @@
+#!/usr/bin/env python
+'''
+generate typed decoders for the messages in LogStructure.h
+
+Each message in LOG_COMMON_STRUCTURES gets a struct with one member
+per field, named after the field label, and a decode() which copies
+every field from its fixed offset in the message. A log can carry a
+different format for a message than the one compiled in, so matches()
+checks the log's FMT message before a decoder is used.
+
+Run from this directory after changing LogStructure.h:
+   ./gen_log_decoders.py
+'''
+
+import optparse, re, sys
+
+parser = optparse.OptionParser("gen_log_decoders.py [options]")
+parser.add_option("--input", type='string', default='../LogStructure.h', help='log structure header')
+parser.add_option("--output", type='string', default='../LogDecoders.h', help='generated header')
+
+opts, args = parser.parse_args()
+
+# C type and element count of each format character
+FORMAT_TYPES = {
+    'a': ('int16_t', 32),
+    'b': ('int8_t', 1),
+    'B': ('uint8_t', 1),
+    'h': ('int16_t', 1),
+    'H': ('uint16_t', 1),
+    'i': ('int32_t', 1),
+    'I': ('uint32_t', 1),
+    'f': ('float', 1),
+    'd': ('double', 1),
+    'n': ('char', 4),
+    'N': ('char', 16),
+    'Z': ('char', 64),
+    'c': ('int16_t', 1),
+    'C': ('uint16_t', 1),
+    'e': ('int32_t', 1),
+    'E': ('uint32_t', 1),
+    'L': ('int32_t', 1),
+    'M': ('uint8_t', 1),
+    'q': ('int64_t', 1),
+    'Q': ('uint64_t', 1),
+}
+
+TYPE_SIZES = {
+    'int8_t': 1, 'uint8_t': 1, 'char': 1,
+    'int16_t': 2, 'uint16_t': 2,
+    'int32_t': 4, 'uint32_t': 4, 'float': 4,
+    'int64_t': 8, 'uint64_t': 8, 'double': 8,
+}
+
+CPP_KEYWORDS = set(['int', 'char', 'float', 'double', 'long', 'short', 'signed', 'unsigned',
+                    'auto', 'new', 'delete', 'default', 'case', 'switch', 'for', 'do',
+                    'if', 'else', 'while', 'return', 'class', 'struct', 'union', 'this',
+                    'const', 'static', 'volatile', 'register', 'goto', 'break', 'continue',
+                    'matches', 'decode', 'name', 'format', 'labels', 'length'])
+
+LOG_PACKET_HEADER_LEN = 3
+
+def read_defines(text):
+    '''find string #defines, e.g. IMU_FMT'''
+    defines = {}
+    for m in re.finditer(r'^#define\s+(\w+)\s+"([^"]*)"\s*$', text, re.MULTILINE):
+        defines[m.group(1)] = m.group(2)
+    return defines
+
+def read_structures(text, macro):
+    '''get the body of a structure table macro with continuations joined'''
+    m = re.search(r'^#define\s+%s\s*\\\n((?:.*\\\n)*.*\n)' % macro, text, re.MULTILINE)
+    if m is None:
+        print("Failed to find %s" % macro)
+        sys.exit(1)
+    return m.group(1).replace('\\\n', ' ')
+
+def resolve(token, defines):
+    '''a string literal or the name of a string #define'''
+    token = token.strip()
+    if token.startswith('"'):
+        # adjacent literals are concatenated
+        return ''.join(re.findall(r'"([^"]*)"', token))
+    if token in defines:
+        return defines[token]
+    return None
+
+def field_name(label):
+    '''C++ member name for a field label'''
+    name = re.sub(r'[^A-Za-z0-9_]', '_', label)
+    if name[0].isdigit() or name in CPP_KEYWORDS:
+        name = 'f' + name
+    return name
+
+def parse_messages(text, defines):
+    '''list of (name, format, labels) in table order'''
+    body = ' '.join([read_structures(text, m) for m in ['LOG_BASE_STRUCTURES', 'LOG_SBP_STRUCTURES']])
+    messages = []
+    for m in re.finditer(r'\{\s*(\w+)\s*,\s*sizeof\((\w+)\)\s*,([^}]*)\}', body):
+        parts = re.findall(r'"[^"]*"|\w+', m.group(3))
+        if len(parts) < 3:
+            print("Failed to parse %s" % m.group(1))
+            sys.exit(1)
+        name = resolve(parts[0], defines)
+        fmt = resolve(parts[1], defines)
+        labels = resolve(parts[2], defines)
+        if name is None or fmt is None or labels is None:
+            print("Failed to resolve %s" % m.group(1))
+            sys.exit(1)
+        messages.append((name, fmt, labels))
+    return messages
+
+def emit_message(out, name, fmt, labels):
+    '''emit the decoder for one message'''
+    label_list = labels.split(',')
+    if len(label_list) != len(fmt):
+        print("%s: %u labels for %u fields" % (name, len(label_list), len(fmt)))
+        sys.exit(1)
+    members = []
+    ofs = LOG_PACKET_HEADER_LEN
+    for (label, c) in zip(label_list, fmt):
+        if c not in FORMAT_TYPES:
+            print("%s: unknown format type %s" % (name, c))
+            sys.exit(1)
+        (ctype, count) = FORMAT_TYPES[c]
+        members.append((field_name(label), ctype, count, ofs))
+        ofs += TYPE_SIZES[ctype] * count
+    if len(set([m[0] for m in members])) != len(members):
+        print("%s: duplicate labels %s" % (name, labels))
+        sys.exit(1)
+
+    out.write('''
+struct %s {
+    static const char *name() { return "%s"; }
+    static const char *format() { return "%s"; }
+    static const char *labels() { return "%s"; }
+    static uint8_t length() { return %u; }
+    static bool matches(const struct log_Format &f) { return format_matches(f, length(), format(), labels()); }
+
+''' % (name, name, fmt, labels, ofs))
+    for (member, ctype, count, ofs) in members:
+        if count == 1:
+            out.write('    %s %s;\n' % (ctype, member))
+        else:
+            out.write('    %s %s[%u];\n' % (ctype, member, count))
+    out.write('\n    void decode(const uint8_t *msg) {\n')
+    for (member, ctype, count, ofs) in members:
+        out.write('        memcpy(&%s, &msg[%u], sizeof(%s));\n' % (member, ofs, member))
+    out.write('    }\n};\n')
+
+def generate():
+    text = open(opts.input).read()
+    defines = read_defines(text)
+    messages = parse_messages(text, defines)
+
+    out = open(opts.output, 'w')
+    out.write('''// auto generated decoders, don't manually edit. See README.md for details.
+#pragma once
+
+/*
+  typed decoders for the messages in LogStructure.h, generated by
+  generator/gen_log_decoders.py. Check a decoder with matches() against
+  the FMT message of the log being read before using it.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <AP_Common/AP_Common.h>
+#include "LogStructure.h"
+
+namespace LogDecode {
+
+// true if the format of a message in a log is the one compiled in
+static inline bool format_matches(const struct log_Format &f, uint8_t length,
+                                  const char *format, const char *labels)
+{
+    return f.length == length &&
+        strncmp(f.format, format, sizeof(f.format)) == 0 &&
+        strncmp(f.labels, labels, sizeof(f.labels)) == 0;
+}
+''')
+    for (name, fmt, labels) in messages:
+        emit_message(out, name, fmt, labels)
+    out.write('\n} // namespace LogDecode\n')
+
+    # a list of all decoders for code which handles every message
+    out.write('\n// call X(name) for each decoder\n#define LOG_DECODE_FOREACH(X) \\\n')
+    out.write(' \\\n'.join(['    X(%s)' % m[0] for m in messages]))
+    out.write('\n')
+    out.close()
+    print("Generated %u decoders in %s" % (len(messages), opts.output))
+
+generate()
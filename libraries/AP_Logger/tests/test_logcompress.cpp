@@ -0,0 +1,216 @@
+#include <AP_gtest.h>
+
+#include <AP_Logger/LogCompress.h>
+#include <AP_Math/AP_Math.h>
+#include <string.h>
+
+/*
+  check that compressed logs read back the same as they were written
+ */
+
+// decompressor reading from a buffer in memory
+class MemDecompressor : public LogDecompressor
+{
+public:
+    MemDecompressor(const uint8_t *_buf, uint32_t _len) :
+        buf(_buf),
+        len(_len) {}
+
+protected:
+    ssize_t read_raw(void *dst, uint32_t count) override {
+        const uint32_t n = MIN(count, len - pos);
+        memcpy(dst, &buf[pos], n);
+        pos += n;
+        return n;
+    }
+    bool seek_raw(uint32_t ofs) override {
+        if (ofs > len) {
+            return false;
+        }
+        pos = ofs;
+        return true;
+    }
+
+private:
+    const uint8_t *buf;
+    uint32_t len;
+    uint32_t pos = 0;
+};
+
+// fill buf with something resembling a stream of log messages
+static void make_log_data(uint8_t *buf, uint32_t len)
+{
+    uint32_t seed = 1;
+    for (uint32_t i = 0; i < len; i++) {
+        seed = seed * 1103515245U + 12345U;
+        switch (i % 32) {
+        case 0:
+            buf[i] = 0xA3;
+            break;
+        case 1:
+            buf[i] = 0x95;
+            break;
+        case 2:
+            buf[i] = 0x81;
+            break;
+        default:
+            // mostly constant fields with some noise
+            buf[i] = (i % 32) < 24 ? (i % 32) : (seed >> 24);
+            break;
+        }
+    }
+}
+
+// write a compressed log into out, returns its length. The header
+// covers the first header_blocks blocks, as if it was last updated
+// after they were written
+static uint32_t compress_log(const uint8_t *data, uint32_t len, uint8_t *out, uint32_t header_blocks)
+{
+    LogCompressor compressor;
+    EXPECT_TRUE(compressor.init());
+    struct log_compress_header hdr { LOG_COMPRESS_MAGIC, 0, 0 };
+    uint32_t out_len = sizeof(hdr);
+    uint32_t blocks = 0;
+    for (uint32_t ofs = 0; ofs < len; ) {
+        const uint16_t n = MIN(len - ofs, uint32_t(LOG_COMPRESS_BLOCK_MAX));
+        out_len += compressor.compress_block(&data[ofs], n, &out[out_len]);
+        ofs += n;
+        if (++blocks <= header_blocks) {
+            hdr.data_size = ofs;
+            hdr.data_end = out_len;
+        }
+    }
+    memcpy(out, &hdr, sizeof(hdr));
+    return out_len;
+}
+
+// the header of a cleanly closed log covers every block
+static const uint32_t CLOSED_CLEANLY = UINT32_MAX;
+
+TEST(LogCompressTest, RoundTrip)
+{
+    const uint32_t len = 3*LOG_COMPRESS_BLOCK_MAX + 123;
+    uint8_t data[len];
+    make_log_data(data, len);
+
+    uint8_t compressed[len + 4*LOG_COMPRESS_BLOCK_BOUND];
+    const uint32_t clen = compress_log(data, len, compressed, CLOSED_CLEANLY);
+    EXPECT_LT(clen, len / 2);
+
+    MemDecompressor reader(compressed, clen);
+    uint8_t out[len];
+    uint32_t out_len = 0;
+    ssize_t n;
+    // odd sized reads cross block boundaries
+    while ((n = reader.read(&out[out_len], MIN(len - out_len, 1000U))) > 0) {
+        out_len += n;
+    }
+    EXPECT_EQ(0, n);
+    EXPECT_EQ(len, out_len);
+    EXPECT_EQ(0, memcmp(data, out, len));
+
+    uint32_t size = 0;
+    EXPECT_TRUE(reader.get_data_size(clen, size));
+    EXPECT_EQ(len, size);
+}
+
+TEST(LogCompressTest, Incompressible)
+{
+    uint8_t data[LOG_COMPRESS_BLOCK_MAX];
+    uint32_t seed = 7;
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        seed = seed * 1103515245U + 12345U;
+        data[i] = seed >> 24;
+    }
+    LogCompressor compressor;
+    ASSERT_TRUE(compressor.init());
+    uint8_t block[LOG_COMPRESS_BLOCK_BOUND];
+    // random data is stored rather than growing
+    EXPECT_EQ(LOG_COMPRESS_BLOCK_BOUND, compressor.compress_block(data, sizeof(data), block));
+    struct log_compress_block blk;
+    memcpy(&blk, block, sizeof(blk));
+    EXPECT_EQ(0U, blk.comp_len);
+}
+
+TEST(LogCompressTest, Seek)
+{
+    const uint32_t len = 4*LOG_COMPRESS_BLOCK_MAX;
+    uint8_t data[len];
+    make_log_data(data, len);
+    uint8_t compressed[len + 4*LOG_COMPRESS_BLOCK_BOUND];
+    const uint32_t clen = compress_log(data, len, compressed, CLOSED_CLEANLY);
+
+    MemDecompressor reader(compressed, clen);
+    uint8_t out[100];
+    // forwards over whole blocks, then backwards
+    const uint32_t offsets[] { 3*LOG_COMPRESS_BLOCK_MAX + 5, LOG_COMPRESS_BLOCK_MAX - 50, 0, len - 10 };
+    for (const uint32_t ofs : offsets) {
+        ASSERT_TRUE(reader.seek(ofs));
+        const uint32_t expected = MIN(uint32_t(sizeof(out)), len - ofs);
+        EXPECT_EQ(ssize_t(expected), reader.read(out, sizeof(out)));
+        EXPECT_EQ(0, memcmp(&data[ofs], out, expected));
+    }
+}
+
+TEST(LogCompressTest, TruncatedLog)
+{
+    const uint32_t len = 2*LOG_COMPRESS_BLOCK_MAX;
+    uint8_t data[len];
+    make_log_data(data, len);
+    uint8_t compressed[len + 4*LOG_COMPRESS_BLOCK_BOUND];
+    const uint32_t clen = compress_log(data, len, compressed, 0);
+
+    // lose the end of the last block, as happens on power loss
+    MemDecompressor sizer(compressed, clen - 10);
+    uint32_t size = 0;
+    EXPECT_TRUE(sizer.get_data_size(clen - 10, size));
+    EXPECT_EQ(uint32_t(LOG_COMPRESS_BLOCK_MAX), size);
+
+    MemDecompressor reader(compressed, clen - 10);
+    uint8_t out[len];
+    EXPECT_EQ(ssize_t(LOG_COMPRESS_BLOCK_MAX), reader.read(out, len));
+    EXPECT_EQ(0, reader.read(out, len));
+    EXPECT_EQ(0, memcmp(data, out, LOG_COMPRESS_BLOCK_MAX));
+}
+
+TEST(LogCompressTest, HeaderUpdatedWhileLogging)
+{
+    const uint32_t len = 3*LOG_COMPRESS_BLOCK_MAX;
+    uint8_t data[len];
+    make_log_data(data, len);
+    uint8_t compressed[len + 4*LOG_COMPRESS_BLOCK_BOUND];
+    const uint32_t clen = compress_log(data, len, compressed, 1);
+
+    // the blocks covered by the header are not read, so corrupting
+    // the first block header doesn't change the size
+    compressed[sizeof(struct log_compress_header)] ^= 0xFF;
+
+    // the last block is incomplete and not counted
+    MemDecompressor sizer(compressed, clen - 10);
+    uint32_t size = 0;
+    EXPECT_TRUE(sizer.get_data_size(clen - 10, size));
+    EXPECT_EQ(uint32_t(2*LOG_COMPRESS_BLOCK_MAX), size);
+}
+
+TEST(LogCompressTest, Uncompressed)
+{
+    const uint32_t len = 1000;
+    uint8_t data[len];
+    make_log_data(data, len);
+
+    // plain logs are passed through
+    MemDecompressor sizer(data, len);
+    uint32_t size;
+    EXPECT_FALSE(sizer.get_data_size(len, size));
+
+    MemDecompressor reader(data, len);
+    uint8_t out[len];
+    EXPECT_EQ(ssize_t(3), reader.read(out, 3));
+    EXPECT_EQ(ssize_t(len - 3), reader.read(&out[3], len));
+    EXPECT_EQ(0, memcmp(data, out, len));
+    ASSERT_TRUE(reader.seek(500));
+    EXPECT_EQ(ssize_t(10), reader.read(out, 10));
+    EXPECT_EQ(0, memcmp(&data[500], out, 10));
+}
+
+AP_GTEST_MAIN()
@@ -0,0 +1,97 @@
+#include <AP_gtest.h>
+
+#include <AP_Logger/LogDecoders.h>
+#include <AP_Math/AP_Math.h>
+#include <string.h>
+
+/*
+  check the generated decoders against the structures they decode
+ */
+
+static const struct LogStructure log_structure[] = {
+    LOG_COMMON_STRUCTURES
+};
+
+static const struct LogStructure *find_structure(const char *name)
+{
+    for (uint16_t i=0; i<ARRAY_SIZE(log_structure); i++) {
+        if (strcmp(log_structure[i].name, name) == 0) {
+            return &log_structure[i];
+        }
+    }
+    return nullptr;
+}
+
+// the FMT message a log would contain for a structure
+static struct log_Format format_for(const struct LogStructure &s)
+{
+    struct log_Format f {};
+    f.type = s.msg_type;
+    f.length = s.msg_len;
+    strncpy(f.name, s.name, sizeof(f.name));
+    strncpy(f.format, s.format, sizeof(f.format));
+    strncpy(f.labels, s.labels, sizeof(f.labels));
+    return f;
+}
+
+// a decoder which is out of date with LogStructure.h fails here
+TEST(LogDecodersTest, MatchStructures)
+{
+#define CHECK_DECODER(msg) {                                            \
+        const struct LogStructure *s = find_structure(#msg);            \
+        ASSERT_NE(nullptr, s);                                          \
+        EXPECT_EQ(s->msg_len, LogDecode::msg::length()) << #msg;        \
+        EXPECT_TRUE(LogDecode::msg::matches(format_for(*s))) << #msg;   \
+    }
+    LOG_DECODE_FOREACH(CHECK_DECODER)
+#undef CHECK_DECODER
+}
+
+TEST(LogDecodersTest, FormatMismatch)
+{
+    struct log_Format f = format_for(*find_structure("IMU"));
+    EXPECT_TRUE(LogDecode::IMU::matches(f));
+    // an older log with a field fewer
+    f.length -= 2;
+    f.format[strlen(f.format)-1] = 0;
+    EXPECT_FALSE(LogDecode::IMU::matches(f));
+}
+
+TEST(LogDecodersTest, DecodeIMU)
+{
+    const struct log_IMU pkt {
+        LOG_PACKET_HEADER_INIT(LOG_IMU_MSG),
+        time_us       : 123456789,
+        gyro_x        : 0.1f,
+        gyro_y        : -0.2f,
+        gyro_z        : 0.3f,
+        accel_x       : 1.5f,
+        accel_y       : -2.5f,
+        accel_z       : -9.8f,
+        gyro_error    : 7,
+        accel_error   : 8,
+        temperature   : 42.5f,
+        gyro_health   : 1,
+        accel_health  : 0,
+        gyro_rate     : 1000,
+        accel_rate    : 2000
+    };
+    LogDecode::IMU imu;
+    imu.decode((const uint8_t *)&pkt);
+    EXPECT_EQ(123456789U, imu.TimeUS);
+    EXPECT_FLOAT_EQ(0.1f, imu.GyrX);
+    EXPECT_FLOAT_EQ(-0.2f, imu.GyrY);
+    EXPECT_FLOAT_EQ(0.3f, imu.GyrZ);
+    EXPECT_FLOAT_EQ(1.5f, imu.AccX);
+    EXPECT_FLOAT_EQ(-2.5f, imu.AccY);
+    EXPECT_FLOAT_EQ(-9.8f, imu.AccZ);
+    EXPECT_EQ(7U, imu.EG);
+    EXPECT_EQ(8U, imu.EA);
+    EXPECT_FLOAT_EQ(42.5f, imu.T);
+    EXPECT_EQ(1U, imu.GH);
+    EXPECT_EQ(0U, imu.AH);
+    EXPECT_EQ(1000U, imu.GHz);
+    EXPECT_EQ(2000U, imu.AHz);
+}
+
+AP_GTEST_MAIN()
@@ -0,0 +1,134 @@
+#include <AP_gtest.h>
+
+#include <AP_Logger/LogDeltaBatch.h>
+#include <AP_Math/AP_Math.h>
+#include <string.h>
+
+/*
+  check that delta batched messages decode to the messages written
+ */
+
+// feed messages through a batch, decoding each batch as it is written
+class BatchChecker
+{
+public:
+    BatchChecker(const char *fmt) :
+        batch(fmt)
+    {
+        EXPECT_TRUE(format.init(fmt, strlen(fmt)));
+    }
+
+    void add(const void *msg, uint8_t len) {
+        ASSERT_TRUE(batch.accepts(len));
+        ASSERT_LT(sent, ARRAY_SIZE(msgs));
+        memcpy(msgs[sent++], msg, len);
+        struct log_DeltaBatch pkt;
+        if (batch.add(msg, len, pkt)) {
+            check(pkt, len);
+        }
+    }
+
+    void flush(uint8_t len) {
+        struct log_DeltaBatch pkt;
+        if (batch.flush(pkt)) {
+            check(pkt, len);
+        }
+        EXPECT_EQ(sent, received);
+    }
+
+    uint32_t batches = 0;
+    uint32_t received = 0;
+
+private:
+    void check(const struct log_DeltaBatch &pkt, uint8_t len) {
+        EXPECT_EQ(LOG_DELTA_BATCH_MSG, pkt.msgid);
+        EXPECT_LE(pkt.count, LOG_DELTA_BATCH_MAX_ROWS);
+        uint8_t bodies[LOG_DELTA_BATCH_MAX_ROWS * 256];
+        ASSERT_TRUE(format.decode(pkt.data, pkt.length, pkt.count, bodies));
+        for (uint8_t i=0; i<pkt.count; i++) {
+            EXPECT_EQ(msgs[received][2], pkt.msg_type);
+            EXPECT_EQ(0, memcmp(&msgs[received][LOG_PACKET_HEADER_LEN],
+                                &bodies[i*format.body_len()],
+                                len - LOG_PACKET_HEADER_LEN));
+            received++;
+        }
+        batches++;
+    }
+
+    LogDeltaBatch batch;
+    LogDeltaFormat format;
+    uint8_t msgs[1000][256];
+    uint32_t sent = 0;
+};
+
+TEST(LogDeltaBatchTest, GyroSamples)
+{
+    BatchChecker *checker = new BatchChecker(GYR_FMT);
+    uint32_t seed = 3;
+    for (uint16_t i = 0; i < 1000; i++) {
+        seed = seed * 1103515245U + 12345U;
+        // a 1kHz gyro whose samples are 16 bit readings scaled to rad/s
+        const float scale = radians(2000.0f / 32768.0f);
+        const struct log_GYRO pkt {
+            LOG_PACKET_HEADER_INIT(LOG_GYR1_MSG),
+            time_us   : 1000000U + i * 1000U + (seed >> 28),
+            sample_us : 1000000U + i * 1000U,
+            GyrX      : int16_t(200 * sinf(i * 0.01f)) * scale,
+            GyrY      : int16_t((seed >> 24) & 0x7) * scale,
+            GyrZ      : -int16_t(i) * scale,
+        };
+        checker->add(&pkt, sizeof(pkt));
+    }
+    checker->flush(sizeof(log_GYRO));
+    EXPECT_EQ(1000U, checker->received);
+    // the batches take much less space than the messages
+    EXPECT_LT(checker->batches * sizeof(log_DeltaBatch), 1000U * sizeof(log_GYRO) / 2);
+    delete checker;
+}
+
+TEST(LogDeltaBatchTest, AllFieldTypes)
+{
+    const char *fmt = "abBhHiIfdnqQLMc";
+    LogDeltaFormat format;
+    ASSERT_TRUE(format.init(fmt, strlen(fmt)));
+    const uint8_t len = LOG_PACKET_HEADER_LEN + format.body_len();
+
+    BatchChecker *checker = new BatchChecker(fmt);
+    uint8_t msg[256];
+    uint32_t seed = 11;
+    for (uint16_t i = 0; i < 100; i++) {
+        msg[0] = HEAD_BYTE1;
+        msg[1] = HEAD_BYTE2;
+        msg[2] = 200;
+        // arbitrary bytes exercise wrap around of every field width
+        for (uint8_t j = LOG_PACKET_HEADER_LEN; j < len; j++) {
+            seed = seed * 1103515245U + 12345U;
+            msg[j] = seed >> 24;
+        }
+        checker->add(msg, len);
+    }
+    checker->flush(len);
+    EXPECT_EQ(100U, checker->received);
+    delete checker;
+}
+
+TEST(LogDeltaBatchTest, Rejects)
+{
+    LogDeltaFormat format;
+    // unknown format character
+    EXPECT_FALSE(format.init("Qx", 2));
+    // too big to fit a single message in a batch
+    EXPECT_FALSE(format.init("aaa", 3));
+
+    LogDeltaBatch batch(GYR_FMT);
+    EXPECT_TRUE(batch.accepts(sizeof(log_GYRO)));
+    EXPECT_FALSE(batch.accepts(sizeof(log_GYRO) + 1));
+
+    // corrupt data is detected
+    ASSERT_TRUE(format.init(GYR_FMT, strlen(GYR_FMT)));
+    const uint8_t data[] { 0x80, 0x80 };
+    uint8_t bodies[LOG_DELTA_BATCH_MAX_ROWS * 256];
+    EXPECT_FALSE(format.decode(data, sizeof(data), 1, bodies));
+}
+
+AP_GTEST_MAIN()
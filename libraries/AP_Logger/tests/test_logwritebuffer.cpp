@@ -0,0 +1,113 @@
+#include <AP_gtest.h>
+
+#include <AP_Logger/LogWriteBuffer.h>
+#include <string.h>
+#include <thread>
+
+/*
+  check the lock-free log write buffer
+ */
+
+TEST(LogWriteBufferTest, WrapAround)
+{
+    LogWriteBuffer buffer(100);
+    EXPECT_EQ(100U, buffer.get_size());
+    EXPECT_EQ(100U, buffer.space());
+
+    uint8_t msg[30];
+    uint8_t out[30];
+    for (uint8_t i = 0; i < 7; i++) {
+        memset(msg, i, sizeof(msg));
+        ASSERT_TRUE(buffer.write(msg, sizeof(msg)));
+        EXPECT_EQ(sizeof(msg), buffer.available());
+        EXPECT_EQ(sizeof(out), buffer.read(out, sizeof(out)));
+        EXPECT_EQ(0, memcmp(msg, out, sizeof(msg)));
+    }
+
+    // the buffer can be filled completely
+    ASSERT_TRUE(buffer.write(msg, sizeof(msg)));
+    ASSERT_TRUE(buffer.write(msg, sizeof(msg)));
+    ASSERT_TRUE(buffer.write(msg, sizeof(msg)));
+    EXPECT_EQ(10U, buffer.space());
+    EXPECT_FALSE(buffer.write(msg, sizeof(msg)));
+    ASSERT_TRUE(buffer.write(msg, 10));
+    EXPECT_EQ(0U, buffer.space());
+
+    // contiguous reads stop at the end of the buffer
+    uint32_t n;
+    const uint8_t *p = buffer.readptr(n);
+    ASSERT_NE(nullptr, p);
+    EXPECT_EQ(100U - (7*30) % 100, n);
+    EXPECT_TRUE(buffer.advance(n));
+    EXPECT_EQ(100U - n, buffer.available());
+
+    buffer.clear();
+    EXPECT_EQ(0U, buffer.available());
+    EXPECT_EQ(100U, buffer.space());
+    EXPECT_EQ(nullptr, buffer.readptr(n));
+}
+
+/*
+  several threads write numbered messages while another reads them;
+  every message must arrive whole and each thread's messages in order
+ */
+TEST(LogWriteBufferTest, ConcurrentWriters)
+{
+    const uint8_t num_writers = 4;
+    const uint32_t num_msgs = 20000;
+    LogWriteBuffer buffer(1000);
+
+    std::thread writers[num_writers];
+    for (uint8_t w = 0; w < num_writers; w++) {
+        writers[w] = std::thread([&buffer, w]() {
+            for (uint32_t i = 0; i < num_msgs; ) {
+                // message length varies with the writer
+                uint8_t msg[8 + num_writers];
+                msg[0] = w;
+                memcpy(&msg[1], &i, sizeof(i));
+                memset(&msg[5], 0xA5, sizeof(msg) - 5);
+                if (buffer.write(msg, 8 + w)) {
+                    i++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    uint32_t next[num_writers] {};
+    uint32_t received = 0;
+    uint8_t pending[8 + num_writers];
+    uint8_t pending_len = 0;
+    while (received < num_writers * num_msgs) {
+        uint8_t b;
+        if (buffer.read(&b, 1) == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        pending[pending_len++] = b;
+        ASSERT_LT(pending[0], num_writers);
+        const uint8_t w = pending[0];
+        if (pending_len < 8 + w) {
+            continue;
+        }
+        uint32_t i;
+        memcpy(&i, &pending[1], sizeof(i));
+        ASSERT_EQ(next[w], i);
+        for (uint8_t k = 5; k < pending_len; k++) {
+            ASSERT_EQ(0xA5, pending[k]);
+        }
+        next[w]++;
+        received++;
+        pending_len = 0;
+    }
+
+    for (uint8_t w = 0; w < num_writers; w++) {
+        writers[w].join();
+        EXPECT_EQ(num_msgs, next[w]);
+    }
+    EXPECT_EQ(0U, buffer.available());
+    EXPECT_EQ(1000U, buffer.space());
+}
+
+AP_GTEST_MAIN()
@@ -93,6 +93,27 @@ float *mat_mul(float *A, float *B, uint8_t n);
 // matrix algebra
 bool inverse(float x[], float y[], uint16_t dim) WARN_IF_UNUSED;
 
+// y = H*P for a 1xn observation matrix H, non-zero only at the H_nnz
+// indexes in H_idx, and a row major nxn matrix P with a row stride of
+// stride elements. For a symmetric P this is also P*H'
+void mat_sparse_row_mul(const float *H, const uint8_t *H_idx, uint8_t H_nnz,
+                        const float *P, uint8_t n, uint8_t stride, float *y);
+
+// P = P - K*y' for a symmetric P, keeping P symmetric by subtracting the
+// symmetric part 0.5*(K*y' + y*K') from the upper triangle and mirroring
+// it into the lower. When check_variances is true and any diagonal
+// element would become negative P is left unmodified and false is returned
+bool mat_sym_rank1_sub(float *P, uint8_t n, uint8_t stride,
+                       const float *K, const float *y, bool check_variances) WARN_IF_UNUSED;
+
+// the above for an nxn P with a row stride of n, with n fixed at compile
+// time. Only instantiated for n of 24, the EKF state count
+template <uint8_t n>
+void mat_sparse_row_mul(const float *H, const uint8_t *H_idx, uint8_t H_nnz,
+                        const float *P, float *y);
+template <uint8_t n>
+bool mat_sym_rank1_sub(float *P, const float *K, const float *y, bool check_variances) WARN_IF_UNUSED;
+
 /*
  * Constrain an angle to be within the range: -180 to 180 degrees. The second
  * parameter changes the units. Default: 1 == degrees, 10 == dezi,
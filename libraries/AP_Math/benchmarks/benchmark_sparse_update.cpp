@@ -0,0 +1,97 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+
+/*
+  compare a 24 state Kalman covariance correction P = P - K*H*P done
+  with a dense KH and KHP, as the EKF fusion routines used to, against
+  the sparse row and symmetric rank one kernels. H has the sparsity of
+  a magnetometer observation (states 0-3 and 16-21)
+ */
+
+static float P[24][24];
+static float KH[24][24];
+static float KHP[24][24];
+static float K[24];
+static float H[24];
+static const uint8_t H_idx[] = {0, 1, 2, 3, 16, 17, 18, 19, 20, 21};
+
+static void setup_covariance()
+{
+    for (uint8_t i=0; i<24; i++) {
+        K[i] = 1.0e-4f * (i+1);
+        H[i] = ((i <= 3) || (i >= 16 && i <= 21)) ? 0.1f : 0.0f;
+        for (uint8_t j=0; j<24; j++) {
+            P[i][j] = (i == j) ? 1.0f : 1.0e-3f * (i+j);
+        }
+    }
+}
+
+static void BM_SparseUpdateDense(benchmark::State& state)
+{
+    setup_covariance();
+    while (state.KeepRunning()) {
+        for (uint8_t i=0; i<24; i++) {
+            for (uint8_t j=0; j<24; j++) {
+                KH[i][j] = K[i] * H[j];
+            }
+        }
+        for (uint8_t j=0; j<24; j++) {
+            for (uint8_t i=0; i<24; i++) {
+                float res = 0;
+                for (uint8_t k=0; k<ARRAY_SIZE(H_idx); k++) {
+                    res += KH[i][H_idx[k]] * P[H_idx[k]][j];
+                }
+                KHP[i][j] = res;
+            }
+        }
+        for (uint8_t i=0; i<24; i++) {
+            for (uint8_t j=0; j<24; j++) {
+                P[i][j] = P[i][j] - KHP[i][j];
+            }
+        }
+        for (uint8_t i=1; i<24; i++) {
+            for (uint8_t j=0; j<i; j++) {
+                float temp = 0.5f*(P[i][j] + P[j][i]);
+                P[i][j] = temp;
+                P[j][i] = temp;
+            }
+        }
+        gbenchmark_escape(&P);
+    }
+}
+
+static void BM_SparseUpdateKernels(benchmark::State& state)
+{
+    float HP[24];
+    setup_covariance();
+    while (state.KeepRunning()) {
+        mat_sparse_row_mul(H, H_idx, ARRAY_SIZE(H_idx), &P[0][0], 24, 24, HP);
+        bool ok = mat_sym_rank1_sub(&P[0][0], 24, 24, K, HP, true);
+        gbenchmark_escape(&ok);
+        gbenchmark_escape(&P);
+    }
+}
+
+/*
+  the same kernels with the state count fixed at compile time. EKF2
+  and EKF3 share the runtime sized kernels, and use these when all 24
+  states are active
+ */
+static void BM_SparseUpdateKernelsFixed(benchmark::State& state)
+{
+    float HP[24];
+    setup_covariance();
+    while (state.KeepRunning()) {
+        mat_sparse_row_mul<24>(H, H_idx, ARRAY_SIZE(H_idx), &P[0][0], HP);
+        bool ok = mat_sym_rank1_sub<24>(&P[0][0], K, HP, true);
+        gbenchmark_escape(&ok);
+        gbenchmark_escape(&P);
+    }
+}
+
+BENCHMARK(BM_SparseUpdateDense);
+BENCHMARK(BM_SparseUpdateKernels);
+BENCHMARK(BM_SparseUpdateKernelsFixed);
+
+BENCHMARK_MAIN()
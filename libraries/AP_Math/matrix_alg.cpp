@@ -438,3 +438,104 @@ bool inverse(float x[], float y[], uint16_t dim)
         default: return mat_inverse(x,y,dim);
     }
 }
+
+/*
+ *    multiply a sparse row vector by a matrix. The inner loop is a
+ *    contiguous multiply-accumulate along a row of P so that it can be
+ *    vectorised by the compiler
+ *
+ *    @param     H,       1xn row vector, only read at the indexes in H_idx
+ *    @param     H_idx,   indexes of the non-zero elements of H
+ *    @param     H_nnz,   number of non-zero elements of H
+ *    @param     P,       row major nxn matrix
+ *    @param     n,       dimension of P
+ *    @param     stride,  number of elements between the rows of P
+ *    @param     y,       output 1xn row vector H*P
+ */
+static inline __attribute__((always_inline))
+void sparse_row_mul(const float *H, const uint8_t *H_idx, uint8_t H_nnz,
+                    const float *P, uint8_t n, uint8_t stride, float *y)
+{
+    memset(y, 0, n*sizeof(float));
+    for (uint8_t k = 0; k < H_nnz; k++) {
+        const float h = H[H_idx[k]];
+        const float *row = &P[H_idx[k]*stride];
+        for (uint8_t j = 0; j < n; j++) {
+            y[j] += h * row[j];
+        }
+    }
+}
+
+/*
+ *    subtract a symmetric rank one product from a symmetric matrix
+ *
+ *    @param     P,       row major nxn symmetric matrix, updated in place
+ *    @param     n,       dimension of P
+ *    @param     stride,  number of elements between the rows of P
+ *    @param     K,       nx1 column vector
+ *    @param     y,       1xn row vector, must not alias P
+ *    @param     check_variances, reject the update if it would make any
+ *                        diagonal element of P negative
+ *    @returns            false if the update was rejected
+ */
+static inline __attribute__((always_inline))
+bool sym_rank1_sub(float *P, uint8_t n, uint8_t stride,
+                   const float *K, const float *y, bool check_variances)
+{
+    if (check_variances) {
+        for (uint8_t i = 0; i < n; i++) {
+            if (K[i] * y[i] > P[i*stride + i]) {
+                return false;
+            }
+        }
+    }
+    // K*y' is only symmetric when K is exactly P*H'/S. The EKF zeroes
+    // gains for inhibited states, so apply the symmetric part
+    // 0.5*(K*y' + y*K') to the upper triangle and mirror it. This gives
+    // the same result as the full update followed by forcing symmetry
+    for (uint8_t i = 0; i < n; i++) {
+        const float k = K[i];
+        const float yi = y[i];
+        float *row = &P[i*stride];
+        row[i] -= k * yi;
+        for (uint8_t j = i+1; j < n; j++) {
+            row[j] -= 0.5f * (k * y[j] + K[j] * yi);
+            P[j*stride + i] = row[j];
+        }
+    }
+    return true;
+}
+
+void mat_sparse_row_mul(const float *H, const uint8_t *H_idx, uint8_t H_nnz,
+                        const float *P, uint8_t n, uint8_t stride, float *y)
+{
+    sparse_row_mul(H, H_idx, H_nnz, P, n, stride, y);
+}
+
+bool mat_sym_rank1_sub(float *P, uint8_t n, uint8_t stride,
+                       const float *K, const float *y, bool check_variances)
+{
+    return sym_rank1_sub(P, n, stride, K, y, check_variances);
+}
+
+/*
+ *    the same kernels with the dimension fixed at compile time. The
+ *    loops then have constant bounds, which lets the compiler unroll and
+ *    vectorise them where it optimises for speed
+ */
+template <uint8_t n>
+void mat_sparse_row_mul(const float *H, const uint8_t *H_idx, uint8_t H_nnz,
+                        const float *P, float *y)
+{
+    sparse_row_mul(H, H_idx, H_nnz, P, n, n, y);
+}
+
+template <uint8_t n>
+bool mat_sym_rank1_sub(float *P, const float *K, const float *y, bool check_variances)
+{
+    return sym_rank1_sub(P, n, n, K, y, check_variances);
+}
+
+template void mat_sparse_row_mul<24>(const float *H, const uint8_t *H_idx, uint8_t H_nnz,
+                                     const float *P, float *y);
+template bool mat_sym_rank1_sub<24>(float *P, const float *K, const float *y, bool check_variances);
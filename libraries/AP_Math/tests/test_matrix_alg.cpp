@@ -0,0 +1,114 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+
+/*
+  check the sparse Kalman covariance update kernels against a dense
+  evaluation of P = P - K*H*P
+ */
+
+#define N 10
+#define STRIDE 12
+
+static const uint8_t H_idx[] = {1, 2, 7};
+
+static void setup(float P[N*STRIDE], float H[N], float K[N])
+{
+    for (uint8_t i = 0; i < N; i++) {
+        H[i] = 0.0f;
+        K[i] = 0.02f * (i+1);
+        for (uint8_t j = 0; j < STRIDE; j++) {
+            P[i*STRIDE + j] = (i == j) ? 2.0f : 0.01f * (i+j);
+        }
+    }
+    H[1] = 0.5f;
+    H[2] = -1.5f;
+    H[7] = 0.25f;
+}
+
+TEST(MatrixAlgTest, SparseRowMul)
+{
+    float P[N*STRIDE], H[N], K[N], y[N];
+    setup(P, H, K);
+
+    mat_sparse_row_mul(H, H_idx, ARRAY_SIZE(H_idx), P, N, STRIDE, y);
+
+    for (uint8_t j = 0; j < N; j++) {
+        float res = 0.0f;
+        for (uint8_t k = 0; k < N; k++) {
+            res += H[k] * P[k*STRIDE + j];
+        }
+        EXPECT_FLOAT_EQ(res, y[j]);
+    }
+}
+
+/*
+  check P against a dense P = P0 - K*y' followed by forcing symmetry
+  with P = 0.5*(P + P'), which is what the EKF did before the kernels
+ */
+static void check_sym_rank1_sub(const float P0[N*STRIDE], const float P[N*STRIDE], const float K[N], const float y[N])
+{
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j < N; j++) {
+            const float ref_ij = P0[i*STRIDE + j] - K[i] * y[j];
+            const float ref_ji = P0[j*STRIDE + i] - K[j] * y[i];
+            EXPECT_NEAR(0.5f * (ref_ij + ref_ji), P[i*STRIDE + j], 1.0e-6f);
+            // the result is exactly symmetric
+            EXPECT_EQ(P[j*STRIDE + i], P[i*STRIDE + j]);
+        }
+        // padding beyond n columns is untouched
+        for (uint8_t j = N; j < STRIDE; j++) {
+            EXPECT_FLOAT_EQ(P0[i*STRIDE + j], P[i*STRIDE + j]);
+        }
+    }
+}
+
+TEST(MatrixAlgTest, SymRank1Sub)
+{
+    float P[N*STRIDE], P0[N*STRIDE], H[N], K[N], y[N];
+    setup(P, H, K);
+    memcpy(P0, P, sizeof(P));
+
+    mat_sparse_row_mul(H, H_idx, ARRAY_SIZE(H_idx), P, N, STRIDE, y);
+    EXPECT_TRUE(mat_sym_rank1_sub(P, N, STRIDE, K, y, true));
+
+    check_sym_rank1_sub(P0, P, K, y);
+}
+
+TEST(MatrixAlgTest, SymRank1SubInhibitedStates)
+{
+    float P[N*STRIDE], P0[N*STRIDE], H[N], K[N], y[N];
+    setup(P, H, K);
+    memcpy(P0, P, sizeof(P));
+
+    mat_sparse_row_mul(H, H_idx, ARRAY_SIZE(H_idx), P, N, STRIDE, y);
+    // the EKF zeroes the gains of inhibited states, so K*y' is not
+    // symmetric and both triangles of the update contribute
+    K[3] = K[4] = K[5] = 0.0f;
+    EXPECT_TRUE(mat_sym_rank1_sub(P, N, STRIDE, K, y, true));
+
+    check_sym_rank1_sub(P0, P, K, y);
+    // inhibited variances are not changed
+    for (uint8_t i = 3; i <= 5; i++) {
+        EXPECT_FLOAT_EQ(P0[i*STRIDE + i], P[i*STRIDE + i]);
+    }
+}
+
+TEST(MatrixAlgTest, SymRank1SubRejectsNegativeVariance)
+{
+    float P[N*STRIDE], P0[N*STRIDE], H[N], K[N], y[N];
+    setup(P, H, K);
+    memcpy(P0, P, sizeof(P));
+
+    mat_sparse_row_mul(H, H_idx, ARRAY_SIZE(H_idx), P, N, STRIDE, y);
+    // a gain large enough to drive the variance of state 2 negative
+    K[2] = -10.0f;
+    EXPECT_FALSE(mat_sym_rank1_sub(P, N, STRIDE, K, y, true));
+    EXPECT_EQ(0, memcmp(P0, P, sizeof(P)));
+
+    // without the check the update is always applied
+    EXPECT_TRUE(mat_sym_rank1_sub(P, N, STRIDE, K, y, false));
+    EXPECT_LT(P[2*STRIDE + 2], 0.0f);
+}
+
+AP_GTEST_MAIN()
@@ -78,6 +78,13 @@ public:
         , y(y0)
         , z(z0) {}
 
+    // converting ctor from a vector with another element type
+    template <typename U>
+    constexpr explicit Vector3<T>(const Vector3<U> &v)
+        : x(static_cast<T>(v.x))
+        , y(static_cast<T>(v.y))
+        , z(static_cast<T>(v.z)) {}
+
     // function call operator
     void operator ()(const T x0, const T y0, const T z0)
     {
@@ -16,10 +16,10 @@
  */
 #include "AP_NavEKF_core_common.h"
 
-NavEKF_core_common::Matrix24 NavEKF_core_common::KH;
-NavEKF_core_common::Matrix24 NavEKF_core_common::KHP;
-NavEKF_core_common::Matrix24 NavEKF_core_common::nextP;
-NavEKF_core_common::Vector28 NavEKF_core_common::Kfusion;
+EKF_SCRATCH_STORAGE NavEKF_core_common::Matrix24 NavEKF_core_common::KH;
+EKF_SCRATCH_STORAGE NavEKF_core_common::Matrix24 NavEKF_core_common::KHP;
+EKF_SCRATCH_STORAGE NavEKF_core_common::Matrix24 NavEKF_core_common::nextP;
+EKF_SCRATCH_STORAGE NavEKF_core_common::Vector28 NavEKF_core_common::Kfusion;
 
 /*
   fill common scratch variables, for detecting re-use of variables between loops in SITL
@@ -37,3 +37,23 @@ void NavEKF_core_common::fill_scratch_variables(void)
     fill_nanf(&Kfusion[0], sizeof(Kfusion)/sizeof(float));
 #endif
 }
+
+/*
+  sparse scalar measurement covariance update shared by EKF2 and EKF3.
+  K*H*P = K*(H*P) is the outer product of the gain vector with a single
+  row, so form that row once and apply it as a rank one update. Gains
+  of inhibited states are zero, so K*H*P is not always symmetric and
+  mat_sym_rank1_sub() applies its symmetric part. When all 24 states
+  are active the kernels sized at compile time are used, as the
+  compiler can vectorise those
+ */
+bool NavEKF_core_common::CovarianceUpdateSparse(Matrix24 &P, uint8_t numStates, const ftype *H, const uint8_t *H_idx, uint8_t H_nnz, bool checkVariances)
+{
+    ftype HP[24];
+    if (numStates == 24) {
+        mat_sparse_row_mul<24>(H, H_idx, H_nnz, &P[0][0], HP);
+        return mat_sym_rank1_sub<24>(&P[0][0], &Kfusion[0], HP, checkVariances);
+    }
+    mat_sparse_row_mul(H, H_idx, H_nnz, &P[0][0], numStates, 24, HP);
+    return mat_sym_rank1_sub(&P[0][0], numStates, 24, &Kfusion[0], HP, checkVariances);
+}
@@ -19,6 +19,28 @@
 #include <stdint.h>
 #include <AP_Math/AP_Math.h>
 #include <AP_Math/vectorN.h>
+#include <AP_HAL/AP_HAL_Boards.h>
+
+/*
+  EKF lanes can be run in parallel threads on Linux and SITL boards
+  with multiple CPU cores. The scratch space below is then thread local
+  so that each lane gets its own copy. That makes every access to it
+  more expensive, so lane threads are only compiled in when this is
+  defined to 1 for the build
+ */
+#ifndef EKF_LANE_THREADS_ENABLED
+#define EKF_LANE_THREADS_ENABLED 0
+#endif
+
+#if EKF_LANE_THREADS_ENABLED && CONFIG_HAL_BOARD != HAL_BOARD_LINUX && CONFIG_HAL_BOARD != HAL_BOARD_SITL
+#error "EKF lane threads are only supported on Linux and SITL"
+#endif
+
+#if EKF_LANE_THREADS_ENABLED
+#define EKF_SCRATCH_STORAGE thread_local
+#else
+#define EKF_SCRATCH_STORAGE
+#endif
 
 /*
   this declares a common parent class for AP_NavEKF2 and
@@ -42,11 +64,19 @@ public:
 #endif
 
 protected:
-    static Matrix24 KH;                   // intermediate result used for covariance updates
-    static Matrix24 KHP;                  // intermediate result used for covariance updates
-    static Matrix24 nextP;                // Predicted covariance matrix before addition of process noise to diagonals
-    static Vector28 Kfusion;              // intermediate fusion vector
+    static EKF_SCRATCH_STORAGE Matrix24 KH;       // intermediate result used for covariance updates
+    static EKF_SCRATCH_STORAGE Matrix24 KHP;      // intermediate result used for covariance updates
+    static EKF_SCRATCH_STORAGE Matrix24 nextP;    // Predicted covariance matrix before addition of process noise to diagonals
+    static EKF_SCRATCH_STORAGE Vector28 Kfusion;  // intermediate fusion vector
 
     // fill all the common scratch variables with NaN on SITL
     void fill_scratch_variables(void);
+
+    // apply the covariance correction P = P - K*H*P to states 0 to
+    // numStates-1 using the gains in Kfusion, for a scalar observation H
+    // that is non-zero only at the H_nnz indexes in H_idx. P is kept
+    // exactly symmetric by applying the symmetric part of K*H*P. When
+    // checkVariances is true the update is rejected, leaving P
+    // unmodified, if any variance would go negative
+    static bool CovarianceUpdateSparse(Matrix24 &P, uint8_t numStates, const ftype *H, const uint8_t *H_idx, uint8_t H_nnz, bool checkVariances);
 };
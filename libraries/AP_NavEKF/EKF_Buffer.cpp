@@ -0,0 +1,176 @@
+/*
+  EKF Buffer models shared by EKF2 and EKF3
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "EKF_Buffer.h"
+#include <string.h>
+
+// allocate storage for size elements, reusing an existing allocation if
+// it is big enough
+bool ekf_ring_buffer::alloc(uint32_t size)
+{
+    if (size == 0 || size > UINT8_MAX) {
+        return false;
+    }
+    if (buffer == nullptr || size > _capacity) {
+        delete[] (max_align_t *)buffer;
+        buffer = nullptr;
+        _capacity = 0;
+        // allocated as max_align_t so that any element type is aligned
+        const uint32_t units = (size * _elsize + sizeof(max_align_t) - 1) / sizeof(max_align_t);
+        max_align_t *storage = new max_align_t[units];
+        if (storage == nullptr) {
+            return false;
+        }
+        buffer = (uint8_t *)storage;
+        _capacity = size;
+    }
+    _size = size;
+    return true;
+}
+
+// zero all elements
+void ekf_ring_buffer::zero()
+{
+    if (buffer != nullptr) {
+        memset(buffer, 0, _size * _elsize);
+    }
+}
+
+// copy an element into the buffer at the given index
+void ekf_ring_buffer::set(uint8_t index, const void *element)
+{
+    memcpy(get(index), element, _elsize);
+}
+
+// initialise observation buffer, returns false when allocation has failed
+bool ekf_obs_buffer::init(uint32_t size)
+{
+    if (!alloc(size)) {
+        return false;
+    }
+    reset();
+    return true;
+}
+
+/*
+  recall the newest data that is older than sample_time and less than
+  100msec old, zeroing its time so that it cannot be used again
+ */
+bool ekf_obs_buffer::recall(void *element, uint32_t sample_time)
+{
+    if (!_new_data) {
+        return false;
+    }
+    bool success = false;
+    uint8_t tail = _tail, bestIndex = 0;
+
+    if (_head == tail) {
+        const uint32_t t = time_ms(tail);
+        if (t != 0 && t <= sample_time) {
+            // if head is equal to tail just check if the data is unused and within time horizon window
+            if ((sample_time - t) < 100) {
+                bestIndex = tail;
+                success = true;
+                _new_data = false;
+            }
+        }
+    } else {
+        while (_head != tail) {
+            // find a measurement older than the fusion time horizon that we haven't checked before
+            const uint32_t t = time_ms(tail);
+            if (t != 0 && t <= sample_time) {
+                // Find the most recent non-stale measurement that meets the time horizon criteria
+                if ((sample_time - t) < 100) {
+                    bestIndex = tail;
+                    success = true;
+                }
+            } else if (t > sample_time) {
+                break;
+            }
+            tail = (tail+1)%_size;
+        }
+    }
+
+    if (!success) {
+        return false;
+    }
+
+    memcpy(element, get(bestIndex), _elsize);
+    _tail = (bestIndex+1)%_size;
+    // make time zero to stop using it again,
+    // resolves corner case of reusing the element when head == tail
+    time_ms(bestIndex) = 0;
+    return true;
+}
+
+// write data to the head of the observation buffer
+void ekf_obs_buffer::push(const void *element)
+{
+    // Advance head to next available index
+    _head = (_head+1)%_size;
+    // New data is written at the head
+    set(_head, element);
+    _new_data = true;
+}
+
+// zeroes all data in the observation buffer
+void ekf_obs_buffer::reset()
+{
+    _head = 0;
+    _tail = 0;
+    _new_data = false;
+    zero();
+}
+
+// initialise IMU buffer, returns false when allocation has failed
+bool ekf_imu_buffer::init(uint32_t size)
+{
+    if (!alloc(size)) {
+        return false;
+    }
+    _filled = false;
+    reset();
+    return true;
+}
+
+// write data to the youngest element of the IMU buffer
+void ekf_imu_buffer::push_youngest_element(const void *element)
+{
+    // push youngest to the buffer
+    _youngest = (_youngest+1)%_size;
+    set(_youngest, element);
+    // set oldest data index
+    _oldest = (_youngest+1)%_size;
+    if (_oldest == 0) {
+        _filled = true;
+    }
+}
+
+// writes the same data to all elements in the IMU buffer
+void ekf_imu_buffer::reset_history(const void *element)
+{
+    for (uint8_t index=0; index<_size; index++) {
+        set(index, element);
+    }
+}
+
+// zeroes all data in the IMU buffer
+void ekf_imu_buffer::reset()
+{
+    _youngest = 0;
+    _oldest = 0;
+    zero();
+}
@@ -0,0 +1,211 @@
+/*
+  EKF Buffer models shared by EKF2 and EKF3
+
+  The buffer logic is implemented once on untyped storage and the
+  templates below are thin typed wrappers, so that each element type
+  and each filter does not get its own copy of the code
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <type_traits>
+
+// untyped element storage common to both buffer models
+class ekf_ring_buffer
+{
+public:
+    ekf_ring_buffer(uint16_t elsize) :
+        _elsize(elsize) {}
+
+    // returns true when the buffer has been allocated. Buffers for
+    // optional sensors are only allocated once the sensor provides data
+    bool is_allocated() const {
+        return buffer != nullptr;
+    }
+
+protected:
+    // allocate storage for size elements. The buffer may be initialised
+    // again, e.g. after a failed core setup, in which case the existing
+    // allocation is reused if it is big enough
+    bool alloc(uint32_t size);
+
+    // zero all elements
+    void zero();
+
+    void *get(uint8_t index) const {
+        return &buffer[index * _elsize];
+    }
+
+    void set(uint8_t index, const void *element);
+
+    // elements are copied with memcpy() and accessed in place through
+    // typed pointers, so the element type must be trivially copyable and
+    // need no more alignment than the storage, which is allocated in
+    // units of max_align_t. Each element is then aligned, as an element
+    // size is always a multiple of its alignment
+    template <typename element_type>
+    static constexpr bool valid_element() {
+        return std::is_trivially_copyable<element_type>::value &&
+            alignof(element_type) <= alignof(max_align_t);
+    }
+
+    uint8_t *buffer = nullptr;
+    const uint16_t _elsize;
+    uint8_t _capacity = 0;
+    uint8_t _size = 0;
+};
+
+// this buffer model is to be used for observation buffers,
+// the data is pushed into buffer like any standard ring buffer
+// return is based on the sample time provided
+class ekf_obs_buffer : public ekf_ring_buffer
+{
+public:
+    ekf_obs_buffer(uint16_t elsize, uint16_t time_offset) :
+        ekf_ring_buffer(elsize),
+        _time_offset(time_offset) {}
+
+    // initialise buffer, returns false when allocation has failed
+    bool init(uint32_t size);
+
+    /*
+     * Searches through a ring buffer and return the newest data that is older than the
+     * time specified by sample_time_ms
+     * Zeros old data so it cannot not be used again
+     * Returns false if no data can be found that is less than 100msec old
+     * The tail only ever moves forward past the samples that have been
+     * checked, so each pushed sample is visited once and the cost per
+     * recall is constant when amortised over the pushes
+    */
+    bool recall(void *element, uint32_t sample_time);
+
+    /*
+     * Writes data and timestamp to a Ring buffer and advances indices that
+     * define the location of the newest and oldest data
+    */
+    void push(const void *element);
+
+    // zeroes all data in the ring buffer
+    void reset();
+
+private:
+    uint32_t &time_ms(uint8_t index) const {
+        return *(uint32_t *)((uint8_t *)get(index) + _time_offset);
+    }
+
+    const uint16_t _time_offset;
+    uint8_t _head = 0;
+    uint8_t _tail = 0;
+    bool _new_data = false;
+};
+
+// Following buffer model is for IMU data,
+// it achieves a distance of sample size
+// between youngest and oldest
+class ekf_imu_buffer : public ekf_ring_buffer
+{
+public:
+    ekf_imu_buffer(uint16_t elsize) :
+        ekf_ring_buffer(elsize) {}
+
+    // initialise buffer, returns false when allocation has failed
+    bool init(uint32_t size);
+
+    /*
+     * Writes data to a Ring buffer and advances indices that
+     * define the location of the newest and oldest data
+    */
+    void push_youngest_element(const void *element);
+
+    // return true if the buffer has been filled at least once
+    bool is_filled(void) const {
+        return _filled;
+    }
+
+    // writes the same data to all elements in the ring buffer
+    void reset_history(const void *element);
+
+    // zeroes all data in the ring buffer
+    void reset();
+
+    // returns the index for the ring buffer oldest data
+    uint8_t get_oldest_index() const {
+        return _oldest;
+    }
+
+    // returns the index for the ring buffer youngest data
+    uint8_t get_youngest_index() const {
+        return _youngest;
+    }
+
+private:
+    uint8_t _oldest = 0;
+    uint8_t _youngest = 0;
+    bool _filled = false;
+};
+
+/*
+  typed observation buffer. element_type must be trivially copyable and
+  have a uint32_t time_ms member
+ */
+template <typename element_type>
+class obs_ring_buffer_t : public ekf_obs_buffer
+{
+public:
+    obs_ring_buffer_t() :
+        ekf_obs_buffer(sizeof(element_type), offsetof(element_type, time_ms)) {
+        static_assert(valid_element<element_type>(), "element_type must be trivially copyable and no more aligned than max_align_t");
+    }
+
+    bool recall(element_type &element, uint32_t sample_time) {
+        return ekf_obs_buffer::recall(&element, sample_time);
+    }
+
+    void push(const element_type &element) {
+        ekf_obs_buffer::push(&element);
+    }
+};
+
+// typed IMU buffer. element_type must be trivially copyable
+template <typename element_type>
+class imu_ring_buffer_t : public ekf_imu_buffer
+{
+public:
+    imu_ring_buffer_t() :
+        ekf_imu_buffer(sizeof(element_type)) {
+        static_assert(valid_element<element_type>(), "element_type must be trivially copyable and no more aligned than max_align_t");
+    }
+
+    void push_youngest_element(const element_type &element) {
+        ekf_imu_buffer::push_youngest_element(&element);
+    }
+
+    // retrieve the oldest data from the ring buffer tail. The reference
+    // is valid until the next push
+    const element_type &pop_oldest_element() const {
+        return *(const element_type *)get(get_oldest_index());
+    }
+
+    void reset_history(const element_type &element) {
+        ekf_imu_buffer::reset_history(&element);
+    }
+
+    // retrieves data from the ring buffer at a specified index
+    element_type &operator[](uint8_t index) {
+        return *(element_type *)get(index);
+    }
+};
@@ -143,43 +143,14 @@ void NavEKF2_core::FuseAirspeed()
             stateStruct.quat.rotate(stateStruct.angErr);
 
             // correct the covariance P = (I - K*H)*P
-            // take advantage of the empty columns in KH to reduce the
+            // take advantage of the empty columns in H to reduce the
             // number of operations
-            for (unsigned i = 0; i<=stateIndexLim; i++) {
-                for (unsigned j = 0; j<=2; j++) {
-                    KH[i][j] = 0.0f;
-                }
-                for (unsigned j = 3; j<=5; j++) {
-                    KH[i][j] = Kfusion[i] * H_TAS[j];
-                }
-                for (unsigned j = 6; j<=21; j++) {
-                    KH[i][j] = 0.0f;
-                }
-                for (unsigned j = 22; j<=23; j++) {
-                    KH[i][j] = Kfusion[i] * H_TAS[j];
-                }
-            }
-            for (unsigned j = 0; j<=stateIndexLim; j++) {
-                for (unsigned i = 0; i<=stateIndexLim; i++) {
-                    ftype res = 0;
-                    res += KH[i][3] * P[3][j];
-                    res += KH[i][4] * P[4][j];
-                    res += KH[i][5] * P[5][j];
-                    res += KH[i][22] * P[22][j];
-                    res += KH[i][23] * P[23][j];
-                    KHP[i][j] = res;
-                }
-            }
-            for (unsigned i = 0; i<=stateIndexLim; i++) {
-                for (unsigned j = 0; j<=stateIndexLim; j++) {
-                    P[i][j] = P[i][j] - KHP[i][j];
-                }
-            }
+            static const uint8_t H_TAS_idx[] = {3, 4, 5, 22, 23};
+            CovarianceUpdateSparse(&H_TAS[0], H_TAS_idx, ARRAY_SIZE(H_TAS_idx), false);
         }
     }
 
-    // force the covariance matrix to be symmetrical and limit the variances to prevent ill-conditioning.
-    ForceSymmetry();
+    // limit the variances to prevent ill-conditioning.
     ConstrainVariances();
 
     // stop performance timer
@@ -391,42 +362,13 @@ void NavEKF2_core::FuseSideslip()
         stateStruct.quat.rotate(stateStruct.angErr);
 
         // correct the covariance P = (I - K*H)*P
-        // take advantage of the empty columns in KH to reduce the
+        // take advantage of the empty columns in H to reduce the
         // number of operations
-        for (unsigned i = 0; i<=stateIndexLim; i++) {
-            for (unsigned j = 0; j<=5; j++) {
-                KH[i][j] = Kfusion[i] * H_BETA[j];
-            }
-            for (unsigned j = 6; j<=21; j++) {
-                KH[i][j] = 0.0f;
-            }
-            for (unsigned j = 22; j<=23; j++) {
-                KH[i][j] = Kfusion[i] * H_BETA[j];
-            }
-        }
-        for (unsigned j = 0; j<=stateIndexLim; j++) {
-            for (unsigned i = 0; i<=stateIndexLim; i++) {
-                ftype res = 0;
-                res += KH[i][0] * P[0][j];
-                res += KH[i][1] * P[1][j];
-                res += KH[i][2] * P[2][j];
-                res += KH[i][3] * P[3][j];
-                res += KH[i][4] * P[4][j];
-                res += KH[i][5] * P[5][j];
-                res += KH[i][22] * P[22][j];
-                res += KH[i][23] * P[23][j];
-                KHP[i][j] = res;
-            }
-        }
-        for (unsigned i = 0; i<=stateIndexLim; i++) {
-            for (unsigned j = 0; j<=stateIndexLim; j++) {
-                P[i][j] = P[i][j] - KHP[i][j];
-            }
-        }
+        static const uint8_t H_BETA_idx[] = {0, 1, 2, 3, 4, 5, 22, 23};
+        CovarianceUpdateSparse(&H_BETA[0], H_BETA_idx, ARRAY_SIZE(H_BETA_idx), false);
     }
 
-    // force the covariance matrix to be symmetrical and limit the variances to prevent ill-conditioning.
-    ForceSymmetry();
+    // limit the variances to prevent ill-conditioning.
     ConstrainVariances();
 
     // stop the performance timer
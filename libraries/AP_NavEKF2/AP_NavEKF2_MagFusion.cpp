@@ -668,54 +668,13 @@ void NavEKF2_core::FuseMagnetometer()
     hal.util->perf_begin(_perf_test[5]);
 
     // correct the covariance P = (I - K*H)*P
-    // take advantage of the empty columns in KH to reduce the
-    // number of operations
-    for (unsigned i = 0; i<=stateIndexLim; i++) {
-        for (unsigned j = 0; j<=2; j++) {
-            KH[i][j] = Kfusion[i] * H_MAG[j];
-        }
-        for (unsigned j = 3; j<=15; j++) {
-            KH[i][j] = 0.0f;
-        }
-        for (unsigned j = 16; j<=21; j++) {
-            KH[i][j] = Kfusion[i] * H_MAG[j];
-        }
-        for (unsigned j = 22; j<=23; j++) {
-            KH[i][j] = 0.0f;
-        }
-    }
-    for (unsigned j = 0; j<=stateIndexLim; j++) {
-        for (unsigned i = 0; i<=stateIndexLim; i++) {
-            ftype res = 0;
-            res += KH[i][0] * P[0][j];
-            res += KH[i][1] * P[1][j];
-            res += KH[i][2] * P[2][j];
-            res += KH[i][16] * P[16][j];
-            res += KH[i][17] * P[17][j];
-            res += KH[i][18] * P[18][j];
-            res += KH[i][19] * P[19][j];
-            res += KH[i][20] * P[20][j];
-            res += KH[i][21] * P[21][j];
-            KHP[i][j] = res;
-        }
-    }
-    // Check that we are not going to drive any variances negative and skip the update if so
-    bool healthyFusion = true;
-    for (uint8_t i= 0; i<=stateIndexLim; i++) {
-        if (KHP[i][i] > P[i][i]) {
-            healthyFusion = false;
-        }
-    }
+    // take advantage of the empty columns in H to reduce the
+    // number of operations, skipping the update if it would drive any
+    // variances negative
+    static const uint8_t H_MAG_idx[] = {0, 1, 2, 16, 17, 18, 19, 20, 21};
+    bool healthyFusion = CovarianceUpdateSparse(&H_MAG[0], H_MAG_idx, ARRAY_SIZE(H_MAG_idx), true);
     if (healthyFusion) {
-        // update the covariance matrix
-        for (uint8_t i= 0; i<=stateIndexLim; i++) {
-            for (uint8_t j= 0; j<=stateIndexLim; j++) {
-                P[i][j] = P[i][j] - KHP[i][j];
-            }
-        }
-
-        // force the covariance matrix to be symmetrical and limit the variances to prevent ill-conditioning.
-        ForceSymmetry();
+        // limit the variances to prevent ill-conditioning.
         ConstrainVariances();
 
         // update the states
@@ -938,38 +897,11 @@ void NavEKF2_core::fuseEulerYaw()
     }
 
     // correct the covariance using P = P - K*H*P taking advantage of the fact that only the first 3 elements in H are non zero
-    // calculate K*H*P
-    for (uint8_t row = 0; row <= stateIndexLim; row++) {
-        for (uint8_t column = 0; column <= 2; column++) {
-            KH[row][column] = Kfusion[row] * H_YAW[column];
-        }
-    }
-    for (uint8_t row = 0; row <= stateIndexLim; row++) {
-        for (uint8_t column = 0; column <= stateIndexLim; column++) {
-            float tmp = KH[row][0] * P[0][column];
-            tmp += KH[row][1] * P[1][column];
-            tmp += KH[row][2] * P[2][column];
-            KHP[row][column] = tmp;
-        }
-    }
-
-    // Check that we are not going to drive any variances negative and skip the update if so
-    bool healthyFusion = true;
-    for (uint8_t i= 0; i<=stateIndexLim; i++) {
-        if (KHP[i][i] > P[i][i]) {
-            healthyFusion = false;
-        }
-    }
+    // skipping the update if it would drive any variances negative
+    static const uint8_t H_YAW_idx[] = {0, 1, 2};
+    bool healthyFusion = CovarianceUpdateSparse(H_YAW, H_YAW_idx, ARRAY_SIZE(H_YAW_idx), true);
     if (healthyFusion) {
-        // update the covariance matrix
-        for (uint8_t i= 0; i<=stateIndexLim; i++) {
-            for (uint8_t j= 0; j<=stateIndexLim; j++) {
-                P[i][j] = P[i][j] - KHP[i][j];
-            }
-        }
-
-        // force the covariance matrix to be symmetrical and limit the variances to prevent ill-conditioning.
-        ForceSymmetry();
+        // limit the variances to prevent ill-conditioning.
         ConstrainVariances();
 
         // zero the attitude error state - by definition it is assumed to be zero before each observation fusion
@@ -1065,42 +997,14 @@ void NavEKF2_core::FuseDeclination(float declErr)
     }
 
     // correct the covariance P = (I - K*H)*P
-    // take advantage of the empty columns in KH to reduce the
-    // number of operations
-    for (unsigned i = 0; i<=stateIndexLim; i++) {
-        for (unsigned j = 0; j<=15; j++) {
-            KH[i][j] = 0.0f;
-        }
-        KH[i][16] = Kfusion[i] * H_MAG[16];
-        KH[i][17] = Kfusion[i] * H_MAG[17];
-        for (unsigned j = 18; j<=23; j++) {
-            KH[i][j] = 0.0f;
-        }
-    }
-    for (unsigned j = 0; j<=stateIndexLim; j++) {
-        for (unsigned i = 0; i<=stateIndexLim; i++) {
-            KHP[i][j] = KH[i][16] * P[16][j] + KH[i][17] * P[17][j];
-        }
-    }
-
-    // Check that we are not going to drive any variances negative and skip the update if so
-    bool healthyFusion = true;
-    for (uint8_t i= 0; i<=stateIndexLim; i++) {
-        if (KHP[i][i] > P[i][i]) {
-            healthyFusion = false;
-        }
-    }
+    // take advantage of the empty columns in H to reduce the
+    // number of operations, skipping the update if it would drive any
+    // variances negative
+    static const uint8_t H_DECL_idx[] = {16, 17};
+    bool healthyFusion = CovarianceUpdateSparse(H_MAG, H_DECL_idx, ARRAY_SIZE(H_DECL_idx), true);
 
     if (healthyFusion) {
-        // update the covariance matrix
-        for (uint8_t i= 0; i<=stateIndexLim; i++) {
-            for (uint8_t j= 0; j<=stateIndexLim; j++) {
-                P[i][j] = P[i][j] - KHP[i][j];
-            }
-        }
-
-        // force the covariance matrix to be symmetrical and limit the variances to prevent ill-conditioning.
-        ForceSymmetry();
+        // limit the variances to prevent ill-conditioning.
         ConstrainVariances();
 
         // zero the attitude error state - by definition it is assumed to be zero before each observation fusion
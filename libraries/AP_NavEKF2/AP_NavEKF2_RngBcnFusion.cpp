@@ -173,45 +173,13 @@ void NavEKF2_core::FuseRngBcn()
             lastRngBcnPassTime_ms = imuSampleTime_ms;
 
             // correct the covariance P = (I - K*H)*P
-            // take advantage of the empty columns in KH to reduce the
-            // number of operations
-            for (unsigned i = 0; i<=stateIndexLim; i++) {
-                for (unsigned j = 0; j<=5; j++) {
-                    KH[i][j] = 0.0f;
-                }
-                for (unsigned j = 6; j<=8; j++) {
-                    KH[i][j] = Kfusion[i] * H_BCN[j];
-                }
-                for (unsigned j = 9; j<=23; j++) {
-                    KH[i][j] = 0.0f;
-                }
-            }
-            for (unsigned j = 0; j<=stateIndexLim; j++) {
-                for (unsigned i = 0; i<=stateIndexLim; i++) {
-                    ftype res = 0;
-                    res += KH[i][6] * P[6][j];
-                    res += KH[i][7] * P[7][j];
-                    res += KH[i][8] * P[8][j];
-                    KHP[i][j] = res;
-                }
-            }
-            // Check that we are not going to drive any variances negative and skip the update if so
-            bool healthyFusion = true;
-            for (uint8_t i= 0; i<=stateIndexLim; i++) {
-                if (KHP[i][i] > P[i][i]) {
-                    healthyFusion = false;
-                }
-            }
+            // take advantage of the empty columns in H to reduce the
+            // number of operations, skipping the update if it would drive any
+            // variances negative
+            static const uint8_t H_BCN_idx[] = {6, 7, 8};
+            bool healthyFusion = CovarianceUpdateSparse(H_BCN, H_BCN_idx, ARRAY_SIZE(H_BCN_idx), true);
             if (healthyFusion) {
-                // update the covariance matrix
-                for (uint8_t i= 0; i<=stateIndexLim; i++) {
-                    for (uint8_t j= 0; j<=stateIndexLim; j++) {
-                        P[i][j] = P[i][j] - KHP[i][j];
-                    }
-                }
-
-                // force the covariance matrix to be symmetrical and limit the variances to prevent ill-conditioning.
-                ForceSymmetry();
+                // limit the variances to prevent ill-conditioning.
                 ConstrainVariances();
 
                 // update the states
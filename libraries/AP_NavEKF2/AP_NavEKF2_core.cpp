@@ -1471,6 +1471,14 @@ void NavEKF2_core::ForceSymmetry()
     }
 }
 
+// apply the covariance correction P = P - K*H*P for a sparse scalar observation
+// returns false without modifying P if checkVariances is set and any variance
+// would be driven negative
+bool NavEKF2_core::CovarianceUpdateSparse(const ftype *H, const uint8_t *H_idx, uint8_t H_nnz, bool checkVariances)
+{
+    return NavEKF_core_common::CovarianceUpdateSparse(P, stateIndexLim+1, H, H_idx, H_nnz, checkVariances);
+}
+
 // copy covariances across from covariance prediction calculation
 void NavEKF2_core::CopyCovariances()
 {
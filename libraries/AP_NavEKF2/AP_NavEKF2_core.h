@@ -31,7 +31,7 @@
 #include <stdio.h>
 #include <AP_Math/vectorN.h>
 #include <AP_NavEKF/AP_NavEKF_core_common.h>
-#include <AP_NavEKF2/AP_NavEKF2_Buffer.h>
+#include <AP_NavEKF/EKF_Buffer.h>
 #include <AP_InertialSensor/AP_InertialSensor.h>
 
 // GPS pre-flight check bit locations
@@ -500,6 +500,12 @@ private:
     // force symmetry on the state covariance matrix
     void ForceSymmetry();
 
+    // apply the covariance correction P = P - K*H*P for a scalar
+    // observation H that is non-zero only at the H_nnz indexes in H_idx.
+    // P is kept exactly symmetric. When checkVariances is true the update
+    // is rejected, leaving P unmodified, if any variance would go negative
+    bool CovarianceUpdateSparse(const ftype *H, const uint8_t *H_idx, uint8_t H_nnz, bool checkVariances);
+
     // copy covariances across from covariance prediction calculation and fix numerical errors
     void CopyCovariances();
 
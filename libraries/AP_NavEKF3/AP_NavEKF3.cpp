@@ -604,6 +604,16 @@ const AP_Param::GroupInfo NavEKF3::var_info[] = {
     // @Units: mGauss
     AP_GROUPINFO("MAG_EF_LIM", 56, NavEKF3, _mag_ef_limit, 50),
 
+#if EKF_LANE_THREADS_ENABLED
+    // @Param: LANE_THREADS
+    // @DisplayName: Parallel lane updates
+    // @Description: When enabled on boards with multiple CPU cores, each EKF lane after the first is updated in its own thread in parallel with the first lane. The filter equations are the same as when the lanes are updated one after the other, but as all lanes are checked against the CPU budget before any of them runs, lanes after the first skip predictions less often than in the serial update, so the filter outputs are not identical.
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    // @RebootRequired: True
+    AP_GROUPINFO("LANE_THREADS", 57, NavEKF3, _laneThreads, 0),
+#endif
+
     AP_GROUPEND
 };
 
@@ -621,17 +631,26 @@ void NavEKF3::check_log_write(void)
     if (!have_ekf_logging()) {
         return;
     }
-    if (logging.log_compass) {
+    // combine the requests from each lane
+    bool log_compass = false;
+    bool log_baro = false;
+    bool log_imu = false;
+    for (uint8_t i=0; i<num_cores; i++) {
+        log_compass |= logging.log_compass[i];
+        log_baro |= logging.log_baro[i];
+        log_imu |= logging.log_imu[i];
+        logging.log_compass[i] = false;
+        logging.log_baro[i] = false;
+        logging.log_imu[i] = false;
+    }
+    if (log_compass) {
         AP::logger().Write_Compass(imuSampleTime_us);
-        logging.log_compass = false;
     }
-    if (logging.log_baro) {
+    if (log_baro) {
         AP::logger().Write_Baro(imuSampleTime_us);
-        logging.log_baro = false;
     }
-    if (logging.log_imu) {
+    if (log_imu) {
         AP::logger().Write_IMUDT(imuSampleTime_us, _logging_mask.get());
-        logging.log_imu = false;
     }
 
     // this is an example of an ad-hoc log in EKF
@@ -668,14 +687,14 @@ bool NavEKF3::InitialiseFilter(void)
         _imuMask.set(_imuMask.get() & mask);
         
         // initialise the setup variables
-        for (uint8_t i=0; i<7; i++) {
+        for (uint8_t i=0; i<EK3_MAX_CORES; i++) {
             coreSetupRequired[i] = false;
             coreImuIndex[i] = 0;
         }
         num_cores = 0;
 
         // count IMUs from mask
-        for (uint8_t i=0; i<7; i++) {
+        for (uint8_t i=0; i<EK3_MAX_CORES; i++) {
             if (_imuMask & (1U<<i)) {
                 coreSetupRequired[num_cores] = true;
                 coreImuIndex[num_cores] = i;
@@ -739,10 +758,102 @@ bool NavEKF3::InitialiseFilter(void)
     memset((void *)&pos_reset_data, 0, sizeof(pos_reset_data));
     memset(&pos_down_reset_data, 0, sizeof(pos_down_reset_data));
 
+#if EKF_LANE_THREADS_ENABLED
+    start_lane_threads();
+#endif
+
     check_log_write();
     return ret;
 }
 
+#if EKF_LANE_THREADS_ENABLED
+/*
+  create the worker threads used to update lanes 1 and above in
+  parallel with lane 0. If any thread can't be created the lanes are
+  updated serially
+ */
+void NavEKF3::start_lane_threads(void)
+{
+    if (laneThreadsStarted || _laneThreads == 0 || num_cores < 2) {
+        return;
+    }
+    for (uint8_t i=1; i<num_cores; i++) {
+        if (laneWorker[i] != nullptr) {
+            continue;
+        }
+        laneWorker[i] = new LaneWorker(core[i]);
+        if (laneWorker[i] == nullptr || !laneWorker[i]->start()) {
+            // the worker can't be freed as its thread may be running
+            gcs().send_text(MAV_SEVERITY_WARNING, "NavEKF3: lane %u thread failed", (unsigned)i);
+            return;
+        }
+    }
+    laneThreadsStarted = true;
+}
+
+/*
+  the lanes are only independent once they all have an origin. Before
+  that an origin set by one lane is picked up by the lanes after it
+  during the same update, so run them serially to keep the output
+  identical to the serial path
+ */
+bool NavEKF3::use_lane_threads(void) const
+{
+    if (!laneThreadsStarted || _laneThreads == 0) {
+        return false;
+    }
+    for (uint8_t i=0; i<num_cores; i++) {
+        Location loc;
+        if (!core[i].getOriginLLH(loc)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool NavEKF3::LaneWorker::start(void)
+{
+    return hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&NavEKF3::LaneWorker::thread_main, void),
+                                        "EKF3lane", 8192, AP_HAL::Scheduler::PRIORITY_MAIN, 0);
+}
+
+void NavEKF3::LaneWorker::dispatch(bool _predict)
+{
+    predict = _predict;
+    start_sem.signal();
+}
+
+void NavEKF3::LaneWorker::join(void)
+{
+    done_sem.wait_blocking();
+}
+
+void NavEKF3::LaneWorker::thread_main(void)
+{
+    while (true) {
+        start_sem.wait_blocking();
+        core.UpdateFilter(predict);
+        done_sem.signal();
+    }
+}
+#endif // EKF_LANE_THREADS_ENABLED
+
+/*
+  if we have not overrun by more than 3 IMU frames, and we have
+  already used more than 1/3 of the CPU budget for this loop then
+  suppress the prediction step. This allows multiple EKF instances to
+  cooperate on scheduling
+ */
+bool NavEKF3::coreStatePredictEnabled(uint8_t core_index) const
+{
+    const AP_InertialSensor &ins = AP::ins();
+    if (core[core_index].getFramesSincePredict() < (_framesPerPrediction+3) &&
+        (AP_HAL::micros() - ins.get_last_update_usec()) > _frameTimeUsec/3) {
+        return false;
+    }
+    return true;
+}
+
 // Update Filter States - this should be called whenever new IMU data is available
 void NavEKF3::UpdateFilter(void)
 {
@@ -752,21 +863,34 @@ void NavEKF3::UpdateFilter(void)
 
     imuSampleTime_us = AP_HAL::micros64();
 
-    const AP_InertialSensor &ins = AP::ins();
-
     bool statePredictEnabled[num_cores];
-    for (uint8_t i=0; i<num_cores; i++) {
-        // if we have not overrun by more than 3 IMU frames, and we
-        // have already used more than 1/3 of the CPU budget for this
-        // loop then suppress the prediction step. This allows
-        // multiple EKF instances to cooperate on scheduling
-        if (core[i].getFramesSincePredict() < (_framesPerPrediction+3) &&
-            (AP_HAL::micros() - ins.get_last_update_usec()) > _frameTimeUsec/3) {
-            statePredictEnabled[i] = false;
-        } else {
-            statePredictEnabled[i] = true;
+#if EKF_LANE_THREADS_ENABLED
+    if (use_lane_threads()) {
+        // the CPU budget check is made for each lane just before it
+        // starts, in the same order as the serial update. Lane 0 runs
+        // in this thread so it is started after the workers.
+        // This does not give the same predictions as the serial
+        // update: there each lane is checked after the lanes before it
+        // have run, so the elapsed time includes their CPU time, while
+        // here all lanes are checked before any has run. Later lanes
+        // therefore skip predictions less often than they would in the
+        // serial update
+        statePredictEnabled[0] = coreStatePredictEnabled(0);
+        for (uint8_t i=1; i<num_cores; i++) {
+            statePredictEnabled[i] = coreStatePredictEnabled(i);
+            laneWorker[i]->dispatch(statePredictEnabled[i]);
+        }
+        core[0].UpdateFilter(statePredictEnabled[0]);
+        for (uint8_t i=1; i<num_cores; i++) {
+            laneWorker[i]->join();
+        }
+    } else
+#endif
+    {
+        for (uint8_t i=0; i<num_cores; i++) {
+            statePredictEnabled[i] = coreStatePredictEnabled(i);
+            core[i].UpdateFilter(statePredictEnabled[i]);
         }
-        core[i].UpdateFilter(statePredictEnabled[i]);
     }
 
     // If the current core selected has a bad error score or is unhealthy, switch to a healthy core with the lowest fault score
@@ -1560,7 +1684,7 @@ const char *NavEKF3::prearm_failure_reason(void) const
         return "no EKF3 cores";
     }
     for (uint8_t i = 0; i < num_cores; i++) {
-        const char * failure = core[primary].prearm_failure_reason();
+        const char * failure = core[i].prearm_failure_reason();
         if (failure != nullptr) {
             return failure;
         }
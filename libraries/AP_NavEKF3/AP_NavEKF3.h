@@ -23,10 +23,14 @@
 #include <AP_Param/AP_Param.h>
 #include <GCS_MAVLink/GCS_MAVLink.h>
 #include <AP_NavEKF/AP_Nav_Common.h>
+#include <AP_NavEKF/AP_NavEKF_core_common.h>
 #include <AP_Airspeed/AP_Airspeed.h>
 #include <AP_Compass/AP_Compass.h>
 #include <AP_Logger/LogStructure.h>
 
+// maximum number of cores (lanes), one for each bit of EK3_IMU_MASK
+#define EK3_MAX_CORES 7
+
 class NavEKF3_core;
 class AP_AHRS;
 
@@ -451,6 +455,9 @@ private:
     AP_Int8  _flowUse;              // Controls if the optical flow data is fused into the main navigation estimator and/or the terrain estimator.
     AP_Float _hrt_filt_freq;        // frequency of output observer height rate complementary filter in Hz
     AP_Int16 _mag_ef_limit;         // limit on difference between WMM tables and learned earth field.
+#if EKF_LANE_THREADS_ENABLED
+    AP_Int8  _laneThreads;          // non-zero to update the lanes in parallel threads
+#endif
 
 // Possible values for _flowUse
 #define FLOW_USE_NONE    0
@@ -487,11 +494,13 @@ private:
     const uint8_t sensorIntervalMin_ms = 50;       // The minimum allowed time between measurements from any non-IMU sensor (msec)
     const uint8_t flowIntervalMin_ms = 20;         // The minimum allowed time between measurements from optical flow sensors (msec)
 
+    // sensor log requests are held per lane, indexed by core index, so
+    // lanes updated in parallel threads never write the same flag
     struct {
-        bool enabled:1;
-        bool log_compass:1;
-        bool log_baro:1;
-        bool log_imu:1;
+        bool enabled;
+        bool log_compass[EK3_MAX_CORES];
+        bool log_baro[EK3_MAX_CORES];
+        bool log_imu[EK3_MAX_CORES];
     } logging;
 
     // time at start of current filter update
@@ -522,14 +531,18 @@ private:
     } pos_down_reset_data;
 
     bool runCoreSelection; // true when the primary core has stabilised and the core selection logic can be started
-    bool coreSetupRequired[7]; // true when this core index needs to be setup
-    uint8_t coreImuIndex[7];   // IMU index used by this core
+    bool coreSetupRequired[EK3_MAX_CORES]; // true when this core index needs to be setup
+    uint8_t coreImuIndex[EK3_MAX_CORES];   // IMU index used by this core
 
     bool inhibitGpsVertVelUse;  // true when GPS vertical velocity use is prohibited
 
     // origin set by one of the cores
     struct Location common_EKF_origin;
     bool common_origin_valid;
+
+    // protects the common origin and parameters changed by the cores,
+    // as lanes may be updated in parallel threads
+    HAL_Semaphore core_sem;
     
     // update the yaw reset data to capture changes due to a lane switch
     // new_primary - index of the ekf instance that we are about to switch to as the primary
@@ -546,6 +559,44 @@ private:
     // old_primary - index of the ekf instance that we are currently using as the primary
     void updateLaneSwitchPosDownResetData(uint8_t new_primary, uint8_t old_primary);
 
+    // check if a core may start a new state prediction cycle on this frame
+    bool coreStatePredictEnabled(uint8_t core_index) const;
+
+#if EKF_LANE_THREADS_ENABLED
+    // runs NavEKF3_core::UpdateFilter() for one lane in its own thread
+    class LaneWorker {
+    public:
+        LaneWorker(NavEKF3_core &_core) : core(_core) {}
+
+        // create the worker thread
+        bool start(void);
+
+        // start an update of the lane in the worker thread
+        void dispatch(bool predict);
+
+        // wait for the update started by dispatch() to complete
+        void join(void);
+
+    private:
+        void thread_main(void);
+
+        NavEKF3_core &core;
+        bool predict;
+        HAL_BinarySemaphore start_sem;
+        HAL_BinarySemaphore done_sem;
+    };
+
+    // workers for lanes 1 and above. Lane 0 runs in the calling thread
+    LaneWorker *laneWorker[EK3_MAX_CORES] {};
+    bool laneThreadsStarted = false;
+
+    // create the lane worker threads if enabled
+    void start_lane_threads(void);
+
+    // true if the lanes should be updated in parallel on this frame
+    bool use_lane_threads(void) const;
+#endif
+
     // logging functions shared by cores:
     void Log_Write_XKF1(uint8_t core, uint64_t time_us) const;
     void Log_Write_XKF2(uint8_t core, uint64_t time_us) const;
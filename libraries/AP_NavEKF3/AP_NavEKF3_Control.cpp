@@ -506,6 +506,7 @@ void NavEKF3_core::setOrigin(const Location &loc)
     gcs().send_text(MAV_SEVERITY_INFO, "EKF3 IMU%u origin set",(unsigned)imu_index);
 
     // put origin in frontend as well to ensure it stays in sync between lanes
+    WITH_SEMAPHORE(frontend->core_sem);
     frontend->common_EKF_origin = EKF_origin;
     frontend->common_origin_valid = true;
 }
@@ -91,7 +91,9 @@ void NavEKF3_core::readRangeFinder(void)
                 rangeDataNew.sensor_idx = sensorIndex;
 
                 // write data to buffer with time stamp to be fused when the fusion time horizon catches up with it
-                storedRange.push(rangeDataNew);
+                if (optBufferReady(OPT_BUFFER_RANGE)) {
+                    storedRange.push(rangeDataNew);
+                }
 
                 // indicate we have updated the measurement
                 rngValidMeaTime_ms = imuSampleTime_ms;
@@ -108,7 +110,9 @@ void NavEKF3_core::readRangeFinder(void)
                 }
 
                 // write data to buffer with time stamp to be fused when the fusion time horizon catches up with it
-                storedRange.push(rangeDataNew);
+                if (optBufferReady(OPT_BUFFER_RANGE)) {
+                    storedRange.push(rangeDataNew);
+                }
 
                 // indicate we have updated the measurement
                 rngValidMeaTime_ms = imuSampleTime_ms;
@@ -136,7 +140,9 @@ void NavEKF3_core::writeBodyFrameOdom(float quality, const Vector3f &delPos, con
     // TODO move this calculation outside of EKF into the sensor driver
     bodyOdmDataNew.velErr = frontend->_visOdmVelErrMin + (frontend->_visOdmVelErrMax - frontend->_visOdmVelErrMin) * (1.0f - 0.01f * quality);
 
-    storedBodyOdm.push(bodyOdmDataNew);
+    if (optBufferReady(OPT_BUFFER_BODY_ODM)) {
+        storedBodyOdm.push(bodyOdmDataNew);
+    }
 
 }
 
@@ -163,7 +169,9 @@ void NavEKF3_core::writeWheelOdom(float delAng, float delTime, uint32_t timeStam
     // the measurement time is moved back to the middle of the sampling period
     wheelOdmDataNew.time_ms = timeStamp_ms - (uint32_t)(500.0f * delTime);
 
-    storedWheelOdm.push(wheelOdmDataNew);
+    if (optBufferReady(OPT_BUFFER_WHEEL_ODM)) {
+        storedWheelOdm.push(wheelOdmDataNew);
+    }
 
 }
 
@@ -231,7 +239,9 @@ void NavEKF3_core::writeOptFlowMeas(const uint8_t rawFlowQuality, const Vector2f
         // Prevent time delay exceeding age of oldest IMU data in the buffer
         ofDataNew.time_ms = MAX(ofDataNew.time_ms,imuDataDelayed.time_ms);
         // Save data to buffer
-        storedOF.push(ofDataNew);
+        if (optBufferReady(OPT_BUFFER_OF)) {
+            storedOF.push(ofDataNew);
+        }
     }
 }
 
@@ -272,7 +282,7 @@ void NavEKF3_core::readMagData()
     
     // limit compass update rate to prevent high processor loading because magnetometer fusion is an expensive step and we could overflow the FIFO buffer
     if (use_compass() && ((compass.last_update_usec() - lastMagUpdate_us) > 1000 * frontend->sensorIntervalMin_ms)) {
-        frontend->logging.log_compass = true;
+        frontend->logging.log_compass[core_index] = true;
 
         // If the magnetometer has timed out (been rejected too long) we find another magnetometer to use if available
         // Don't do this if we are on the ground because there can be magnetic interference and we need to know if there is a problem
@@ -596,8 +606,17 @@ void NavEKF3_core::readGpsData()
             calcGpsGoodForFlight();
 
             // see if we can get an origin from the frontend
-            if (!validOrigin && frontend->common_origin_valid) {
-                setOrigin(frontend->common_EKF_origin);
+            if (!validOrigin) {
+                Location common_origin;
+                bool have_common_origin;
+                {
+                    WITH_SEMAPHORE(frontend->core_sem);
+                    have_common_origin = frontend->common_origin_valid;
+                    common_origin = frontend->common_EKF_origin;
+                }
+                if (have_common_origin) {
+                    setOrigin(common_origin);
+                }
             }
 
             // Read the GPS location in WGS-84 lat,long,height coordinates
@@ -673,7 +692,7 @@ bool NavEKF3_core::readDeltaAngle(uint8_t ins_index, Vector3f &dAng) {
 
     if (ins_index < ins.get_gyro_count()) {
         ins.get_delta_angle(ins_index,dAng);
-        frontend->logging.log_imu = true;
+        frontend->logging.log_imu[core_index] = true;
         return true;
     }
     return false;
@@ -691,7 +710,7 @@ void NavEKF3_core::readBaroData()
     // limit update rate to avoid overflowing the FIFO buffer
     const AP_Baro &baro = AP::baro();
     if (baro.get_last_update() - lastBaroReceived_ms > frontend->sensorIntervalMin_ms) {
-        frontend->logging.log_baro = true;
+        frontend->logging.log_baro[core_index] = true;
 
         baroDataNew.hgt = baro.get_altitude();
 
@@ -790,7 +809,9 @@ void NavEKF3_core::readAirSpdData()
         tasDataNew.time_ms -= localFilterTimeStep_ms/2;
 
         // Save data into the buffer to be fused when the fusion time horizon catches up with it
-        storedTAS.push(tasDataNew);
+        if (optBufferReady(OPT_BUFFER_TAS)) {
+            storedTAS.push(tasDataNew);
+        }
     }
     // Check the buffer for measurements that have been overtaken by the fusion time horizon and need to be fused
     tasDataToFuse = storedTAS.recall(tasDataDelayed,imuDataDelayed.time_ms);
@@ -893,7 +914,7 @@ void NavEKF3_core::readRngBcnData()
     }
 
     // Save data into the buffer to be fused when the fusion time horizon catches up with it
-    if (newDataToPush) {
+    if (newDataToPush && optBufferReady(OPT_BUFFER_RANGE_BEACON)) {
         storedRangeBeacon.push(rngBcnDataNew);
     }
 
@@ -925,7 +946,9 @@ void NavEKF3_core::writeEulerYawAngle(float yawAngle, float yawAngleErr, uint32_
     yawAngDataNew.type = type;
     yawAngDataNew.time_ms = timeStamp_ms;
 
-    storedYawAng.push(yawAngDataNew);
+    if (optBufferReady(OPT_BUFFER_YAW_ANG)) {
+        storedYawAng.push(yawAngDataNew);
+    }
 
     yawMeasTime_ms = timeStamp_ms;
 }
@@ -27,6 +27,11 @@ bool NavEKF3_core::healthy(void) const
     if ((imuSampleTime_ms - ekfStartTime_ms) < 1000 ) {
         return false;
     }
+    // a sensor buffer could not be allocated. In flight the failure
+    // has been reported and only that sensor's data is lost
+    if (optBufferAllocFailed && !hal.util->get_soft_armed()) {
+        return false;
+    }
     // position and height innovations must be within limits when on-ground and in a static mode of operation
     float horizErrSq = sq(innovVelPos[3]) + sq(innovVelPos[4]);
     if (onGround && (PV_AidingMode == AID_NONE) && ((horizErrSq > 1.0f) || (fabsf(hgtInnovFiltState) > 1.0f))) {
@@ -247,8 +252,8 @@ bool NavEKF3_core::getPosNE(Vector2f &posNE) const
     if (PV_AidingMode != AID_NONE) {
         // This is the normal mode of operation where we can use the EKF position states
         // correct for the IMU offset (EKF calculations are at the IMU)
-        posNE.x = outputDataNew.position.x + posOffsetNED.x;
-        posNE.y = outputDataNew.position.y + posOffsetNED.y;
+        posNE.x = (float)(outputDataNew.position.x + posOffsetNED.x);
+        posNE.y = (float)(outputDataNew.position.y + posOffsetNED.y);
         return true;
 
     } else {
@@ -291,11 +296,11 @@ bool NavEKF3_core::getPosD(float &posD) const
     // Also correct for changes to the origin height
     if ((frontend->_originHgtMode & (1<<2)) == 0) {
         // Any sensor height drift corrections relative to the WGS-84 reference are applied to the origin.
-        posD = outputDataNew.position.z + posOffsetNED.z;
+        posD = (float)(outputDataNew.position.z + posOffsetNED.z);
     } else {
         // The origin height is static and corrections are applied to the local vertical position
         // so that height returned by getLLH() = height returned by getOriginLLH - posD
-        posD = outputDataNew.position.z + posOffsetNED.z + 0.01f * (float)EKF_origin.alt - (float)ekfGpsRefHgt;
+        posD = (float)(outputDataNew.position.z + posOffsetNED.z + (double)0.01 * (double)EKF_origin.alt - ekfGpsRefHgt);
     }
 
     // Return the current height solution status
@@ -306,7 +311,7 @@ bool NavEKF3_core::getPosD(float &posD) const
 // return the estimated height of body frame origin above ground level
 bool NavEKF3_core::getHAGL(float &HAGL) const
 {
-    HAGL = terrainState - outputDataNew.position.z - posOffsetNED.z;
+    HAGL = (float)(terrainState - outputDataNew.position.z - posOffsetNED.z);
     // If we know the terrain offset and altitude, then we have a valid height above ground estimate
     return !hgtTimeout && gndOffsetValid && healthy();
 }
@@ -616,6 +621,9 @@ void NavEKF3_core::send_status_report(mavlink_channel_t chan) const
 // report the reason for why the backend is refusing to initialise
 const char *NavEKF3_core::prearm_failure_reason(void) const
 {
+    if (optBufferAllocFailed) {
+        return "EKF3 sensor buffer allocation failed";
+    }
     if (gpsGoodToAlign) {
         // we are not failing
         return nullptr;
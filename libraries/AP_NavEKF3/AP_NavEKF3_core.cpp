@@ -34,6 +34,11 @@ NavEKF3_core::NavEKF3_core(NavEKF3 *_frontend) :
     _perf_test[9] = hal.util->perf_alloc(AP_HAL::Util::PC_ELAPSED, "EK3_Test9");
     firstInitTime_ms = 0;
     lastInitFailReport_ms = 0;
+    optBuffersNeeded = 0;
+    optBuffersAllocated = 0;
+    optBuffersReported = 0;
+    optBufferAllocFailed = false;
+    optBufferAllocFail_ms = 0;
 }
 
 // setup this core backend
@@ -106,7 +111,7 @@ bool NavEKF3_core::setup_core(uint8_t _imu_index, uint8_t _core_index)
     obs_buffer_length = MIN(obs_buffer_length,imu_buffer_length);
 
     // calculate buffer size for optical flow data
-    const uint8_t flow_buffer_length = MIN((ekf_delay_ms / frontend->flowIntervalMin_ms) + 1, imu_buffer_length);
+    flow_buffer_length = MIN((ekf_delay_ms / frontend->flowIntervalMin_ms) + 1, imu_buffer_length);
 
     if(!storedGPS.init(obs_buffer_length)) {
         return false;
@@ -117,35 +122,17 @@ bool NavEKF3_core::setup_core(uint8_t _imu_index, uint8_t _core_index)
     if(!storedBaro.init(obs_buffer_length)) {
         return false;
     }
-    if(!storedTAS.init(obs_buffer_length)) {
-        return false;
-    }
-    if (!storedOF.init(flow_buffer_length)) {
-        return false;
-    }
-    if(!storedBodyOdm.init(obs_buffer_length)) {
-        return false;
-    }
-    if(!storedWheelOdm.init(imu_buffer_length)) { // initialise to same length of IMU to allow for multiple wheel sensors
-        return false;
-    }
-    if(!storedYawAng.init(obs_buffer_length)) {
-        return false;
-    }
-    // Note: the use of dual range finders potentially doubles the amount of data to be stored
-    if(!storedRange.init(MIN(2*obs_buffer_length , imu_buffer_length))) {
-        return false;
-    }
-    // Note: range beacon data is read one beacon at a time and can arrive at a high rate
-    if(!storedRangeBeacon.init(imu_buffer_length)) {
-        return false;
-    }
     if(!storedIMU.init(imu_buffer_length)) {
         return false;
     }
     if(!storedOutput.init(imu_buffer_length)) {
         return false;
     }
+    // the buffer lengths may have changed, so resize the buffers of any
+    // optional sensors seen before this setup
+    optBuffersAllocated = 0;
+    optBufferAllocFailed = false;
+    allocateOptionalBuffers();
     gcs().send_text(MAV_SEVERITY_INFO, "EKF3 IMU%u buffers IMU=%u OBS=%u OF=%u, dt=%.4f",
                     (unsigned)imu_index,
                     (unsigned)imu_buffer_length,
@@ -154,7 +141,79 @@ bool NavEKF3_core::setup_core(uint8_t _imu_index, uint8_t _core_index)
                     (double)dtEkfAvg);
     return true;
 }
-    
+
+/*
+  the buffers for optional sensors (airspeed, optical flow, odometry,
+  external yaw, range finders and range beacons) are only allocated
+  once the sensor has provided data, so that lanes without those
+  sensors do not pay for them. A sensor may first provide data in
+  flight, so this is called from the measurement write paths too. Each
+  buffer is allocated once per setup, and after a failure allocation
+  is retried at most once a second. A failure is reported to the GCS,
+  and stops the core reporting healthy while disarmed so that it is
+  caught by the pre-arm checks
+ */
+void NavEKF3_core::allocateOptionalBuffers(void)
+{
+    const uint8_t pending = optBuffersNeeded & ~optBuffersAllocated;
+    if (pending == 0) {
+        return;
+    }
+    const uint32_t now_ms = AP_HAL::millis();
+    if (optBufferAllocFailed && now_ms - optBufferAllocFail_ms < 1000) {
+        return;
+    }
+    if ((pending & OPT_BUFFER_TAS) && storedTAS.init(obs_buffer_length)) {
+        optBuffersAllocated |= OPT_BUFFER_TAS;
+    }
+    if ((pending & OPT_BUFFER_OF) && storedOF.init(flow_buffer_length)) {
+        optBuffersAllocated |= OPT_BUFFER_OF;
+    }
+    if ((pending & OPT_BUFFER_BODY_ODM) && storedBodyOdm.init(obs_buffer_length)) {
+        optBuffersAllocated |= OPT_BUFFER_BODY_ODM;
+    }
+    // initialise to same length of IMU to allow for multiple wheel sensors
+    if ((pending & OPT_BUFFER_WHEEL_ODM) && storedWheelOdm.init(imu_buffer_length)) {
+        optBuffersAllocated |= OPT_BUFFER_WHEEL_ODM;
+    }
+    if ((pending & OPT_BUFFER_YAW_ANG) && storedYawAng.init(obs_buffer_length)) {
+        optBuffersAllocated |= OPT_BUFFER_YAW_ANG;
+    }
+    // Note: the use of dual range finders potentially doubles the amount of data to be stored
+    if ((pending & OPT_BUFFER_RANGE) && storedRange.init(MIN(2*obs_buffer_length , imu_buffer_length))) {
+        optBuffersAllocated |= OPT_BUFFER_RANGE;
+    }
+    // Note: range beacon data is read one beacon at a time and can arrive at a high rate
+    if ((pending & OPT_BUFFER_RANGE_BEACON) && storedRangeBeacon.init(imu_buffer_length)) {
+        optBuffersAllocated |= OPT_BUFFER_RANGE_BEACON;
+    }
+    const uint8_t failed = optBuffersNeeded & ~optBuffersAllocated;
+    optBufferAllocFailed = failed != 0;
+    if (optBufferAllocFailed) {
+        optBufferAllocFail_ms = now_ms;
+        if ((failed & ~optBuffersReported) != 0) {
+            // the data from these sensors can't be fused until the
+            // buffer is allocated, so say so once for each buffer
+            optBuffersReported |= failed;
+            gcs().send_text(MAV_SEVERITY_CRITICAL, "EKF3 IMU%u sensor buffer allocation failed (0x%02x)",
+                            (unsigned)imu_index, (unsigned)failed);
+        }
+    }
+}
+
+/*
+  note that an optional sensor has provided data, returning true when
+  its buffer is allocated and the data can be stored
+ */
+bool NavEKF3_core::optBufferReady(uint8_t buffer)
+{
+    optBuffersNeeded |= buffer;
+    if ((optBuffersAllocated & buffer) == 0) {
+        allocateOptionalBuffers();
+    }
+    return (optBuffersAllocated & buffer) != 0;
+}
+
 
 /********************************************************
 *                   INIT FUNCTIONS                      *
@@ -780,7 +839,7 @@ void NavEKF3_core::calcOutputStates()
     vertCompFiltState.pos += integ3_input; 
 
     // apply a trapezoidal integration to velocities to calculate position
-    outputDataNew.position += (outputDataNew.velocity + lastVelocity) * (imuDataNew.delVelDT*0.5f);
+    outputDataNew.position += Vector3p((outputDataNew.velocity + lastVelocity) * (imuDataNew.delVelDT*0.5f));
 
     // If the IMU accelerometer is offset from the body frame origin, then calculate corrections
     // that can be added to the EKF velocity and position outputs so that they represent the velocity
@@ -841,7 +900,7 @@ void NavEKF3_core::calcOutputStates()
 
         // calculate velocity and position tracking errors
         Vector3f velErr = (stateStruct.velocity - outputDataDelayed.velocity);
-        Vector3f posErr = (stateStruct.position - outputDataDelayed.position);
+        Vector3f posErr = Vector3f(Vector3p(stateStruct.position) - outputDataDelayed.position);
 
         // collect magnitude tracking error for diagnostics
         outputTrackError.x = deltaAngErr.length();
@@ -864,6 +923,7 @@ void NavEKF3_core::calcOutputStates()
         // this method is too expensive to use for the attitude states due to the quaternion operations required
         // but does not introduce a time delay in the 'correction loop' and allows smaller tracking time constants
         // to be used
+        const Vector3p posCorrectionOutput(posCorrection);
         output_elements outputStates;
         for (unsigned index=0; index < imu_buffer_length; index++) {
             outputStates = storedOutput[index];
@@ -872,7 +932,7 @@ void NavEKF3_core::calcOutputStates()
             outputStates.velocity += velCorrection;
 
             // a constant position correction is applied
-            outputStates.position += posCorrection;
+            outputStates.position += posCorrectionOutput;
 
             // push the updated data to the buffer
             storedOutput[index] = outputStates;
@@ -1421,7 +1481,7 @@ void NavEKF3_core::StoreOutputReset()
 {
     outputDataNew.quat = stateStruct.quat;
     outputDataNew.velocity = stateStruct.velocity;
-    outputDataNew.position = stateStruct.position;
+    outputDataNew.position = Vector3p(stateStruct.position);
     // write current measurement to entire table
     for (uint8_t i=0; i<imu_buffer_length; i++) {
         storedOutput[i] = outputDataNew;
@@ -1475,6 +1535,14 @@ void NavEKF3_core::ForceSymmetry()
     }
 }
 
+// apply the covariance correction P = P - K*H*P for a sparse scalar observation
+// returns false without modifying P if checkVariances is set and any variance
+// would be driven negative
+bool NavEKF3_core::CovarianceUpdateSparse(const ftype *H, const uint8_t *H_idx, uint8_t H_nnz, bool checkVariances)
+{
+    return NavEKF_core_common::CovarianceUpdateSparse(P, stateIndexLim+1, H, H_idx, H_nnz, checkVariances);
+}
+
 // constrain variances (diagonal terms) in the state covariance matrix to  prevent ill-conditioning
 // if states are inactive, zero the corresponding off-diagonals
 void NavEKF3_core::ConstrainVariances()
@@ -1514,6 +1582,7 @@ void NavEKF3_core::ConstrainVariances()
             }
             // reset all delta velocity bias covariances
             zeroCols(P,13,15);
+            zeroRows(P,13,15);
             // restore all delta velocity bias variances
             for (uint8_t i=0; i<=2; i++) {
                 P[i+13][i+13] = delVelBiasVar[i];
@@ -23,12 +23,25 @@
 
 #define EK3_DISABLE_INTERRUPTS 0
 
+/*
+  when enabled the output predictor position, which is integrated at the
+  IMU rate and is what the vehicle navigates with, is held in double
+  precision so that small increments are not lost far from the origin.
+  Only the output predictor is affected: the filter states and
+  covariance stay in single precision, and getPosNE(), getPosD() and
+  the other accessors narrow their result to float once the offsets
+  have been added in double
+ */
+#ifndef EK3_POSITION_DOUBLE
+#define EK3_POSITION_DOUBLE HAL_HAVE_HARDWARE_DOUBLE
+#endif
+
 #include <AP_Common/Location.h>
 #include <AP_Math/AP_Math.h>
 #include "AP_NavEKF3.h"
 #include <AP_Math/vectorN.h>
 #include <AP_NavEKF/AP_NavEKF_core_common.h>
-#include <AP_NavEKF3/AP_NavEKF3_Buffer.h>
+#include <AP_NavEKF/EKF_Buffer.h>
 #include <AP_InertialSensor/AP_InertialSensor.h>
 
 // GPS pre-flight check bit locations
@@ -396,6 +409,32 @@ private:
     uint8_t core_index;
     uint8_t imu_buffer_length;
     uint8_t obs_buffer_length;
+    uint8_t flow_buffer_length;
+
+    // buffers for optional sensors, allocated once the sensor has
+    // provided data
+    enum {
+        OPT_BUFFER_TAS          = (1U<<0),
+        OPT_BUFFER_OF           = (1U<<1),
+        OPT_BUFFER_BODY_ODM     = (1U<<2),
+        OPT_BUFFER_WHEEL_ODM    = (1U<<3),
+        OPT_BUFFER_YAW_ANG      = (1U<<4),
+        OPT_BUFFER_RANGE        = (1U<<5),
+        OPT_BUFFER_RANGE_BEACON = (1U<<6),
+    };
+    uint8_t optBuffersNeeded;       // OPT_BUFFER_* bits for sensors that have provided data
+    uint8_t optBuffersAllocated;    // OPT_BUFFER_* bits for buffers sized for the current setup
+    uint8_t optBuffersReported;     // OPT_BUFFER_* bits for allocation failures reported to the GCS
+    bool optBufferAllocFailed;      // true when a needed buffer could not be allocated
+    uint32_t optBufferAllocFail_ms; // time of the last failed allocation
+
+    // allocate the needed optional sensor buffers that are not yet
+    // allocated with the current lengths
+    void allocateOptionalBuffers(void);
+
+    // note that an optional sensor has provided data, returns true
+    // when its buffer is allocated
+    bool optBufferReady(uint8_t buffer);
 
     typedef float ftype;
 #if MATH_CHECK_INDEXES
@@ -447,6 +486,13 @@ private:
     typedef uint32_t Vector_u32_50[50];
 #endif
 
+    // type used for the output predictor position
+#if EK3_POSITION_DOUBLE
+    typedef Vector3d Vector3p;
+#else
+    typedef Vector3f Vector3p;
+#endif
+
     const AP_AHRS *_ahrs;
 
     // the states are available in two forms, either as a Vector24, or
@@ -471,7 +517,7 @@ private:
     struct output_elements {
         Quaternion  quat;           // quaternion defining rotation from local NED earth frame to body frame
         Vector3f    velocity;       // velocity of body frame origin in local NED earth frame (m/sec)
-        Vector3f    position;       // position of body frame origin in local NED earth frame (m)
+        Vector3p    position;       // position of body frame origin in local NED earth frame (m)
     };
 
     struct imu_elements {
@@ -571,6 +617,12 @@ private:
     // force symmetry on the state covariance matrix
     void ForceSymmetry();
 
+    // apply P = P - K*H*P using the gains in Kfusion for a scalar
+    // observation H that is non-zero only at the H_nnz indexes in H_idx.
+    // P is kept exactly symmetric. When checkVariances is true the update
+    // is rejected, leaving P unmodified, if any variance would go negative
+    bool CovarianceUpdateSparse(const ftype *H, const uint8_t *H_idx, uint8_t H_nnz, bool checkVariances);
+
     // constrain variances (diagonal terms) in the state covariance matrix
     void ConstrainVariances();
 
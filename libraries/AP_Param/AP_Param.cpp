@@ -25,10 +25,12 @@
 
 #include <cmath>
 #include <string.h>
+#include <ctype.h>
 
 #include <AP_Common/AP_Common.h>
 #include <AP_HAL/AP_HAL.h>
 #include <AP_Math/AP_Math.h>
+#include <AP_Math/crc.h>
 #include <GCS_MAVLink/GCS.h>
 #include <StorageManager/StorageManager.h>
 #include <AP_BoardConfig/AP_BoardConfig.h>
@@ -77,11 +79,26 @@ uint16_t AP_Param::_parameter_count;
 // storage and naming information about all types that can be saved
 const AP_Param::Info *AP_Param::_var_info;
 
+#if AP_PARAM_FIND_INDEX
+struct AP_Param::find_index_entry *AP_Param::_find_index;
+uint16_t AP_Param::_find_index_size;
+bool AP_Param::_find_index_valid;
+HAL_Semaphore AP_Param::_find_index_sem;
+#endif
+
+#if AP_PARAM_TOKEN_TABLE
+AP_Param::ParamToken *AP_Param::_token_table;
+uint16_t AP_Param::_token_table_size;
+HAL_Semaphore AP_Param::_token_table_sem;
+#endif
+
 struct AP_Param::param_override *AP_Param::param_overrides = nullptr;
 uint16_t AP_Param::num_param_overrides = 0;
 uint16_t AP_Param::num_read_only = 0;
 
-ObjectBuffer_TS<AP_Param::param_save> AP_Param::save_queue{30};
+ObjectArray<AP_Param::param_save> AP_Param::save_queue{AP_PARAM_SAVE_QUEUE_SIZE};
+HAL_Semaphore AP_Param::save_sem;
+AP_Param::SaveStats AP_Param::save_stats;
 bool AP_Param::registered_save_handler;
 
 // we need a dummy object for the parameter save callback
@@ -757,6 +774,26 @@ void AP_Param::copy_name_token(const ParamToken &token, char *buffer, size_t buf
     copy_name_info(info, ginfo, group_nesting, idx, buffer, buffer_size, force_scalar);
 }
 
+// Get the variable's default value, taking account of defaults files
+//
+bool AP_Param::get_default_token(const ParamToken &token, float &value) const
+{
+    uint32_t group_element;
+    const struct GroupInfo *ginfo;
+    struct GroupNesting group_nesting {};
+    uint8_t idx;
+    const struct AP_Param::Info *info = find_var_info_token(token, &group_element, ginfo, group_nesting, &idx);
+    if (info == nullptr) {
+        return false;
+    }
+    if (ginfo != nullptr) {
+        value = get_default_value(this, &ginfo->def_value);
+    } else {
+        value = get_default_value(this, &info->def_value);
+    }
+    return true;
+}
+
 void AP_Param::copy_name_info(const struct AP_Param::Info *info,
                               const struct GroupInfo *ginfo,
                               const struct GroupNesting &group_nesting,
@@ -850,6 +887,155 @@ AP_Param::find_group(const char *name, uint16_t vindex, ptrdiff_t group_offset,
 //
 AP_Param *
 AP_Param::find(const char *name, enum ap_var_type *ptype, uint16_t *flags)
+{
+    AP_Param *ap = find_indexed(name, ptype, flags);
+    if (ap != nullptr) {
+        return ap;
+    }
+    // parameters hidden by frame type are not in the index
+    return find_unindexed(name, ptype, flags);
+}
+
+#if AP_PARAM_FIND_INDEX
+// hash of a parameter name for the find() index. Names are matched
+// without regard to case, so the hash is of the upper case name
+static uint32_t find_index_hash(const char *name)
+{
+    uint8_t upper[AP_MAX_NAME_SIZE+1];
+    const uint8_t len = strnlen(name, sizeof(upper));
+    for (uint8_t i=0; i<len; i++) {
+        upper[i] = toupper((uint8_t)name[i]);
+    }
+    uint64_t hash = FNV_1_OFFSET_BASIS_64;
+    hash_fnv_1a(len, upper, &hash);
+    return uint32_t(hash);
+}
+#endif
+
+/*
+  build the index of parameter names used by find()
+ */
+bool AP_Param::build_find_index(void)
+{
+#if AP_PARAM_FIND_INDEX
+    ParamToken token;
+    enum ap_var_type type;
+    uint16_t count = 0;
+    for (AP_Param *ap = first(&token, &type); ap != nullptr; ap = next(&token, &type)) {
+        if (type != AP_PARAM_GROUP) {
+            count++;
+        }
+    }
+    if (count != _find_index_size) {
+        delete[] _find_index;
+        _find_index_size = 0;
+        _find_index = new find_index_entry[count];
+        if (_find_index == nullptr) {
+            return false;
+        }
+        _find_index_size = count;
+    }
+
+    uint16_t n = 0;
+    for (AP_Param *ap = first(&token, &type);
+         ap != nullptr && n < _find_index_size;
+         ap = next(&token, &type)) {
+        if (type == AP_PARAM_GROUP) {
+            continue;
+        }
+        // the elements of a Vector3f follow it, named with a suffix
+        char name[AP_MAX_NAME_SIZE+1];
+        ap->copy_name_token(token, name, sizeof(name), token.idx != 0);
+        name[AP_MAX_NAME_SIZE] = 0;
+        _find_index[n].hash = find_index_hash(name);
+        _find_index[n].token = token;
+        _find_index[n].ap = ap;
+        n++;
+    }
+    _find_index_size = n;
+    qsort(_find_index, _find_index_size, sizeof(_find_index[0]), [](const void *v1, const void *v2) {
+        const uint32_t h1 = ((const struct find_index_entry *)v1)->hash;
+        const uint32_t h2 = ((const struct find_index_entry *)v2)->hash;
+        return h1 < h2 ? -1 : (h1 > h2 ? 1 : 0);
+    });
+    _find_index_valid = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+  rebuild the find() index on next use, called when parameters may
+  have been added to the tree or hidden
+ */
+void AP_Param::invalidate_find_index(void)
+{
+#if AP_PARAM_FIND_INDEX
+    _find_index_valid = false;
+#endif
+}
+
+/*
+  find a variable by name in the index, returns nullptr if the name
+  isn't in the index
+ */
+AP_Param *AP_Param::find_indexed(const char *name, enum ap_var_type *ptype, uint16_t *flags)
+{
+#if AP_PARAM_FIND_INDEX
+    WITH_SEMAPHORE(_find_index_sem);
+    if (!_find_index_valid && !build_find_index()) {
+        return nullptr;
+    }
+    const uint32_t hash = find_index_hash(name);
+
+    // find the first entry with the hash
+    uint16_t lo = 0;
+    uint16_t hi = _find_index_size;
+    while (lo < hi) {
+        const uint16_t mid = (lo + hi) / 2;
+        if (_find_index[mid].hash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    // check the name, as different names can have the same hash
+    for (; lo < _find_index_size && _find_index[lo].hash == hash; lo++) {
+        const struct find_index_entry &e = _find_index[lo];
+        uint32_t group_element;
+        const struct GroupInfo *ginfo;
+        struct GroupNesting group_nesting {};
+        uint8_t idx;
+        const struct Info *info = e.ap->find_var_info_token(e.token, &group_element, ginfo, group_nesting, &idx);
+        if (info == nullptr) {
+            continue;
+        }
+        char vname[AP_MAX_NAME_SIZE+1];
+        e.ap->copy_name_info(info, ginfo, group_nesting, idx, vname, sizeof(vname), e.token.idx != 0);
+        vname[AP_MAX_NAME_SIZE] = 0;
+        if (strcasecmp(name, vname) != 0) {
+            continue;
+        }
+        if (e.token.idx != 0) {
+            *ptype = AP_PARAM_FLOAT;
+        } else {
+            *ptype = (enum ap_var_type)(ginfo != nullptr ? ginfo->type : info->type);
+        }
+        if (flags != nullptr && ginfo != nullptr) {
+            *flags = ginfo->flags;
+        }
+        return e.ap;
+    }
+#endif
+    return nullptr;
+}
+
+// Find a variable by name, walking the var_info tree
+//
+AP_Param *
+AP_Param::find_unindexed(const char *name, enum ap_var_type *ptype, uint16_t *flags)
 {
     for (uint16_t i=0; i<_num_vars; i++) {
         uint8_t type = _var_info[i].type;
@@ -891,11 +1077,28 @@ AP_Param::find(const char *name, enum ap_var_type *ptype, uint16_t *flags)
     return nullptr;
 }
 
-// Find a variable by index. Note that this is quite slow.
+// Find a variable by index. Without the token table this is quite
+// slow.
 //
 AP_Param *
 AP_Param::find_by_index(uint16_t idx, enum ap_var_type *ptype, ParamToken *token)
 {
+#if AP_PARAM_TOKEN_TABLE
+    // make sure the table is up to date
+    const uint16_t num_params = count_parameters();
+    if (idx != 0) {
+        WITH_SEMAPHORE(_token_table_sem);
+        if (_token_table != nullptr && _token_table_size == num_params) {
+            if (idx >= num_params) {
+                return nullptr;
+            }
+            // continue from the parameter before
+            *token = _token_table[idx-1];
+            return next_scalar(token, ptype);
+        }
+    }
+#endif
+
     AP_Param *ap;
     uint16_t count=0;
     for (ap=AP_Param::first(token, ptype);
@@ -1073,8 +1276,10 @@ void AP_Param::save_sync(bool force_save)
     }
 
     if (phdr.type == AP_PARAM_INT8 && ginfo != nullptr && (ginfo->flags & AP_PARAM_FLAG_ENABLE)) {
-        // clear cached parameter count
+        // clear cached parameter count and the find() index, as
+        // the parameters of the group may be shown or hidden
         _parameter_count = 0;
+        invalidate_find_index();
     }
     
     char name[AP_MAX_NAME_SIZE+1];
@@ -1121,10 +1326,23 @@ void AP_Param::save_sync(bool force_save)
         return;
     }
 
-    // write a new sentinal, then the data, then the header
-    write_sentinal(ofs + sizeof(phdr) + type_size((enum ap_var_type)phdr.type));
-    eeprom_write_check(ap, ofs+sizeof(phdr), type_size((enum ap_var_type)phdr.type));
-    eeprom_write_check(&phdr, ofs, sizeof(phdr));
+    // write the header, the data and a new sentinal as one block. This
+    // used to be three writes, sentinal then data then header, so that
+    // a power loss part way through left a valid sentinal. Every HAL
+    // storage backend (ChibiOS, Linux, SITL) copies writes into a RAM
+    // buffer and writes dirty lines back lowest address first, not in
+    // the order of the calls, so that ordering never reached the device
+    const uint8_t size = type_size((enum ap_var_type)phdr.type);
+    struct Param_header sentinal;
+    sentinal.type = _sentinal_type;
+    set_key(sentinal, _sentinal_key);
+    sentinal.group_element = _sentinal_group;
+    uint8_t block[2*sizeof(phdr) + sizeof(Vector3f)];
+    memcpy(&block[0], &phdr, sizeof(phdr));
+    memcpy(&block[sizeof(phdr)], ap, size);
+    memcpy(&block[sizeof(phdr)+size], &sentinal, sizeof(sentinal));
+    eeprom_write_check(block, ofs, 2*sizeof(phdr)+size);
+    sentinal_offset = ofs + sizeof(phdr) + size;
 
     send_parameter(name, (enum ap_var_type)phdr.type, idx);
 }
@@ -1137,12 +1355,42 @@ void AP_Param::save(bool force_save)
     struct param_save p;
     p.param = this;
     p.force_save = force_save;
-    while (!save_queue.push(p)) {
-        // if we can't save to the queue
-        if (hal.util->get_soft_armed()) {
-            // if we are armed then don't sleep, instead we lose the
-            // parameter save
-            return;
+    uint32_t wait_start_us = 0;
+    bool waiting = false;
+    while (true) {
+        {
+            WITH_SEMAPHORE(save_sem);
+            if (waiting) {
+                save_stats.wait_us += AP_HAL::micros() - wait_start_us;
+                wait_start_us = AP_HAL::micros();
+            }
+            // a queued save writes the value current when it is done,
+            // so a second one is not needed
+            for (uint16_t i=0; i<save_queue.available(); i++) {
+                struct param_save *q = save_queue[i];
+                if (q->param == this) {
+                    q->force_save |= force_save;
+                    save_stats.coalesced++;
+                    return;
+                }
+            }
+            if (save_queue.push(p)) {
+                save_stats.queued++;
+                save_stats.max_pending = MAX(save_stats.max_pending, save_queue.available());
+                return;
+            }
+            // if we can't save to the queue
+            if (hal.util->get_soft_armed()) {
+                // if we are armed then don't sleep, instead we lose the
+                // parameter save
+                save_stats.dropped++;
+                return;
+            }
+            if (!waiting) {
+                waiting = true;
+                wait_start_us = AP_HAL::micros();
+                save_stats.waits++;
+            }
         }
         // when we are disarmed then loop waiting for a slot to become
         // available. This guarantees completion for large parameter
@@ -1155,22 +1403,82 @@ void AP_Param::save(bool force_save)
 
 /*
   background function for saving parameters. This runs on the IO thread
+
+  Saves of different parameters are not merged into larger
+  write_block() calls. A write_block() only copies into the HAL's RAM
+  buffer, and the HAL already writes back all the changes in a storage
+  line with a single device write. Merging appends would also need the
+  sentinal of one save to be written before the next save scans for it
  */
 void AP_Param::save_io_handler(void)
 {
-    struct param_save p;
-    while (save_queue.pop(p)) {
+    while (true) {
+        struct param_save p;
+        {
+            WITH_SEMAPHORE(save_sem);
+            if (!save_queue.pop(p)) {
+                break;
+            }
+        }
         p.param->save_sync(p.force_save);
+        WITH_SEMAPHORE(save_sem);
+        save_stats.written++;
     }
 }
 
+/*
+  get the statistics of the save queue
+ */
+void AP_Param::get_save_stats(SaveStats &stats)
+{
+    WITH_SEMAPHORE(save_sem);
+    stats = save_stats;
+}
+
+/*
+  text report of the save queue statistics
+ */
+uint32_t AP_Param::save_info(char *buf, uint32_t bufsize)
+{
+    SaveStats stats;
+    uint16_t pending;
+    {
+        WITH_SEMAPHORE(save_sem);
+        stats = save_stats;
+        pending = save_queue.available();
+    }
+    const int n = hal.util->snprintf(buf, bufsize,
+                                     "Queued: %lu\n"
+                                     "Coalesced: %lu\n"
+                                     "Written: %lu\n"
+                                     "Pending: %u/%u (max %u)\n"
+                                     "Waits: %lu (%lu ms)\n"
+                                     "Dropped: %lu\n",
+                                     (unsigned long)stats.queued,
+                                     (unsigned long)stats.coalesced,
+                                     (unsigned long)stats.written,
+                                     (unsigned)pending,
+                                     (unsigned)AP_PARAM_SAVE_QUEUE_SIZE,
+                                     (unsigned)stats.max_pending,
+                                     (unsigned long)stats.waits,
+                                     (unsigned long)(stats.wait_us / 1000),
+                                     (unsigned long)stats.dropped);
+    return n > 0 ? n : 0;
+}
+
 /*
   wait for all parameters to save
 */
 void AP_Param::flush(void)
 {
     uint16_t counter = 200; // 2 seconds max
-    while (counter-- && save_queue.available()) {
+    while (counter--) {
+        {
+            WITH_SEMAPHORE(save_sem);
+            if (save_queue.empty()) {
+                break;
+            }
+        }
         hal.scheduler->expect_delay_ms(10);
         hal.scheduler->delay(10);
         hal.scheduler->expect_delay_ms(0);
@@ -1477,6 +1785,7 @@ void AP_Param::load_object_from_eeprom(const void *object_pointer, const struct
 
     // reset cached param counter as we may be loading a dynamic var_info
     _parameter_count = 0;
+    invalidate_find_index();
     
     if (!find_key_by_pointer(object_pointer, key)) {
         hal.console->printf("ERROR: Unable to find param pointer\n");
@@ -2327,6 +2636,9 @@ uint16_t AP_Param::count_parameters(void)
     // if we haven't cached the parameter count yet...
     uint16_t ret = _parameter_count;
     if (0 == ret) {
+#if AP_PARAM_TOKEN_TABLE
+        WITH_SEMAPHORE(_token_table_sem);
+#endif
         AP_Param  *vp;
         AP_Param::ParamToken token;
 
@@ -2335,11 +2647,40 @@ uint16_t AP_Param::count_parameters(void)
              vp = AP_Param::next_scalar(&token, nullptr)) {
             ret++;
         }
+#if AP_PARAM_TOKEN_TABLE
+        build_token_table(ret);
+#endif
         _parameter_count = ret;
     }
     return ret;
 }
 
+/*
+  fill in the token table for count parameters. Called with
+  _token_table_sem held
+ */
+void AP_Param::build_token_table(uint16_t count)
+{
+#if AP_PARAM_TOKEN_TABLE
+    if (count != _token_table_size) {
+        delete[] _token_table;
+        _token_table_size = 0;
+        _token_table = new ParamToken[count];
+        if (_token_table == nullptr) {
+            return;
+        }
+        _token_table_size = count;
+    }
+    AP_Param::ParamToken token;
+    uint16_t n = 0;
+    for (AP_Param *vp = AP_Param::first(&token, nullptr);
+         vp != nullptr && n < count;
+         vp = AP_Param::next_scalar(&token, nullptr)) {
+        _token_table[n++] = token;
+    }
+#endif
+}
+
 /*
   set a default value by name
  */
@@ -46,6 +46,34 @@
 #endif
 #endif
 
+/*
+  index parameter names by hash for find(), costing 12 bytes of RAM
+  per parameter on 32 bit boards
+ */
+#ifndef AP_PARAM_FIND_INDEX
+#define AP_PARAM_FIND_INDEX (HAL_MEM_CLASS >= HAL_MEM_CLASS_300)
+#endif
+
+/*
+  keep the token of every scalar parameter, so find_by_index() doesn't
+  walk the tree. This costs 4 bytes of RAM per parameter
+ */
+#ifndef AP_PARAM_TOKEN_TABLE
+#define AP_PARAM_TOKEN_TABLE (HAL_MEM_CLASS >= HAL_MEM_CLASS_300)
+#endif
+
+/*
+  number of parameter saves which can wait for the IO thread. A GCS
+  sending a parameter file waits when the queue is full
+ */
+#ifndef AP_PARAM_SAVE_QUEUE_SIZE
+#if HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+#define AP_PARAM_SAVE_QUEUE_SIZE 100
+#else
+#define AP_PARAM_SAVE_QUEUE_SIZE 30
+#endif
+#endif
+
 /*
   flags for variables in var_info and group tables
  */
@@ -256,6 +284,13 @@ public:
     /// Uses token to look up AP_Param::Info for the variable
     void copy_name_token(const ParamToken &token, char *buffer, size_t bufferSize, bool force_scalar=false) const;
 
+    /// Get the variable's default value, including any override from a
+    /// defaults file.
+    ///
+    /// Uses token to look up AP_Param::Info for the variable
+    /// @return                 false if the variable was not found
+    bool get_default_token(const ParamToken &token, float &value) const;
+
     /// Find a variable by name.
     ///
     /// If the variable has no name, it cannot be found by this interface.
@@ -267,6 +302,10 @@ public:
     ///
     static AP_Param * find(const char *name, enum ap_var_type *ptype, uint16_t *flags = nullptr);
 
+    /// Find a variable by name by walking the var_info tree, without
+    /// the name index used by find(). This is much slower than find()
+    static AP_Param * find_unindexed(const char *name, enum ap_var_type *ptype, uint16_t *flags = nullptr);
+
     /// set a default value by name
     ///
     /// @param  name            The full name of the variable to be found.
@@ -305,8 +344,8 @@ public:
     // name helper for scripting
     static bool set_and_save(const char *name, float value) { return set_and_save_by_name(name, value); };
 
-    /// Find a variable by index.
-    ///
+    /// Find a variable by index, the position of the variable in the
+    /// order of first() and next_scalar().
     ///
     /// @param  idx             The index of the variable
     /// @return                 A pointer to the variable, or nullptr if
@@ -355,6 +394,22 @@ public:
     /// used on reboot
     static void flush(void);
 
+    /// statistics of the background save queue
+    struct SaveStats {
+        uint32_t queued;        // saves added to the queue
+        uint32_t coalesced;     // saves of a parameter which was already queued
+        uint32_t written;       // saves done by the IO thread
+        uint32_t waits;         // saves which waited for space in the queue
+        uint32_t wait_us;       // total time spent waiting
+        uint32_t dropped;       // saves lost to a full queue while armed
+        uint16_t max_pending;   // most saves queued at once
+    };
+    static void get_save_stats(SaveStats &stats);
+
+    /// fill buf with a text report of the save statistics, returning
+    /// the length of the whole report
+    static uint32_t save_info(char *buf, uint32_t bufsize);
+
     /// Save the current value of the variable to storage, async interface
     ///
     /// @param  force_save     If true then force save even if default
@@ -480,6 +535,7 @@ public:
     // set frame type flags. Used to unhide frame specific parameters
     static void set_frame_type_flags(uint16_t flags_to_set) {
         _parameter_count = 0;
+        invalidate_find_index();
         _frame_type_flags |= flags_to_set;
     }
 
@@ -622,6 +678,13 @@ private:
                                     const struct GroupInfo *group_info,
                                     enum ap_var_type *ptype);
     static void                 write_sentinal(uint16_t ofs);
+    static AP_Param *           find_indexed(
+                                    const char *name,
+                                    enum ap_var_type *ptype,
+                                    uint16_t *flags);
+    static bool                 build_find_index(void);
+    static void                 invalidate_find_index(void);
+    static void                 build_token_table(uint16_t count);
     static uint16_t             get_key(const Param_header &phdr);
     static void                 set_key(Param_header &phdr, uint16_t key);
     static bool                 is_sentinal(const Param_header &phrd);
@@ -671,6 +734,34 @@ private:
     static uint16_t             _parameter_count;
     static const struct Info *  _var_info;
 
+#if AP_PARAM_FIND_INDEX
+    /*
+      index of parameter names for find(), sorted by the hash of the
+      name. It is built on first use and rebuilt after the tree
+      changes
+    */
+    struct find_index_entry {
+        uint32_t hash;
+        ParamToken token;
+        AP_Param *ap;
+    };
+    static struct find_index_entry *_find_index;
+    static uint16_t _find_index_size;
+    static bool _find_index_valid;
+    static HAL_Semaphore _find_index_sem;
+#endif
+
+#if AP_PARAM_TOKEN_TABLE
+    /*
+      table of the tokens next_scalar() returns, built with the
+      parameter count. Entry i is the token after finding the parameter
+      with index i
+    */
+    static ParamToken *_token_table;
+    static uint16_t _token_table_size;
+    static HAL_Semaphore _token_table_sem;
+#endif
+
     /*
       list of overridden values from load_defaults_file()
     */
@@ -691,12 +782,15 @@ private:
     static bool _hide_disabled_groups;
 
     // support for background saving of parameters. We pack it to reduce memory for the
-    // queue
+    // queue. A parameter is only queued once, a second save before the
+    // first is done is merged into it
     struct PACKED param_save {
         AP_Param *param;
         bool force_save;
     };
-    static ObjectBuffer_TS<struct param_save> save_queue;
+    static ObjectArray<struct param_save> save_queue;
+    static HAL_Semaphore save_sem;
+    static SaveStats save_stats;
     static bool registered_save_handler;
 
     // background function for saving parameters
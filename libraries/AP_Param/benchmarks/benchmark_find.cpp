@@ -0,0 +1,137 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Param/AP_Param.h>
+#include <stdio.h>
+
+/*
+  compare finding parameters by name and by index by walking the
+  var_info tree against the hash index and token table, on a tree of
+  128 groups of 8 parameters, about the size of the Copter tree
+ */
+
+class BenchGroup {
+public:
+    static const struct AP_Param::GroupInfo var_info[];
+    AP_Float p[8];
+};
+
+#define BENCH_PARAM(i) AP_GROUPINFO("P" #i, i, BenchGroup, p[i], 0)
+
+const AP_Param::GroupInfo BenchGroup::var_info[] = {
+    BENCH_PARAM(0), BENCH_PARAM(1), BENCH_PARAM(2), BENCH_PARAM(3),
+    BENCH_PARAM(4), BENCH_PARAM(5), BENCH_PARAM(6), BENCH_PARAM(7),
+    AP_GROUPEND
+};
+
+static AP_Int16 format_version;
+static BenchGroup groups[128];
+
+#define BENCH_GROUP(i) { AP_PARAM_GROUP, "G" #i "_", i+1, &groups[i], { group_info : BenchGroup::var_info }, 0 }
+
+static const AP_Param::Info var_info[] = {
+    { AP_PARAM_INT16, "FORMAT_VERSION", 0, &format_version, { def_value : 0 }, 0 },
+    BENCH_GROUP(0), BENCH_GROUP(1), BENCH_GROUP(2), BENCH_GROUP(3),
+    BENCH_GROUP(4), BENCH_GROUP(5), BENCH_GROUP(6), BENCH_GROUP(7),
+    BENCH_GROUP(8), BENCH_GROUP(9), BENCH_GROUP(10), BENCH_GROUP(11),
+    BENCH_GROUP(12), BENCH_GROUP(13), BENCH_GROUP(14), BENCH_GROUP(15),
+    BENCH_GROUP(16), BENCH_GROUP(17), BENCH_GROUP(18), BENCH_GROUP(19),
+    BENCH_GROUP(20), BENCH_GROUP(21), BENCH_GROUP(22), BENCH_GROUP(23),
+    BENCH_GROUP(24), BENCH_GROUP(25), BENCH_GROUP(26), BENCH_GROUP(27),
+    BENCH_GROUP(28), BENCH_GROUP(29), BENCH_GROUP(30), BENCH_GROUP(31),
+    BENCH_GROUP(32), BENCH_GROUP(33), BENCH_GROUP(34), BENCH_GROUP(35),
+    BENCH_GROUP(36), BENCH_GROUP(37), BENCH_GROUP(38), BENCH_GROUP(39),
+    BENCH_GROUP(40), BENCH_GROUP(41), BENCH_GROUP(42), BENCH_GROUP(43),
+    BENCH_GROUP(44), BENCH_GROUP(45), BENCH_GROUP(46), BENCH_GROUP(47),
+    BENCH_GROUP(48), BENCH_GROUP(49), BENCH_GROUP(50), BENCH_GROUP(51),
+    BENCH_GROUP(52), BENCH_GROUP(53), BENCH_GROUP(54), BENCH_GROUP(55),
+    BENCH_GROUP(56), BENCH_GROUP(57), BENCH_GROUP(58), BENCH_GROUP(59),
+    BENCH_GROUP(60), BENCH_GROUP(61), BENCH_GROUP(62), BENCH_GROUP(63),
+    BENCH_GROUP(64), BENCH_GROUP(65), BENCH_GROUP(66), BENCH_GROUP(67),
+    BENCH_GROUP(68), BENCH_GROUP(69), BENCH_GROUP(70), BENCH_GROUP(71),
+    BENCH_GROUP(72), BENCH_GROUP(73), BENCH_GROUP(74), BENCH_GROUP(75),
+    BENCH_GROUP(76), BENCH_GROUP(77), BENCH_GROUP(78), BENCH_GROUP(79),
+    BENCH_GROUP(80), BENCH_GROUP(81), BENCH_GROUP(82), BENCH_GROUP(83),
+    BENCH_GROUP(84), BENCH_GROUP(85), BENCH_GROUP(86), BENCH_GROUP(87),
+    BENCH_GROUP(88), BENCH_GROUP(89), BENCH_GROUP(90), BENCH_GROUP(91),
+    BENCH_GROUP(92), BENCH_GROUP(93), BENCH_GROUP(94), BENCH_GROUP(95),
+    BENCH_GROUP(96), BENCH_GROUP(97), BENCH_GROUP(98), BENCH_GROUP(99),
+    BENCH_GROUP(100), BENCH_GROUP(101), BENCH_GROUP(102), BENCH_GROUP(103),
+    BENCH_GROUP(104), BENCH_GROUP(105), BENCH_GROUP(106), BENCH_GROUP(107),
+    BENCH_GROUP(108), BENCH_GROUP(109), BENCH_GROUP(110), BENCH_GROUP(111),
+    BENCH_GROUP(112), BENCH_GROUP(113), BENCH_GROUP(114), BENCH_GROUP(115),
+    BENCH_GROUP(116), BENCH_GROUP(117), BENCH_GROUP(118), BENCH_GROUP(119),
+    BENCH_GROUP(120), BENCH_GROUP(121), BENCH_GROUP(122), BENCH_GROUP(123),
+    BENCH_GROUP(124), BENCH_GROUP(125), BENCH_GROUP(126), BENCH_GROUP(127),
+    AP_VAREND
+};
+
+static AP_Param param_loader(var_info);
+
+// names of all the parameters, looked up in turn
+static char names[128*8][AP_MAX_NAME_SIZE+1];
+
+static void setup_names()
+{
+    for (uint16_t i=0; i<ARRAY_SIZE(names); i++) {
+        snprintf(names[i], sizeof(names[i]), "G%u_P%u", unsigned(i / 8), unsigned(i % 8));
+    }
+}
+
+static void BM_ParamFindUnindexed(benchmark::State& state)
+{
+    setup_names();
+    uint16_t i = 0;
+    while (state.KeepRunning()) {
+        enum ap_var_type ptype;
+        AP_Param *ap = AP_Param::find_unindexed(names[i], &ptype);
+        gbenchmark_escape(ap);
+        i = (i + 1) % ARRAY_SIZE(names);
+    }
+}
+
+static void BM_ParamFind(benchmark::State& state)
+{
+    setup_names();
+    uint16_t i = 0;
+    while (state.KeepRunning()) {
+        enum ap_var_type ptype;
+        AP_Param *ap = AP_Param::find(names[i], &ptype);
+        gbenchmark_escape(ap);
+        i = (i + 1) % ARRAY_SIZE(names);
+    }
+}
+
+// find_by_index() without the token table
+static void BM_ParamFindByIndexWalk(benchmark::State& state)
+{
+    uint16_t i = 0;
+    while (state.KeepRunning()) {
+        AP_Param::ParamToken token;
+        enum ap_var_type ptype;
+        AP_Param *ap = AP_Param::first(&token, &ptype);
+        for (uint16_t count=0; ap != nullptr && count < i; count++) {
+            ap = AP_Param::next_scalar(&token, &ptype);
+        }
+        gbenchmark_escape(ap);
+        i = (i + 1) % ARRAY_SIZE(names);
+    }
+}
+
+static void BM_ParamFindByIndex(benchmark::State& state)
+{
+    uint16_t i = 0;
+    while (state.KeepRunning()) {
+        AP_Param::ParamToken token;
+        enum ap_var_type ptype;
+        AP_Param *ap = AP_Param::find_by_index(i, &ptype, &token);
+        gbenchmark_escape(ap);
+        i = (i + 1) % ARRAY_SIZE(names);
+    }
+}
+
+BENCHMARK(BM_ParamFindUnindexed);
+BENCHMARK(BM_ParamFind);
+BENCHMARK(BM_ParamFindByIndexWalk);
+BENCHMARK(BM_ParamFindByIndex);
+
+BENCHMARK_MAIN()
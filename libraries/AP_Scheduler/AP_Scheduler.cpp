@@ -57,6 +57,31 @@ const AP_Param::GroupInfo AP_Scheduler::var_info[] = {
     // @User: Advanced
     AP_GROUPINFO("LOOP_RATE",  1, AP_Scheduler, _loop_rate_hz, SCHEDULER_DEFAULT_LOOP_RATE),
 
+    // @Param: OPTIONS
+    // @DisplayName: Scheduling options
+    // @Description: This controls optional aspects of the scheduler. Recording task info keeps a histogram of the execution time of each task, which is logged in TSCH messages at 1Hz when performance logging is enabled and is available as @SYS/tasks.txt over MAVLink FTP. This only takes effect on restart.
+    // @Bitmask: 0:Record task info
+    // @RebootRequired: True
+    // @User: Advanced
+    AP_GROUPINFO("OPTIONS",  2, AP_Scheduler, _options, 0),
+
+    // @Param: POLICY
+    // @DisplayName: Scheduling policy
+    // @Description: This controls the order in which due tasks are run. RoundRobin runs them in task table order. EarliestDeadlineFirst runs them by task priority class and then by how long they have been due, so that slow tasks that have been skipped due to lack of time are run before tasks that only just became due. Compare the task latency in SLAT logs to evaluate the policies.
+    // @Values: 0:RoundRobin,1:EarliestDeadlineFirst
+    // @User: Advanced
+    AP_GROUPINFO("POLICY",  3, AP_Scheduler, _policy, uint8_t(Policy::ROUND_ROBIN)),
+
+#if AP_SCHEDULER_WORKERS_ENABLED
+    // @Param: WORKERS
+    // @DisplayName: Scheduler worker threads
+    // @Description: Number of worker threads used to run scheduler tasks that are marked as safe to run outside the main thread. This frees main loop time on boards with multiple CPU cores. Set to zero to run all tasks in the main thread.
+    // @Range: 0 4
+    // @RebootRequired: True
+    // @User: Advanced
+    AP_GROUPINFO("WORKERS",  4, AP_Scheduler, _num_workers, 0),
+#endif
+
     AP_GROUPEND
 };
 
@@ -108,12 +133,21 @@ void AP_Scheduler::init(const AP_Scheduler::Task *tasks, uint8_t num_tasks, uint
 
     _last_run = new uint16_t[_num_tasks];
     memset(_last_run, 0, sizeof(_last_run[0]) * _num_tasks);
+    _run_order = new uint8_t[_num_tasks];
     _tick_counter = 0;
 
     // setup initial performance counters
     perf_info.set_loop_rate(get_loop_rate_hz());
     perf_info.reset();
 
+    if (_options & uint8_t(Options::RECORD_TASK_INFO)) {
+        perf_info.allocate_task_info(_num_tasks);
+    }
+
+#if AP_SCHEDULER_WORKERS_ENABLED
+    start_workers();
+#endif
+
     _log_performance_bit = log_performance_bit;
 }
 
@@ -135,6 +169,49 @@ static void fill_nanf_stack(void)
 }
 #endif
 
+// return the number of ticks between runs of a task
+uint32_t AP_Scheduler::task_interval_ticks(const Task &task) const
+{
+    // we allow 0 to mean loop rate
+    uint32_t interval_ticks = (is_zero(task.rate_hz) ? 1 : _loop_rate_hz / task.rate_hz);
+    if (interval_ticks < 1) {
+        interval_ticks = 1;
+    }
+    return interval_ticks;
+}
+
+/*
+  fill _run_order with the tasks that are due, sorted by priority
+  class and then by deadline, returning the number of due tasks. Only
+  a few tasks are due on each tick so an insertion sort is used
+ */
+uint8_t AP_Scheduler::sort_due_tasks()
+{
+    uint8_t num_due = 0;
+    for (uint8_t i=0; i<_num_tasks; i++) {
+        const Task &task = get_task(i);
+        const uint32_t interval_ticks = task_interval_ticks(task);
+        if (uint16_t(_tick_counter - _last_run[i]) < interval_ticks) {
+            continue;
+        }
+        const uint16_t deadline = _last_run[i] + interval_ticks;
+        uint8_t n = num_due++;
+        while (n > 0) {
+            const uint8_t j = _run_order[n-1];
+            const Task &other = get_task(j);
+            const uint16_t other_deadline = _last_run[j] + task_interval_ticks(other);
+            if (other.priority < task.priority ||
+                (other.priority == task.priority && int16_t(deadline - other_deadline) >= 0)) {
+                break;
+            }
+            _run_order[n] = j;
+            n--;
+        }
+        _run_order[n] = i;
+    }
+    return num_due;
+}
+
 /*
   run one tick
   this will run as many scheduler tasks as we can in the specified time
@@ -147,24 +224,21 @@ void AP_Scheduler::run(uint32_t time_available)
     if (_debug > 1 && _perf_counters == nullptr) {
         _perf_counters = new AP_HAL::Util::perf_counter_t[_num_tasks];
         if (_perf_counters != nullptr) {
-            for (uint8_t i=0; i<_num_unshared_tasks; i++) {
-                _perf_counters[i] = hal.util->perf_alloc(AP_HAL::Util::PC_ELAPSED, _tasks[i].name);
-            }
-            for (uint8_t i=_num_unshared_tasks; i<_num_tasks; i++) {
-                _perf_counters[i] = hal.util->perf_alloc(AP_HAL::Util::PC_ELAPSED, _common_tasks[i].name);
+            for (uint8_t i=0; i<_num_tasks; i++) {
+                _perf_counters[i] = hal.util->perf_alloc(AP_HAL::Util::PC_ELAPSED, get_task(i).name);
             }
         }
     }
     
-    for (uint8_t i=0; i<_num_tasks; i++) {
-        const AP_Scheduler::Task& task = (i < _num_unshared_tasks) ? _tasks[i] : _common_tasks[i - _num_unshared_tasks];
+    const bool edf = _policy == uint8_t(Policy::EARLIEST_DEADLINE_FIRST) && _run_order != nullptr;
+    const uint8_t num_tasks = edf ? sort_due_tasks() : _num_tasks;
 
-        uint32_t dt = _tick_counter - _last_run[i];
-        // we allow 0 to mean loop rate
-        uint32_t interval_ticks = (is_zero(task.rate_hz) ? 1 : _loop_rate_hz / task.rate_hz);
-        if (interval_ticks < 1) {
-            interval_ticks = 1;
-        }
+    for (uint8_t n=0; n<num_tasks; n++) {
+        const uint8_t i = edf ? _run_order[n] : n;
+        const AP_Scheduler::Task& task = get_task(i);
+
+        uint32_t dt = uint16_t(_tick_counter - _last_run[i]);
+        const uint32_t interval_ticks = task_interval_ticks(task);
         if (dt < interval_ticks) {
             // this task is not yet scheduled to run again
             continue;
@@ -180,6 +254,7 @@ void AP_Scheduler::run(uint32_t time_available)
                   (unsigned)dt,
                   (unsigned)interval_ticks,
                   (unsigned)_task_time_allowed);
+            perf_info.task_slipped(i);
         }
 
         if (dt >= interval_ticks*max_task_slowdown) {
@@ -188,12 +263,32 @@ void AP_Scheduler::run(uint32_t time_available)
             task_not_achieved++;
         }
 
+#if AP_SCHEDULER_WORKERS_ENABLED
+        if (task.async_safe && _num_workers_started > 0) {
+            switch (dispatch_to_worker(i)) {
+            case WorkerDispatch::DISPATCHED:
+                _last_run[i] = _tick_counter;
+                continue;
+            case WorkerDispatch::STILL_RUNNING:
+                // don't run a task concurrently with itself, it
+                // stays due until the previous run finishes
+                continue;
+            case WorkerDispatch::NO_WORKER:
+                break;
+            }
+        }
+#endif
+
         if (_task_time_allowed > time_available) {
             // not enough time to run this task.  Continue loop -
             // maybe another task will fit into time remaining
             continue;
         }
 
+        // record how late the task is starting relative to the tick
+        // it became due on
+        perf_info.update_task_lateness((dt - interval_ticks) * get_loop_period_us() + (now - run_started_usec));
+
         // run it
         _task_time_started = now;
         hal.util->persistent_data.scheduler_task = i;
@@ -217,7 +312,10 @@ void AP_Scheduler::run(uint32_t time_available)
         now = AP_HAL::micros();
         uint32_t time_taken = now - _task_time_started;
 
-        if (time_taken > _task_time_allowed) {
+        const bool overrun = time_taken > _task_time_allowed;
+        perf_info.update_task_info(i, MIN(time_taken, (uint32_t)UINT16_MAX), overrun);
+
+        if (overrun) {
             // the event overran!
             debug(3, "Scheduler overrun task[%u-%s] (%u/%u)\n",
                   (unsigned)i,
@@ -242,6 +340,86 @@ void AP_Scheduler::run(uint32_t time_available)
     }
 }
 
+#if AP_SCHEDULER_WORKERS_ENABLED
+/*
+  create the worker threads for async safe tasks. If a thread can't be
+  created the tasks are run by the threads that were created, or
+  inline in the main thread if there are none
+ */
+void AP_Scheduler::start_workers(void)
+{
+    const uint8_t num_workers = MIN(uint8_t(MAX(_num_workers.get(), 0)), max_workers);
+    while (_num_workers_started < num_workers) {
+        TaskWorker *worker = new TaskWorker(*this);
+        if (worker == nullptr || !worker->start()) {
+            // the worker can't be freed as its thread may be running
+            hal.console->printf("Scheduler: worker %u thread failed\n", (unsigned)_num_workers_started);
+            return;
+        }
+        _workers[_num_workers_started++] = worker;
+    }
+}
+
+/*
+  try to run an async safe task in an idle worker thread
+ */
+AP_Scheduler::WorkerDispatch AP_Scheduler::dispatch_to_worker(uint8_t task_index)
+{
+    for (uint8_t w=0; w<_num_workers_started; w++) {
+        if (_workers[w]->is_running(task_index)) {
+            return WorkerDispatch::STILL_RUNNING;
+        }
+    }
+    for (uint8_t w=0; w<_num_workers_started; w++) {
+        if (_workers[w]->dispatch(task_index)) {
+            return WorkerDispatch::DISPATCHED;
+        }
+    }
+    return WorkerDispatch::NO_WORKER;
+}
+
+bool AP_Scheduler::TaskWorker::start(void)
+{
+    return hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&AP_Scheduler::TaskWorker::thread_main, void),
+                                        "sched_worker", 16384, AP_HAL::Scheduler::PRIORITY_IO, 0);
+}
+
+bool AP_Scheduler::TaskWorker::dispatch(uint8_t _task_index)
+{
+    {
+        WITH_SEMAPHORE(sem);
+        if (busy) {
+            return false;
+        }
+        busy = true;
+        task_index = _task_index;
+    }
+    start_sem.signal();
+    return true;
+}
+
+bool AP_Scheduler::TaskWorker::is_running(uint8_t _task_index)
+{
+    WITH_SEMAPHORE(sem);
+    return busy && task_index == _task_index;
+}
+
+void AP_Scheduler::TaskWorker::thread_main(void)
+{
+    while (true) {
+        start_sem.wait_blocking();
+        uint8_t idx;
+        {
+            WITH_SEMAPHORE(sem);
+            idx = task_index;
+        }
+        sched.get_task(idx).function();
+        WITH_SEMAPHORE(sem);
+        busy = false;
+    }
+}
+#endif // AP_SCHEDULER_WORKERS_ENABLED
+
 /*
   return number of micros until the current task reaches its deadline
  */
@@ -362,6 +540,7 @@ void AP_Scheduler::update_logging()
     if (_log_performance_bit != (uint32_t)-1 &&
         AP::logger().should_log(_log_performance_bit)) {
         Log_Write_Performance();
+        Log_Write_TaskInfo();
     }
     perf_info.set_loop_rate(get_loop_rate_hz());
     perf_info.reset();
@@ -387,6 +566,89 @@ void AP_Scheduler::Log_Write_Performance()
         extra_loop_us    : extra_loop_us,
     };
     AP::logger().WriteCriticalBlock(&pkt, sizeof(pkt));
+
+    struct log_SchedLatency lpkt = {
+        LOG_PACKET_HEADER_INIT(LOG_SCHED_LATENCY_MSG),
+        time_us          : pkt.time_us,
+        avg_lateness_us  : perf_info.get_avg_task_lateness(),
+        max_lateness_us  : perf_info.get_max_task_lateness(),
+    };
+    AP::logger().WriteBlock(&lpkt, sizeof(lpkt));
+
+    uint32_t log_write_retries, log_write_busy;
+    AP::logger().get_write_contention(log_write_retries, log_write_busy);
+    struct log_WriteContention cpkt = {
+        LOG_PACKET_HEADER_INIT(LOG_WRITE_CONTENTION_MSG),
+        time_us          : pkt.time_us,
+        retries          : log_write_retries,
+        busy             : log_write_busy,
+    };
+    AP::logger().WriteBlock(&cpkt, sizeof(cpkt));
+}
+
+// Write per-task timing packets, one per task that has run
+void AP_Scheduler::Log_Write_TaskInfo()
+{
+    const uint64_t now = AP_HAL::micros64();
+    for (uint8_t i=0; i<_num_tasks; i++) {
+        const AP::PerfInfo::TaskInfo *ti = perf_info.get_task_info(i);
+        if (ti == nullptr) {
+            return;
+        }
+        if (ti->tick_count == 0) {
+            continue;
+        }
+        struct log_TaskInfo pkt = {
+            LOG_PACKET_HEADER_INIT(LOG_TASKINFO_MSG),
+            time_us       : now,
+            task_id       : i,
+            name          : {},
+            tick_count    : ti->tick_count,
+            min_time_us   : ti->min_time_us,
+            avg_time_us   : ti->get_avg_time_us(),
+            p99_time_us   : ti->get_percentile_time_us(99),
+            max_time_us   : ti->max_time_us,
+            slip_count    : ti->slip_count,
+            overrun_count : ti->overrun_count,
+        };
+        strncpy(pkt.name, get_task(i).name, sizeof(pkt.name));
+        AP::logger().WriteBlock(&pkt, sizeof(pkt));
+    }
+}
+
+/*
+  fill buf with a text table of per-task timing statistics. The
+  return value is the length of the full table, which may be larger
+  than bufsize in which case the table is truncated. P99US is the
+  upper edge of a log2 histogram bucket, so may be up to 2x high
+ */
+uint32_t AP_Scheduler::task_info(char *buf, uint32_t bufsize) const
+{
+    uint32_t len = 0;
+#define TASK_INFO_PRINTF(fmt, args...) do {                             \
+        const int n = hal.util->snprintf(&buf[MIN(len, bufsize)], bufsize - MIN(len, bufsize), fmt, ##args); \
+        if (n > 0) { len += n; }                                        \
+    } while (0)
+
+    TASK_INFO_PRINTF("%-24s %8s %6s %6s %6s %6s %6s %6s\n",
+                     "Task", "Count", "MinUS", "AvgUS", "P99US", "MaxUS", "Slip", "Ovr");
+    for (uint8_t i=0; i<_num_tasks; i++) {
+        const AP::PerfInfo::TaskInfo *ti = perf_info.get_task_info(i);
+        if (ti == nullptr) {
+            break;
+        }
+        TASK_INFO_PRINTF("%-24.24s %8lu %6u %6u %6u %6u %6u %6u\n",
+                         get_task(i).name,
+                         (unsigned long)ti->tick_count,
+                         (unsigned)ti->min_time_us,
+                         (unsigned)ti->get_avg_time_us(),
+                         (unsigned)ti->get_percentile_time_us(99),
+                         (unsigned)ti->max_time_us,
+                         (unsigned)ti->slip_count,
+                         (unsigned)ti->overrun_count);
+    }
+#undef TASK_INFO_PRINTF
+    return len;
 }
 
 namespace AP {
@@ -28,6 +28,14 @@
 #define AP_SCHEDULER_NAME_INITIALIZER(_name) .name = #_name,
 #define LOOP_RATE 0
 
+/*
+  tasks marked as async safe can be run in worker threads on boards
+  with multiple CPU cores, freeing time in the main loop
+ */
+#ifndef AP_SCHEDULER_WORKERS_ENABLED
+#define AP_SCHEDULER_WORKERS_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_LINUX)
+#endif
+
 /*
   useful macro for creating scheduler task table
  */
@@ -38,6 +46,34 @@
     .max_time_micros = _max_time_micros\
 }
 
+/*
+  as SCHED_TASK_CLASS, with a priority class for the earliest deadline
+  first scheduling policy. Lower values are run first, tasks declared
+  without a priority are in class 0
+ */
+#define SCHED_TASK_CLASS_PRIORITY(classname, classptr, func, _rate_hz, _max_time_micros, _priority) { \
+    .function = FUNCTOR_BIND(classptr, &classname::func, void),\
+    AP_SCHEDULER_NAME_INITIALIZER(func)\
+    .rate_hz = _rate_hz,\
+    .max_time_micros = _max_time_micros,\
+    .priority = _priority\
+}
+
+/*
+  as SCHED_TASK_CLASS, for a task that may run in a worker thread
+  concurrently with the main loop and with other async safe tasks. The
+  task must protect any state it shares with other threads using
+  semaphores, and should not call time_available_usec()
+ */
+#define SCHED_TASK_CLASS_ASYNC(classname, classptr, func, _rate_hz, _max_time_micros) { \
+    .function = FUNCTOR_BIND(classptr, &classname::func, void),\
+    AP_SCHEDULER_NAME_INITIALIZER(func)\
+    .rate_hz = _rate_hz,\
+    .max_time_micros = _max_time_micros,\
+    .priority = 0,\
+    .async_safe = true\
+}
+
 /*
   A task scheduler for APM main loops
 
@@ -72,6 +108,8 @@ public:
         const char *name;
         float rate_hz;
         uint16_t max_time_micros;
+        uint8_t priority;
+        bool async_safe;
     };
 
     // initialise scheduler
@@ -87,6 +125,13 @@ public:
     // write out PERF message to logger
     void Log_Write_Performance();
 
+    // write out per-task timing messages to logger
+    void Log_Write_TaskInfo();
+
+    // fill buf with a text table of per-task timing statistics,
+    // returning the length of the full table as for snprintf
+    uint32_t task_info(char *buf, uint32_t bufsize) const;
+
     // call when one tick has passed
     void tick(void);
 
@@ -159,6 +204,80 @@ private:
     // used to enable scheduler debugging
     AP_Int8 _debug;
 
+    // scheduler options
+    AP_Int8 _options;
+
+    enum class Options : uint8_t {
+        RECORD_TASK_INFO = 1 << 0,
+    };
+
+    // task scheduling policy
+    AP_Int8 _policy;
+
+    enum class Policy : uint8_t {
+        ROUND_ROBIN = 0,
+        EARLIEST_DEADLINE_FIRST = 1,
+    };
+
+    // return the number of ticks between runs of a task
+    uint32_t task_interval_ticks(const Task &task) const;
+
+    // fill _run_order with the due tasks sorted by priority class and
+    // deadline, returning the number of due tasks
+    uint8_t sort_due_tasks();
+
+#if AP_SCHEDULER_WORKERS_ENABLED
+    // number of worker threads for async safe tasks
+    AP_Int8 _num_workers;
+
+    // a thread that runs one async safe task at a time
+    class TaskWorker {
+    public:
+        TaskWorker(AP_Scheduler &_sched) : sched(_sched) {}
+
+        // create the worker thread
+        bool start(void);
+
+        // start running a task in the worker thread. Returns false
+        // if the worker is still running a previous task
+        bool dispatch(uint8_t task_index);
+
+        // return true if the worker is running the given task
+        bool is_running(uint8_t task_index);
+
+    private:
+        void thread_main(void);
+
+        AP_Scheduler &sched;
+        // protects busy and task_index
+        HAL_Semaphore sem;
+        bool busy;
+        uint8_t task_index;
+        HAL_BinarySemaphore start_sem;
+    };
+
+    static constexpr uint8_t max_workers = 4;
+    TaskWorker *_workers[max_workers];
+    uint8_t _num_workers_started;
+
+    // create the worker threads
+    void start_workers(void);
+
+    enum class WorkerDispatch : uint8_t {
+        DISPATCHED,     // task is now running in a worker
+        STILL_RUNNING,  // the previous run of the task has not finished
+        NO_WORKER,      // all workers are busy, run the task inline
+    };
+
+    // try to run an async safe task in a worker thread
+    WorkerDispatch dispatch_to_worker(uint8_t task_index);
+#endif
+
+    // return the task table entry for task index i
+    const Task &get_task(uint8_t i) const {
+        return (i < _num_unshared_tasks) ? _tasks[i] : _common_tasks[i - _num_unshared_tasks];
+    }
+
     // overall scheduling rate in Hz
     AP_Int16 _loop_rate_hz;
 
@@ -190,6 +309,10 @@ private:
     // tick counter at the time we last ran each task
     uint16_t *_last_run;
 
+    // order in which to consider tasks for the earliest deadline first
+    // scheduling policy
+    uint8_t *_run_order;
+
     // number of microseconds allowed for the current task
     uint32_t _task_time_allowed;
 
@@ -21,6 +21,9 @@ void AP::PerfInfo::reset()
     long_running = 0;
     sigma_time = 0;
     sigmasquared_time = 0;
+    task_count = 0;
+    sigma_task_lateness = 0;
+    max_task_lateness = 0;
 }
 
 // ignore_loop - ignore this loop from performance measurements (used to reduce false positive when arming)
@@ -112,6 +115,31 @@ float AP::PerfInfo::get_filtered_time() const
     return filtered_loop_time;
 }
 
+// update_task_lateness - record how late a task started relative to when it was due (in microseconds)
+void AP::PerfInfo::update_task_lateness(uint32_t lateness_us)
+{
+    task_count++;
+    sigma_task_lateness += lateness_us;
+    if (lateness_us > max_task_lateness) {
+        max_task_lateness = lateness_us;
+    }
+}
+
+// get_avg_task_lateness - return average task lateness (in microseconds)
+uint32_t AP::PerfInfo::get_avg_task_lateness() const
+{
+    if (task_count == 0) {
+        return 0;
+    }
+    return sigma_task_lateness / task_count;
+}
+
+// get_max_task_lateness - return maximum task lateness (in microseconds)
+uint32_t AP::PerfInfo::get_max_task_lateness() const
+{
+    return max_task_lateness;
+}
+
 void AP::PerfInfo::update_logging()
 {
     gcs().send_text(MAV_SEVERITY_WARNING,
@@ -135,3 +163,108 @@ void AP::PerfInfo::set_loop_rate(uint16_t rate_hz)
         filtered_loop_time = 1.0f / rate_hz;
     }
 }
+
+// allocate_task_info - allocate per-task statistics for num_tasks tasks
+void AP::PerfInfo::allocate_task_info(uint8_t num_tasks)
+{
+    if (_task_info != nullptr) {
+        return;
+    }
+    _task_info = new TaskInfo[num_tasks];
+    if (_task_info == nullptr) {
+        return;
+    }
+    memset(_task_info, 0, sizeof(TaskInfo) * num_tasks);
+    _num_tasks = num_tasks;
+}
+
+// update_task_info - record one run of a scheduler task
+void AP::PerfInfo::update_task_info(uint8_t task_index, uint16_t task_time_us, bool overrun)
+{
+    if (_task_info == nullptr || task_index >= _num_tasks) {
+        return;
+    }
+    _task_info[task_index].update(task_time_us, overrun);
+}
+
+// task_slipped - record a scheduler task missing its scheduled run
+void AP::PerfInfo::task_slipped(uint8_t task_index)
+{
+    if (_task_info == nullptr || task_index >= _num_tasks) {
+        return;
+    }
+    _task_info[task_index].slip_count++;
+}
+
+// get_task_info - return statistics for a task, or nullptr if not kept
+const AP::PerfInfo::TaskInfo *AP::PerfInfo::get_task_info(uint8_t task_index) const
+{
+    if (_task_info == nullptr || task_index >= _num_tasks) {
+        return nullptr;
+    }
+    return &_task_info[task_index];
+}
+
+/*
+  update task statistics with one execution time. This runs after
+  every task so is kept to a handful of integer operations
+ */
+void AP::PerfInfo::TaskInfo::update(uint16_t task_time_us, bool overrun)
+{
+    if (tick_count == 0 || task_time_us < min_time_us) {
+        min_time_us = task_time_us;
+    }
+    if (task_time_us > max_time_us) {
+        max_time_us = task_time_us;
+    }
+    elapsed_time_us += task_time_us;
+    tick_count++;
+    if (overrun) {
+        overrun_count++;
+    }
+
+    // bucket is the index of the most significant bit of the time
+    const uint8_t bucket = task_time_us == 0 ? 0 : MIN(31 - __builtin_clz(task_time_us), TASK_HIST_BUCKETS-1);
+    if (hist[bucket] == UINT16_MAX) {
+        // halve all buckets rather than saturate, keeping the shape of
+        // the distribution while giving more weight to recent runs
+        for (uint8_t i=0; i<TASK_HIST_BUCKETS; i++) {
+            hist[i] /= 2;
+        }
+    }
+    hist[bucket]++;
+}
+
+// get_avg_time_us - return average task execution time in microseconds
+uint16_t AP::PerfInfo::TaskInfo::get_avg_time_us() const
+{
+    if (tick_count == 0) {
+        return 0;
+    }
+    return elapsed_time_us / tick_count;
+}
+
+/*
+  return an upper bound on the given percentile of task execution time
+  in microseconds, taken from the histogram. The result is the top of
+  the bucket holding the percentile, limited to the maximum time seen
+ */
+uint16_t AP::PerfInfo::TaskInfo::get_percentile_time_us(uint8_t percent) const
+{
+    uint32_t total = 0;
+    for (uint8_t i=0; i<TASK_HIST_BUCKETS; i++) {
+        total += hist[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    const uint32_t threshold = (total * percent + 99) / 100;
+    uint32_t count = 0;
+    for (uint8_t i=0; i<TASK_HIST_BUCKETS-1; i++) {
+        count += hist[i];
+        if (count >= threshold) {
+            return MIN((1U<<(i+1))-1, max_time_us);
+        }
+    }
+    return max_time_us;
+}
@@ -22,10 +22,42 @@ public:
     uint32_t get_avg_time() const;
     uint32_t get_stddev_time() const;
     float    get_filtered_time() const;
+    void update_task_lateness(uint32_t lateness_us);
+    uint32_t get_avg_task_lateness() const;
+    uint32_t get_max_task_lateness() const;
     void set_loop_rate(uint16_t rate_hz);
 
     void update_logging();
 
+    // number of log2 scaled buckets in the per-task time histograms
+    static constexpr uint8_t TASK_HIST_BUCKETS = 16;
+
+    // execution time statistics for a single scheduler task
+    struct TaskInfo {
+        uint16_t min_time_us;
+        uint16_t max_time_us;
+        uint64_t elapsed_time_us;
+        uint32_t tick_count;
+        uint32_t slip_count;
+        uint32_t overrun_count;
+        // histogram of execution times. Bucket n counts times from
+        // 2^n to 2^(n+1)-1 microseconds, with the last bucket also
+        // counting all longer times
+        uint16_t hist[TASK_HIST_BUCKETS];
+
+        void update(uint16_t task_time_us, bool overrun);
+        uint16_t get_avg_time_us() const;
+        // returns the upper edge of the histogram bucket holding the
+        // given percentile, so may be up to 2x the true value
+        uint16_t get_percentile_time_us(uint8_t percent) const;
+    };
+
+    // per-task statistics are only kept once they have been allocated
+    void allocate_task_info(uint8_t num_tasks);
+    void update_task_info(uint8_t task_index, uint16_t task_time_us, bool overrun);
+    void task_slipped(uint8_t task_index);
+    const TaskInfo *get_task_info(uint8_t task_index) const;
+
 private:
     uint16_t loop_rate_hz;
     uint16_t overtime_threshold_micros;
@@ -38,6 +70,12 @@ private:
     uint32_t last_check_us;
     float filtered_loop_time;
     bool ignore_loop;
+    uint32_t task_count;
+    uint64_t sigma_task_lateness;
+    uint32_t max_task_lateness;
+
+    TaskInfo *_task_info = nullptr;
+    uint8_t _num_tasks;
 
 };
 
@@ -0,0 +1,73 @@
+#include <AP_gtest.h>
+
+#include <AP_Scheduler/PerfInfo.h>
+
+/*
+  check the per-task execution time statistics
+ */
+
+TEST(PerfInfoTest, TaskInfoStats)
+{
+    AP::PerfInfo::TaskInfo ti {};
+
+    // 98 short runs and 2 long ones
+    for (uint8_t i = 0; i < 98; i++) {
+        ti.update(10, false);
+    }
+    ti.update(300, true);
+    ti.update(5000, true);
+
+    EXPECT_EQ(100U, ti.tick_count);
+    EXPECT_EQ(10U, ti.min_time_us);
+    EXPECT_EQ(5000U, ti.max_time_us);
+    EXPECT_EQ(2U, ti.overrun_count);
+    EXPECT_EQ((98U*10U + 300U + 5000U) / 100U, ti.get_avg_time_us());
+
+    // 10us lands in the 8-15us bucket
+    EXPECT_EQ(98U, ti.hist[3]);
+    EXPECT_EQ(15U, ti.get_percentile_time_us(50));
+    // the 99th percentile is the 300us run, in the 256-511us bucket
+    EXPECT_EQ(511U, ti.get_percentile_time_us(99));
+    // the top percentile is limited to the maximum time seen
+    EXPECT_EQ(5000U, ti.get_percentile_time_us(100));
+}
+
+TEST(PerfInfoTest, TaskInfoHistogramDecay)
+{
+    AP::PerfInfo::TaskInfo ti {};
+
+    ti.update(0, false);
+    ti.update(1, false);
+    EXPECT_EQ(2U, ti.hist[0]);
+
+    // a full bucket halves the histogram rather than saturating
+    for (uint32_t i = 0; i <= UINT16_MAX; i++) {
+        ti.update(100, false);
+    }
+    EXPECT_EQ(1U, ti.hist[0]);
+    EXPECT_EQ(UINT16_MAX/2U + 1U, ti.hist[6]);
+
+    // very long runs are counted in the last bucket
+    ti.update(UINT16_MAX, true);
+    EXPECT_EQ(1U, ti.hist[AP::PerfInfo::TASK_HIST_BUCKETS-1]);
+}
+
+TEST(PerfInfoTest, TaskInfoLongRunning)
+{
+    AP::PerfInfo::TaskInfo ti {};
+
+    // a total execution time past 2^32us, about 72 minutes, must not
+    // wrap the average
+    ti.elapsed_time_us = UINT32_MAX;
+    ti.tick_count = UINT32_MAX / 1000U;
+    ti.update(1000, false);
+    EXPECT_EQ(1000U, ti.get_avg_time_us());
+
+    // more than 65535 overruns are counted
+    for (uint32_t i = 0; i <= UINT16_MAX; i++) {
+        ti.update(10, true);
+    }
+    EXPECT_EQ(UINT16_MAX + 1U, ti.overrun_count);
+}
+
+AP_GTEST_MAIN()
@@ -201,8 +201,11 @@ public:
 
     mavlink_channel_t get_chan() const { return chan; }
     uint32_t get_last_heartbeat_time() const { return last_heartbeat_time; };
+    // time we last handled a message received on this link
+    uint32_t get_last_received_ms() const { return last_received_ms; }
 
     uint32_t        last_heartbeat_time; // milliseconds
+    uint32_t        last_received_ms;
 
     // last time we got a non-zero RSSI from RADIO_STATUS
     static uint32_t last_radio_status_remrssi_ms;
@@ -305,6 +308,11 @@ public:
      */
     static bool find_by_mavtype(uint8_t mav_type, uint8_t &sysid, uint8_t &compid, mavlink_channel_t &channel) { return routing.find_by_mavtype(mav_type, sysid, compid, channel); }
 
+    /*
+      text report of the routing table, returns the length of the whole report
+     */
+    static uint32_t routing_info(char *buf, uint32_t bufsize) { return routing.route_info(buf, bufsize); }
+
     // update signing timestamp on GPS lock
     static void update_signing_timestamp(uint64_t timestamp_usec);
 
@@ -532,6 +540,9 @@ private:
                                                          // parameters for
                                                          // queued send
     uint32_t                    _queued_parameter_send_time_ms;
+    uint32_t                    _queued_parameter_start_ms; ///< time the
+                                                            // list was
+                                                            // requested
 
     /// Count the number of reportable parameters.
     ///
@@ -730,21 +741,61 @@ private:
         Write,
     };
 
-    struct ftp_state {
-        ObjectBuffer<pending_ftp> *requests;
-        ObjectBuffer<pending_ftp> *replies;
-
-        // session specific info, currently only support a single session over all links
+    struct ftp_session {
         int fd = -1;
         FTP_FILE_MODE mode; // work around AP_Filesystem not supporting file modes
-        int16_t current_session;
+        int16_t id = -1; // session number, -1 if the session is free
+
+        // the client which opened the session. Session numbers are
+        // chosen by the client, so two clients may use the same one
+        mavlink_channel_t chan;
+        uint8_t sysid;
+        uint8_t compid;
+
+        // file data read ahead of the requests, read sessions only
+        uint8_t *read_buf;
+        uint32_t read_buf_ofs;
+        uint16_t read_buf_len;
+
+        // burst read in progress, sent as the link has space for it
+        struct {
+            uint32_t offset; // of the next reply
+            uint16_t seq_number; // of the next reply
+            uint16_t remaining; // replies left to send, 0 if none
+            uint8_t size; // of each reply
+        } burst;
+    };
+
+    struct ftp_link {
+        ObjectBuffer<pending_ftp> *replies;
         uint32_t last_send_ms;
+
+        // replies sent in the last second, used to size bursts
+        uint32_t rate_start_ms;
+        uint16_t sent;
+        uint16_t send_rate;
+    };
+
+    struct ftp_state {
+        ObjectBuffer<pending_ftp> *requests;
+
+        // replies are queued per link so a slow link does not hold up
+        // the others
+        struct ftp_link links[MAVLINK_COMM_NUM_BUFFERS];
+
+        struct ftp_session sessions[4];
     };
     static struct ftp_state ftp;
 
     static void ftp_error(struct pending_ftp &response, FTP_ERROR error); // FTP helper method for packing a NAK
     static int gen_dir_entry(char *dest, size_t space, const char * path, const struct dirent * entry); // FTP helper for emitting a dir response
     static void ftp_list_dir(struct pending_ftp &request, struct pending_ftp &response);
+    static bool ftp_session_owner(const struct ftp_session &session, const struct pending_ftp &request);
+    static struct ftp_session *ftp_find_session(const struct pending_ftp &request);
+    static struct ftp_session *ftp_open_session(const struct pending_ftp &request);
+    static int ftp_close_session(struct ftp_session &session);
+    static ssize_t ftp_read(struct ftp_session &session, uint32_t offset, uint8_t *data, uint8_t len);
+    static bool ftp_burst_step(void);
 
     bool ftp_init(void);
     void handle_file_transfer_protocol(const mavlink_message_t &msg);
@@ -848,7 +848,7 @@ uint16_t GCS_MAVLINK::get_reschedule_interval_ms(const deferred_message_bucket_t
         interval_ms *= 4;
     }
 #if HAVE_FILESYSTEM_SUPPORT
-    if (ftp.replies && AP_HAL::millis() - ftp.last_send_ms < 500) {
+    if (ftp.links[chan].replies && AP_HAL::millis() - ftp.links[chan].last_send_ms < 500) {
         // we are sending ftp replies
         interval_ms *= 4;
     }
@@ -1311,6 +1311,7 @@ void GCS_MAVLINK::packetReceived(const mavlink_status_t &status,
         // e.g. enforce-sysid says we shouldn't look at this packet
         return;
     }
+    last_received_ms = AP_HAL::millis();
     handleMessage(msg);
 }
 
@@ -24,37 +24,45 @@
 
 extern const AP_HAL::HAL& hal;
 
+// size of the buffer each read session reads the file ahead into
+#ifndef FTP_READ_AHEAD_SIZE
+#if HAL_MEM_CLASS >= HAL_MEM_CLASS_500
+#define FTP_READ_AHEAD_SIZE 4096
+#else
+#define FTP_READ_AHEAD_SIZE 1024
+#endif
+#endif
+
+// number of replies a burst read sends before the GCS asks for more;
+// bursts are sized to take about half a second on their link
+#define FTP_BURST_MIN_REPLIES 100
+#define FTP_BURST_MAX_REPLIES 1000
+
 struct GCS_MAVLINK::ftp_state GCS_MAVLINK::ftp;
 
 bool GCS_MAVLINK::ftp_init(void) {
     // we can simply check if we allocated everything we need
-    if (ftp.requests != nullptr) {
+    if (ftp.requests != nullptr && ftp.links[chan].replies != nullptr) {
         return true;
     }
 
-    ftp.requests = new ObjectBuffer<pending_ftp>(5);
     if (ftp.requests == nullptr) {
-        goto failed;
-    }
-    ftp.replies = new ObjectBuffer<pending_ftp>(30);
-    if (ftp.replies == nullptr) {
-        goto failed;
-    }
+        ftp.requests = new ObjectBuffer<pending_ftp>(5);
+        if (ftp.requests == nullptr) {
+            return false;
+        }
 
-    if (!hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&GCS_MAVLINK::ftp_worker, void),
-                                      "FTP", 3072, AP_HAL::Scheduler::PRIORITY_IO, 0)) {
-        goto failed;
+        if (!hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&GCS_MAVLINK::ftp_worker, void),
+                                          "FTP", 3072, AP_HAL::Scheduler::PRIORITY_IO, 0)) {
+            delete ftp.requests;
+            ftp.requests = nullptr;
+            return false;
+        }
     }
 
-    return true;
-
-failed:
-    delete ftp.requests;
-    ftp.requests = nullptr;
-    delete ftp.replies;
-    ftp.replies = nullptr;
-
-    return false;
+    // replies for this link, allocated when the link first uses FTP
+    ftp.links[chan].replies = new ObjectBuffer<pending_ftp>(20);
+    return ftp.links[chan].replies != nullptr;
 }
 
 void GCS_MAVLINK::handle_file_transfer_protocol(const mavlink_message_t &msg) {
@@ -85,10 +93,18 @@ void GCS_MAVLINK::handle_file_transfer_protocol(const mavlink_message_t &msg) {
 }
 
 void GCS_MAVLINK::send_ftp_replies(void) {
-    if (ftp.replies == nullptr) {
+    struct ftp_link &link = ftp.links[chan];
+    if (link.replies == nullptr) {
         return;
     }
 
+    const uint32_t now = AP_HAL::millis();
+    if (now - link.rate_start_ms >= 1000) {
+        link.send_rate = link.sent;
+        link.sent = 0;
+        link.rate_start_ms = now;
+    }
+
     for (uint8_t i = 0; i < 20; i++) {
         if (!HAVE_PAYLOAD_SPACE(chan, FILE_TRANSFER_PROTOCOL)) {
             return;
@@ -100,7 +116,7 @@ void GCS_MAVLINK::send_ftp_replies(void) {
 
         struct pending_ftp reply;
         uint8_t payload[251] = {};
-        if (ftp.replies->peek(reply) && (reply.chan == chan)) {
+        if (link.replies->peek(reply)) {
                 ((uint16_t *)payload)[0] = reply.seq_number;
                 payload[2] = reply.session;
                 payload[3] = static_cast<uint8_t>(reply.opcode);
@@ -113,8 +129,9 @@ void GCS_MAVLINK::send_ftp_replies(void) {
                     reply.chan,
                     0, reply.sysid, reply.compid,
                     payload);
-                ftp.replies->pop(reply);
-                ftp.last_send_ms = AP_HAL::millis();
+                link.replies->pop(reply);
+                link.last_send_ms = now;
+                link.sent++;
         } else {
             return;
         }
@@ -147,24 +164,177 @@ void GCS_MAVLINK::ftp_error(struct pending_ftp &response, FTP_ERROR error) {
 // send our response back out to the system
 void GCS_MAVLINK::ftp_push_replies(pending_ftp &reply)
 {
-    while (!ftp.replies->push(reply)) { // we must fit the response, keep shoving it in
+    while (!ftp.links[reply.chan].replies->push(reply)) { // we must fit the response, keep shoving it in
         hal.scheduler->delay(2);
     }
 }
 
+// true if an open session belongs to the client which sent a request
+bool GCS_MAVLINK::ftp_session_owner(const struct ftp_session &session, const struct pending_ftp &request)
+{
+    return session.id != -1 &&
+        session.chan == request.chan &&
+        session.sysid == request.sysid &&
+        session.compid == request.compid;
+}
+
+// find the requesting client's open session
+GCS_MAVLINK::ftp_session *GCS_MAVLINK::ftp_find_session(const struct pending_ftp &request)
+{
+    for (struct ftp_session &session : ftp.sessions) {
+        if (ftp_session_owner(session, request) && session.id == request.session) {
+            return &session;
+        }
+    }
+    return nullptr;
+}
+
+// start a session for the requesting client, returns nullptr if there
+// are no free sessions
+GCS_MAVLINK::ftp_session *GCS_MAVLINK::ftp_open_session(const struct pending_ftp &request)
+{
+    for (struct ftp_session &session : ftp.sessions) {
+        if (session.id == -1) {
+            session.id = request.session;
+            session.chan = request.chan;
+            session.sysid = request.sysid;
+            session.compid = request.compid;
+            session.fd = -1;
+            session.read_buf_len = 0;
+            session.burst.remaining = 0;
+            return &session;
+        }
+    }
+    return nullptr;
+}
+
+/*
+  close a session, returning the result of closing its file. A file
+  being written may only be checked on close, so a failure here means
+  the written data was rejected and errno says why
+ */
+int GCS_MAVLINK::ftp_close_session(struct ftp_session &session)
+{
+    int ret = 0;
+    if (session.fd != -1) {
+        ret = AP::FS().close(session.fd);
+        session.fd = -1;
+    }
+    delete[] session.read_buf;
+    session.read_buf = nullptr;
+    session.read_buf_len = 0;
+    session.burst.remaining = 0;
+    session.id = -1;
+    return ret;
+}
+
+/*
+  read from a session's file. Reads are served from the read ahead
+  buffer when they can be, so sequential reads of small replies cost
+  one filesystem read per FTP_READ_AHEAD_SIZE bytes
+ */
+ssize_t GCS_MAVLINK::ftp_read(struct ftp_session &session, uint32_t offset, uint8_t *data, uint8_t len)
+{
+    if (session.read_buf == nullptr) {
+        // no memory for read ahead
+        if (AP::FS().lseek(session.fd, offset, SEEK_SET) == -1) {
+            return -1;
+        }
+        return AP::FS().read(session.fd, data, len);
+    }
+
+    if (offset < session.read_buf_ofs ||
+        offset + len > session.read_buf_ofs + session.read_buf_len) {
+        // refill from offset; near the end of the file this re-reads
+        // in case the file has grown
+        if (AP::FS().lseek(session.fd, offset, SEEK_SET) == -1) {
+            return -1;
+        }
+        const ssize_t read_bytes = AP::FS().read(session.fd, session.read_buf, FTP_READ_AHEAD_SIZE);
+        if (read_bytes == -1) {
+            session.read_buf_len = 0;
+            return -1;
+        }
+        session.read_buf_ofs = offset;
+        session.read_buf_len = read_bytes;
+    }
+
+    const uint32_t n = MIN(uint32_t(len), session.read_buf_ofs + session.read_buf_len - offset);
+    memcpy(data, &session.read_buf[offset - session.read_buf_ofs], n);
+    return n;
+}
+
+/*
+  send more of the bursts in progress, one reply per session in turn
+  for as long as their links have queue space. This paces each burst
+  to the rate its link sends at without holding up the others. Returns
+  true if any replies were queued
+ */
+bool GCS_MAVLINK::ftp_burst_step(void)
+{
+    bool ret = false;
+    bool progress;
+    do {
+        progress = false;
+        for (struct ftp_session &session : ftp.sessions) {
+            if (session.id == -1 || session.burst.remaining == 0 ||
+                ftp.links[session.chan].replies->space() == 0) {
+                continue;
+            }
+
+            pending_ftp reply {};
+            reply.req_opcode = FTP_OP::BurstReadFile;
+            reply.session = session.id;
+            reply.seq_number = session.burst.seq_number++;
+            reply.chan = session.chan;
+            reply.sysid = session.sysid;
+            reply.compid = session.compid;
+
+            const ssize_t read_bytes = ftp_read(session, session.burst.offset, reply.data, session.burst.size);
+            if (read_bytes <= 0) {
+                // the NAK ends the burst, and says where it ended so
+                // the client can tell which request it answers
+                ftp_error(reply, read_bytes == 0 ? FTP_ERROR::EndOfFile : FTP_ERROR::FailErrno);
+                reply.offset = session.burst.offset;
+                reply.burst_complete = true;
+                session.burst.remaining = 0;
+            } else {
+                session.burst.remaining--;
+                reply.opcode = FTP_OP::Ack;
+                reply.offset = session.burst.offset;
+                reply.burst_complete = (session.burst.remaining == 0);
+                reply.size = (uint8_t)read_bytes;
+                session.burst.offset += read_bytes;
+            }
+
+            ftp.links[reply.chan].replies->push(reply);
+            progress = true;
+            ret = true;
+        }
+    } while (progress);
+    return ret;
+}
+
 void GCS_MAVLINK::ftp_worker(void) {
     pending_ftp request;
     pending_ftp reply = {};
     reply.session = -1; // flag the reply as invalid for any reuse
 
     while (true) {
+        // keep bursts moving between requests
+        ftp_burst_step();
+
         while (!ftp.requests->pop(request)) {
-            // nothing to handle, delay ourselves a bit then check again. Ideally we'd use conditional waits here
-            hal.scheduler->delay(2);
+            // nothing to handle, so send more of any bursts or delay
+            // ourselves a bit then check again. Ideally we'd use
+            // conditional waits here
+            if (!ftp_burst_step()) {
+                hal.scheduler->delay(2);
+            }
         }
 
         // if it's a rerequest and we still have the last response then send it
-        if ((request.sysid == reply.sysid) && (request.compid = reply.compid) &&
+        if ((request.chan == reply.chan) && (request.sysid == reply.sysid) && (request.compid == reply.compid) &&
             (request.session == reply.session) && (request.seq_number + 1 == reply.seq_number)) {
             ftp_push_replies(reply);
             continue;
@@ -186,316 +356,304 @@ void GCS_MAVLINK::ftp_worker(void) {
             continue;
         }
 
-        // check for session termination
-        if (request.session != ftp.current_session &&
-            (request.opcode == FTP_OP::TerminateSession || request.opcode == FTP_OP::ResetSessions)) {
-            // terminating a different session, just ack
-            reply.opcode = FTP_OP::Ack;
-        } else if (ftp.fd != -1 && request.session != ftp.current_session) {
-            // if we have an open file and the session isn't right
-            // then reject. This prevents IO on the wrong file
-            ftp_error(reply, FTP_ERROR::InvalidSession);
-        } else {
-            // dispatch the command as needed
-            switch (request.opcode) {
-                case FTP_OP::None:
-                    reply.opcode = FTP_OP::Ack;
-                    break;
-                case FTP_OP::TerminateSession:
-                case FTP_OP::ResetSessions:
-                    // we already handled this, just listed for completeness
-                    if (ftp.fd != -1) {
-                        AP::FS().close(ftp.fd);
-                        ftp.fd = -1;
-                    }
-                    ftp.current_session = -1;
-                    reply.opcode = FTP_OP::Ack;
-                    break;
-                case FTP_OP::ListDirectory:
-                    ftp_list_dir(request, reply);
-                    break;
-                case FTP_OP::OpenFileRO:
-                    {
-                        // only allow one file to be open per session
-                        if (ftp.fd != -1) {
-                            ftp_error(reply, FTP_ERROR::Fail);
-                            break;
-                        }
+        // the session the request is for, if it is open. Sessions
+        // only do IO on their own file
+        struct ftp_session *session = ftp_find_session(request);
 
-                        // sanity check that our the request looks well formed
-                        const size_t file_name_len = strnlen((char *)request.data, sizeof(request.data));
-                        if ((file_name_len != request.size) || (request.size == 0)) {
-                            ftp_error(reply, FTP_ERROR::InvalidDataSize);
-                            break;
-                        }
+        // dispatch the command as needed
+        switch (request.opcode) {
+            case FTP_OP::None:
+                reply.opcode = FTP_OP::Ack;
+                break;
+            case FTP_OP::TerminateSession:
+                // terminating a session which isn't open is just acked
+                reply.opcode = FTP_OP::Ack;
+                if (session != nullptr) {
+                    const bool writing = session->mode == FTP_FILE_MODE::Write;
+                    if (ftp_close_session(*session) != 0 && writing) {
+                        // the client must not think the upload worked
+                        const int err = errno;
+                        ftp_error(reply, FTP_ERROR::FailErrno);
+                        gcs().send_text(MAV_SEVERITY_WARNING, "FTP: write failed on close (%d)", err);
+                    }
+                }
+                break;
+            case FTP_OP::ResetSessions:
+                // only the requesting client's sessions, other
+                // clients may be part way through transfers
+                for (struct ftp_session &s : ftp.sessions) {
+                    if (ftp_session_owner(s, request)) {
+                        ftp_close_session(s);
+                    }
+                }
+                reply.opcode = FTP_OP::Ack;
+                break;
+            case FTP_OP::ListDirectory:
+                ftp_list_dir(request, reply);
+                break;
+            case FTP_OP::OpenFileRO:
+                {
+                    // only allow one file to be open per session
+                    if (session != nullptr) {
+                        ftp_error(reply, FTP_ERROR::Fail);
+                        break;
+                    }
 
-                        request.data[sizeof(request.data) - 1] = 0; // ensure the path is null terminated
+                    // sanity check that our the request looks well formed
+                    const size_t file_name_len = strnlen((char *)request.data, sizeof(request.data));
+                    if ((file_name_len != request.size) || (request.size == 0)) {
+                        ftp_error(reply, FTP_ERROR::InvalidDataSize);
+                        break;
+                    }
 
-                        // get the file size
-                        struct stat st;
-                        if (AP::FS().stat((char *)request.data, &st)) {
-                            ftp_error(reply, FTP_ERROR::FailErrno);
-                            break;
-                        }
-                        const size_t file_size = st.st_size;
+                    request.data[sizeof(request.data) - 1] = 0; // ensure the path is null terminated
 
-                        // actually open the file
-                        ftp.fd = AP::FS().open((char *)request.data, 0);
-                        if (ftp.fd == -1) {
-                            ftp_error(reply, FTP_ERROR::FailErrno);
-                            break;
-                        }
-                        ftp.mode = FTP_FILE_MODE::Read;
-                        ftp.current_session = request.session;
+                    // get the file size
+                    struct stat st;
+                    if (AP::FS().stat((char *)request.data, &st)) {
+                        ftp_error(reply, FTP_ERROR::FailErrno);
+                        break;
+                    }
+                    const size_t file_size = st.st_size;
 
-                        reply.opcode = FTP_OP::Ack;
-                        reply.size = sizeof(uint32_t);
-                        *((int32_t *)reply.data) = (int32_t)file_size;
+                    session = ftp_open_session(request);
+                    if (session == nullptr) {
+                        ftp_error(reply, FTP_ERROR::NoSessionsAvailable);
                         break;
                     }
-                case FTP_OP::ReadFile:
-                    {
-                        // must actually be working on a file
-                        if (ftp.fd == -1) {
-                            ftp_error(reply, FTP_ERROR::FileNotFound);
-                            break;
-                        }
 
-                        // must have the file in read mode
-                        if ((ftp.mode != FTP_FILE_MODE::Read)) {
-                            ftp_error(reply, FTP_ERROR::Fail);
-                            break;
-                        }
+                    // actually open the file
+                    session->fd = AP::FS().open((char *)request.data, 0);
+                    if (session->fd == -1) {
+                        ftp_error(reply, FTP_ERROR::FailErrno);
+                        ftp_close_session(*session);
+                        break;
+                    }
+                    session->mode = FTP_FILE_MODE::Read;
+                    // reads go straight to the file if this fails
+                    session->read_buf = new uint8_t[FTP_READ_AHEAD_SIZE];
 
-                        // seek to requested offset
-                        if (AP::FS().lseek(ftp.fd, request.offset, SEEK_SET) == -1) {
-                            ftp_error(reply, FTP_ERROR::FailErrno);
-                            break;
-                        }
+                    reply.opcode = FTP_OP::Ack;
+                    reply.size = sizeof(uint32_t);
+                    *((int32_t *)reply.data) = (int32_t)file_size;
+                    break;
+                }
+            case FTP_OP::ReadFile:
+                {
+                    // must actually be working on a file
+                    if (session == nullptr) {
+                        ftp_error(reply, FTP_ERROR::FileNotFound);
+                        break;
+                    }
 
-                        // fill the buffer
-                        const ssize_t read_bytes = AP::FS().read(ftp.fd, reply.data, request.size);
-                        if (read_bytes == -1) {
-                            ftp_error(reply, FTP_ERROR::FailErrno);
-                            break;
-                        }
-                        if (read_bytes == 0) {
-                            ftp_error(reply, FTP_ERROR::EndOfFile);
-                            break;
-                        }
+                    // must have the file in read mode
+                    if ((session->mode != FTP_FILE_MODE::Read)) {
+                        ftp_error(reply, FTP_ERROR::Fail);
+                        break;
+                    }
 
-                        reply.opcode = FTP_OP::Ack;
-                        reply.offset = request.offset;
-                        reply.size = (uint8_t)read_bytes;
+                    // fill the buffer
+                    const ssize_t read_bytes = ftp_read(*session, request.offset, reply.data, request.size);
+                    if (read_bytes == -1) {
+                        ftp_error(reply, FTP_ERROR::FailErrno);
                         break;
                     }
-                case FTP_OP::Ack:
-                case FTP_OP::Nack:
-                    // eat these, we just didn't expect them
-                    continue;
+                    if (read_bytes == 0) {
+                        ftp_error(reply, FTP_ERROR::EndOfFile);
+                        break;
+                    }
+
+                    reply.opcode = FTP_OP::Ack;
+                    reply.offset = request.offset;
+                    reply.size = (uint8_t)read_bytes;
                     break;
-                case FTP_OP::OpenFileWO:
-                case FTP_OP::CreateFile:
-                    {
-                        // only allow one file to be open per session
-                        if (ftp.fd != -1) {
-                            ftp_error(reply, FTP_ERROR::Fail);
-                            break;
-                        }
+                }
+            case FTP_OP::Ack:
+            case FTP_OP::Nack:
+                // eat these, we just didn't expect them
+                continue;
+                break;
+            case FTP_OP::OpenFileWO:
+            case FTP_OP::CreateFile:
+                {
+                    // only allow one file to be open per session
+                    if (session != nullptr) {
+                        ftp_error(reply, FTP_ERROR::Fail);
+                        break;
+                    }
 
-                        // sanity check that our the request looks well formed
-                        const size_t file_name_len = strnlen((char *)request.data, sizeof(request.data));
-                        if ((file_name_len != request.size) || (request.size == 0)) {
-                            ftp_error(reply, FTP_ERROR::InvalidDataSize);
-                            break;
-                        }
+                    // sanity check that our the request looks well formed
+                    const size_t file_name_len = strnlen((char *)request.data, sizeof(request.data));
+                    if ((file_name_len != request.size) || (request.size == 0)) {
+                        ftp_error(reply, FTP_ERROR::InvalidDataSize);
+                        break;
+                    }
 
-                        request.data[sizeof(request.data) - 1] = 0; // ensure the path is null terminated
+                    request.data[sizeof(request.data) - 1] = 0; // ensure the path is null terminated
 
-                        // actually open the file
-                        ftp.fd = AP::FS().open((char *)request.data,
-                                               (request.opcode == FTP_OP::CreateFile) ? O_WRONLY|O_CREAT|O_TRUNC : O_WRONLY);
-                        if (ftp.fd == -1) {
-                            ftp_error(reply, FTP_ERROR::FailErrno);
-                            break;
-                        }
-                        ftp.mode = FTP_FILE_MODE::Write;
-                        ftp.current_session = request.session;
+                    session = ftp_open_session(request);
+                    if (session == nullptr) {
+                        ftp_error(reply, FTP_ERROR::NoSessionsAvailable);
+                        break;
+                    }
 
-                        reply.opcode = FTP_OP::Ack;
+                    // actually open the file
+                    session->fd = AP::FS().open((char *)request.data,
+                                                (request.opcode == FTP_OP::CreateFile) ? O_WRONLY|O_CREAT|O_TRUNC : O_WRONLY);
+                    if (session->fd == -1) {
+                        ftp_error(reply, FTP_ERROR::FailErrno);
+                        ftp_close_session(*session);
                         break;
                     }
-                case FTP_OP::WriteFile:
-                    {
-                        // must actually be working on a file
-                        if (ftp.fd == -1) {
-                            ftp_error(reply, FTP_ERROR::FileNotFound);
-                            break;
-                        }
+                    session->mode = FTP_FILE_MODE::Write;
 
-                        // must have the file in write mode
-                        if ((ftp.mode != FTP_FILE_MODE::Write)) {
-                            ftp_error(reply, FTP_ERROR::Fail);
-                            break;
-                        }
+                    reply.opcode = FTP_OP::Ack;
+                    break;
+                }
+            case FTP_OP::WriteFile:
+                {
+                    // must actually be working on a file
+                    if (session == nullptr) {
+                        ftp_error(reply, FTP_ERROR::FileNotFound);
+                        break;
+                    }
 
-                        // seek to requested offset
-                        if (AP::FS().lseek(ftp.fd, request.offset, SEEK_SET) == -1) {
-                            ftp_error(reply, FTP_ERROR::FailErrno);
-                            break;
-                        }
+                    // must have the file in write mode
+                    if ((session->mode != FTP_FILE_MODE::Write)) {
+                        ftp_error(reply, FTP_ERROR::Fail);
+                        break;
+                    }
 
-                        // fill the buffer
-                        const ssize_t write_bytes = AP::FS().write(ftp.fd, request.data, request.size);
-                        if (write_bytes == -1) {
-                            ftp_error(reply, FTP_ERROR::FailErrno);
-                            break;
-                        }
+                    // seek to requested offset
+                    if (AP::FS().lseek(session->fd, request.offset, SEEK_SET) == -1) {
+                        ftp_error(reply, FTP_ERROR::FailErrno);
+                        break;
+                    }
 
-                        reply.opcode = FTP_OP::Ack;
-                        reply.offset = request.offset;
+                    // fill the buffer
+                    const ssize_t write_bytes = AP::FS().write(session->fd, request.data, request.size);
+                    if (write_bytes == -1) {
+                        ftp_error(reply, FTP_ERROR::FailErrno);
                         break;
                     }
-                case FTP_OP::CreateDirectory:
-                    {
-                        // sanity check that our the request looks well formed
-                        const size_t file_name_len = strnlen((char *)request.data, sizeof(request.data));
-                        if ((file_name_len != request.size) || (request.size == 0)) {
-                            ftp_error(reply, FTP_ERROR::InvalidDataSize);
-                            break;
-                        }
 
-                        request.data[sizeof(request.data) - 1] = 0; // ensure the path is null terminated
+                    reply.opcode = FTP_OP::Ack;
+                    reply.offset = request.offset;
+                    break;
+                }
+            case FTP_OP::CreateDirectory:
+                {
+                    // sanity check that our the request looks well formed
+                    const size_t file_name_len = strnlen((char *)request.data, sizeof(request.data));
+                    if ((file_name_len != request.size) || (request.size == 0)) {
+                        ftp_error(reply, FTP_ERROR::InvalidDataSize);
+                        break;
+                    }
 
-                        // actually make the directory
-                        if (AP::FS().mkdir((char *)request.data) == -1) {
-                            ftp_error(reply, FTP_ERROR::FailErrno);
-                            break;
-                        }
+                    request.data[sizeof(request.data) - 1] = 0; // ensure the path is null terminated
 
-                        reply.opcode = FTP_OP::Ack;
+                    // actually make the directory
+                    if (AP::FS().mkdir((char *)request.data) == -1) {
+                        ftp_error(reply, FTP_ERROR::FailErrno);
                         break;
                     }
-                case FTP_OP::RemoveDirectory:
-                case FTP_OP::RemoveFile:
-                    {
-                        // sanity check that our the request looks well formed
-                        const size_t file_name_len = strnlen((char *)request.data, sizeof(request.data));
-                        if ((file_name_len != request.size) || (request.size == 0)) {
-                            ftp_error(reply, FTP_ERROR::InvalidDataSize);
-                            break;
-                        }
 
-                        request.data[sizeof(request.data) - 1] = 0; // ensure the path is null terminated
+                    reply.opcode = FTP_OP::Ack;
+                    break;
+                }
+            case FTP_OP::RemoveDirectory:
+            case FTP_OP::RemoveFile:
+                {
+                    // sanity check that our the request looks well formed
+                    const size_t file_name_len = strnlen((char *)request.data, sizeof(request.data));
+                    if ((file_name_len != request.size) || (request.size == 0)) {
+                        ftp_error(reply, FTP_ERROR::InvalidDataSize);
+                        break;
+                    }
 
-                        // remove the file/dir
-                        if (AP::FS().unlink((char *)request.data) == -1) {
-                            ftp_error(reply, FTP_ERROR::FailErrno);
-                            break;
-                        }
+                    request.data[sizeof(request.data) - 1] = 0; // ensure the path is null terminated
 
-                        reply.opcode = FTP_OP::Ack;
+                    // remove the file/dir
+                    if (AP::FS().unlink((char *)request.data) == -1) {
+                        ftp_error(reply, FTP_ERROR::FailErrno);
                         break;
                     }
-                case FTP_OP::CalcFileCRC32:
-                    {
-                        // sanity check that our the request looks well formed
-                        const size_t file_name_len = strnlen((char *)request.data, sizeof(request.data));
-                        if ((file_name_len != request.size) || (request.size == 0)) {
-                            ftp_error(reply, FTP_ERROR::InvalidDataSize);
-                            break;
-                        }
 
-                        request.data[sizeof(request.data) - 1] = 0; // ensure the path is null terminated
+                    reply.opcode = FTP_OP::Ack;
+                    break;
+                }
+            case FTP_OP::CalcFileCRC32:
+                {
+                    // sanity check that our the request looks well formed
+                    const size_t file_name_len = strnlen((char *)request.data, sizeof(request.data));
+                    if ((file_name_len != request.size) || (request.size == 0)) {
+                        ftp_error(reply, FTP_ERROR::InvalidDataSize);
+                        break;
+                    }
 
-                        // actually open the file
-                        int fd = AP::FS().open((char *)request.data, O_RDONLY);
-                        if (fd == -1) {
-                            ftp_error(reply, FTP_ERROR::FailErrno);
-                            break;
-                        }
+                    request.data[sizeof(request.data) - 1] = 0; // ensure the path is null terminated
 
-                        uint32_t checksum = 0;
-                        ssize_t read_size;
-                        do {
-                            read_size = AP::FS().read(fd, reply.data, sizeof(reply.data));
-                            if (read_size == -1) {
-                                ftp_error(reply, FTP_ERROR::FailErrno);
-                                break;
-                            }
-                            checksum = crc_crc32(checksum, reply.data, MIN((size_t)read_size, sizeof(reply.data)));
-                        } while (read_size > 0);
-
-                        AP::FS().close(fd);
-
-                        // reset our scratch area so we don't leak data, and can leverage trimming
-                        memset(reply.data, 0, sizeof(reply.data));
-                        reply.size = sizeof(uint32_t);
-                        ((uint32_t *)reply.data)[0] = checksum;
-                        reply.opcode = FTP_OP::Ack;
+                    // actually open the file
+                    int fd = AP::FS().open((char *)request.data, O_RDONLY);
+                    if (fd == -1) {
+                        ftp_error(reply, FTP_ERROR::FailErrno);
                         break;
                     }
-                case FTP_OP::BurstReadFile:
-                    {
-                        const uint16_t max_read = (request.size == 0?sizeof(reply.data):request.size);
-                        // must actually be working on a file
-                        if (ftp.fd == -1) {
-                            ftp_error(reply, FTP_ERROR::FileNotFound);
-                            break;
-                        }
-
-                        // must have the file in read mode
-                        if ((ftp.mode != FTP_FILE_MODE::Read)) {
-                            ftp_error(reply, FTP_ERROR::Fail);
-                            break;
-                        }
 
-                        // seek to requested offset
-                        if (AP::FS().lseek(ftp.fd, request.offset, SEEK_SET) == -1) {
+                    uint32_t checksum = 0;
+                    ssize_t read_size;
+                    do {
+                        read_size = AP::FS().read(fd, reply.data, sizeof(reply.data));
+                        if (read_size == -1) {
                             ftp_error(reply, FTP_ERROR::FailErrno);
                             break;
                         }
+                        checksum = crc_crc32(checksum, reply.data, MIN((size_t)read_size, sizeof(reply.data)));
+                    } while (read_size > 0);
 
-                        const uint32_t transfer_size = 100;
-                        for (uint32_t i = 0; (i < transfer_size); i++) {
-                            // fill the buffer
-                            const ssize_t read_bytes = AP::FS().read(ftp.fd, reply.data, max_read);
-                            if (read_bytes == -1) {
-                                ftp_error(reply, FTP_ERROR::FailErrno);
-                                break;
-                            }
-
-                            if (read_bytes != sizeof(reply.data)) {
-                                // don't send any old data
-                                memset(reply.data + read_bytes, 0, sizeof(reply.data) - read_bytes);
-                            }
-
-                            if (read_bytes == 0) {
-                                ftp_error(reply, FTP_ERROR::EndOfFile);
-                                break;
-                            }
-
-                            reply.opcode = FTP_OP::Ack;
-                            reply.offset = request.offset + i * max_read;
-                            reply.burst_complete = (i == (transfer_size - 1));
-                            reply.size = (uint8_t)read_bytes;
-
-                            ftp_push_replies(reply);
-
-                            // prep the reply to be used again
-                            reply.seq_number++;
-                        }
+                    AP::FS().close(fd);
 
+                    // reset our scratch area so we don't leak data, and can leverage trimming
+                    memset(reply.data, 0, sizeof(reply.data));
+                    reply.size = sizeof(uint32_t);
+                    ((uint32_t *)reply.data)[0] = checksum;
+                    reply.opcode = FTP_OP::Ack;
+                    break;
+                }
+            case FTP_OP::BurstReadFile:
+                {
+                    const uint16_t max_read = (request.size == 0?sizeof(reply.data):request.size);
+                    // must actually be working on a file
+                    if (session == nullptr) {
+                        ftp_error(reply, FTP_ERROR::FileNotFound);
                         break;
                     }
-                case FTP_OP::TruncateFile:
-                case FTP_OP::Rename:
-                default:
-                    // this was bad data, just nack it
-                    gcs().send_text(MAV_SEVERITY_DEBUG, "Unsupported FTP: %d", static_cast<int>(request.opcode));
-                    ftp_error(reply, FTP_ERROR::Fail);
-                    break;
-            }
+
+                    // must have the file in read mode
+                    if ((session->mode != FTP_FILE_MODE::Read)) {
+                        ftp_error(reply, FTP_ERROR::Fail);
+                        break;
+                    }
+
+                    // start the burst, replacing any in progress.
+                    // The replies are sent by ftp_burst_step()
+                    const struct ftp_link &link = ftp.links[request.chan];
+                    session->burst.offset = request.offset;
+                    session->burst.seq_number = reply.seq_number;
+                    session->burst.remaining = constrain_int32(link.send_rate / 2, FTP_BURST_MIN_REPLIES, FTP_BURST_MAX_REPLIES);
+                    session->burst.size = max_read;
+
+                    // there is no single reply to resend for this request
+                    reply.session = -1;
+                    continue;
+                }
+            case FTP_OP::TruncateFile:
+            case FTP_OP::Rename:
+            default:
+                // this was bad data, just nack it
+                gcs().send_text(MAV_SEVERITY_DEBUG, "Unsupported FTP: %d", static_cast<int>(request.opcode));
+                ftp_error(reply, FTP_ERROR::Fail);
+                break;
         }
 
         ftp_push_replies(reply);
@@ -85,6 +85,20 @@ GCS_MAVLINK::queued_param_send()
         _queued_parameter = AP_Param::next_scalar(&_queued_parameter_token, &_queued_parameter_type);
         _queued_parameter_index++;
 
+        if (_queued_parameter == nullptr) {
+// @LoggerMessage: PRML
+// @Description: Parameter list download, logged when the last parameter of a PARAM_REQUEST_LIST has been sent
+// @Field: TimeUS: Time since system startup
+// @Field: Chan: MAVLink channel the list was sent on
+// @Field: Count: number of parameters sent
+// @Field: Time: time taken to send the whole list
+            AP::logger().Write("PRML", "TimeUS,Chan,Count,Time", "s#-s", "F--C", "QBHI",
+                               AP_HAL::micros64(),
+                               uint8_t(chan),
+                               _queued_parameter_index,
+                               AP_HAL::millis() - _queued_parameter_start_ms);
+        }
+
         if (AP_HAL::micros() - tstart > 1000) {
             // don't use more than 1ms sending blocks of parameters
             break;
@@ -215,6 +229,7 @@ void GCS_MAVLINK::handle_param_request_list(const mavlink_message_t &msg)
     _queued_parameter_index = 0;
     _queued_parameter_count = AP_Param::count_parameters();
     _queued_parameter_send_time_ms = AP_HAL::millis(); // avoid initial flooding
+    _queued_parameter_start_ms = _queued_parameter_send_time_ms;
 }
 
 void GCS_MAVLINK::handle_param_request_read(const mavlink_message_t &msg)
@@ -27,7 +27,10 @@ extern const AP_HAL::HAL& hal;
 #define ROUTING_DEBUG 0
 
 // constructor
-MAVLink_routing::MAVLink_routing(void) : num_routes(0) {}
+MAVLink_routing::MAVLink_routing(void) : num_routes(0)
+{
+    memset(buckets, ROUTE_NONE, sizeof(buckets));
+}
 
 /*
   forward a MAVLink message to the right port. This also
@@ -138,38 +141,50 @@ bool MAVLink_routing::check_and_forward(mavlink_channel_t in_channel, const mavl
     bool forwarded = false;
     bool sent_to_chan[MAVLINK_COMM_NUM_BUFFERS];
     memset(sent_to_chan, 0, sizeof(sent_to_chan));
-    for (uint8_t i=0; i<num_routes; i++) {
-    
+    auto forward_route = [&](struct route &r) {
         // Skip if channel is private and the target system or component IDs do not match
-        if ((GCS_MAVLINK::is_private(routes[i].channel)) &&
-            (target_system != routes[i].sysid ||
-             target_component != routes[i].compid)) {
-            continue;
+        if ((GCS_MAVLINK::is_private(r.channel)) &&
+            (target_system != r.sysid ||
+             target_component != r.compid)) {
+            return;
         }
 
-        if (broadcast_system || (target_system == routes[i].sysid &&
+        if (broadcast_system || (target_system == r.sysid &&
                                  (broadcast_component || 
-                                  target_component == routes[i].compid ||
+                                  target_component == r.compid ||
                                   !match_system))) {
 
-            if (in_channel != routes[i].channel && !sent_to_chan[routes[i].channel]) {
+            if (in_channel != r.channel && !sent_to_chan[r.channel]) {
                 
-                if (comm_get_txspace(routes[i].channel) >= ((uint16_t)msg.len) +
-                    GCS_MAVLINK::packet_overhead_chan(routes[i].channel)) {
+                if (comm_get_txspace(r.channel) >= ((uint16_t)msg.len) +
+                    GCS_MAVLINK::packet_overhead_chan(r.channel)) {
 #if ROUTING_DEBUG
                     ::printf("fwd msg %u from chan %u on chan %u sysid=%d compid=%d\n",
                              msg.msgid,
                              (unsigned)in_channel,
-                             (unsigned)routes[i].channel,
+                             (unsigned)r.channel,
                              (int)target_system,
                              (int)target_component);
 #endif
-                    _mavlink_resend_uart(routes[i].channel, &msg);
+                    _mavlink_resend_uart(r.channel, &msg);
+                    r.fwd_count++;
                 }
-                sent_to_chan[routes[i].channel] = true;
+                sent_to_chan[r.channel] = true;
                 forwarded = true;
             }
         }
+    };
+    if (broadcast_system) {
+        for (uint8_t i=0; i<num_routes; i++) {
+            forward_route(routes[i]);
+        }
+    } else {
+        // only routes to the target system can match
+        for (uint8_t i=buckets[bucket(target_system)]; i != ROUTE_NONE; i=routes[i].next) {
+            if (routes[i].sysid == target_system) {
+                forward_route(routes[i]);
+            }
+        }
     }
 
     if (!forwarded && match_system) {
@@ -198,7 +213,7 @@ void MAVLink_routing::send_to_components(const char *pkt, const mavlink_msg_entr
     bool sent_to_chan[MAVLINK_COMM_NUM_BUFFERS] {};
 
     // check learned routes
-    for (uint8_t i=0; i<num_routes; i++) {
+    for (uint8_t i=buckets[bucket(mavlink_system.sysid)]; i != ROUTE_NONE; i=routes[i].next) {
         if (routes[i].sysid != mavlink_system.sysid) {
             // our system ID hasn't been seen on this link
             continue;
@@ -260,37 +275,169 @@ bool MAVLink_routing::find_by_mavtype(uint8_t mavtype, uint8_t &sysid, uint8_t &
 */
 void MAVLink_routing::learn_route(mavlink_channel_t in_channel, const mavlink_message_t &msg)
 {
-    uint8_t i;
     if (msg.sysid == 0 ||
         (msg.sysid == mavlink_system.sysid &&
          msg.compid == mavlink_system.compid)) {
         return;
     }
-    for (i=0; i<num_routes; i++) {
+    const uint32_t now_ms = AP_HAL::millis();
+    for (uint8_t i=buckets[bucket(msg.sysid)]; i != ROUTE_NONE; i=routes[i].next) {
         if (routes[i].sysid == msg.sysid &&
             routes[i].compid == msg.compid &&
             routes[i].channel == in_channel) {
             if (routes[i].mavtype == 0 && msg.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
                 routes[i].mavtype = mavlink_msg_heartbeat_get_type(&msg);
             }
-            break;
+            routes[i].last_seen_ms = now_ms;
+            routes[i].rx_count++;
+            return;
         }
     }
-    if (i == num_routes && i<MAVLINK_MAX_ROUTES) {
-        routes[i].sysid = msg.sysid;
-        routes[i].compid = msg.compid;
-        routes[i].channel = in_channel;
-        if (msg.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
-            routes[i].mavtype = mavlink_msg_heartbeat_get_type(&msg);
+
+    if (num_routes == MAVLINK_MAX_ROUTES &&
+        route_full_until_ms != 0 &&
+        int32_t(now_ms - route_full_until_ms) < 0) {
+        // no route can have gone stale since the last scan
+        route_refused(in_channel, msg);
+        return;
+    }
+
+    WITH_SEMAPHORE(sem);
+
+    if (num_routes == MAVLINK_MAX_ROUTES) {
+        // replace the route heard from least recently if it is stale,
+        // otherwise keep the routes we have
+        uint8_t oldest = 0;
+        for (uint8_t i=1; i<num_routes; i++) {
+            if (now_ms - routes[i].last_seen_ms > now_ms - routes[oldest].last_seen_ms) {
+                oldest = i;
+            }
+        }
+        if (now_ms - routes[oldest].last_seen_ms < MAVLINK_ROUTE_STALE_MS) {
+            // routes are only refreshed, so none can be stale before
+            // the oldest one is
+            route_full_until_ms = MAX(routes[oldest].last_seen_ms + MAVLINK_ROUTE_STALE_MS, 1U);
+            route_refused(in_channel, msg);
+            return;
         }
-        num_routes++;
 #if ROUTING_DEBUG
-        ::printf("learned route %u %u via %u\n",
-                 (unsigned)msg.sysid,
-                 (unsigned)msg.compid,
-                 (unsigned)in_channel);
+        ::printf("expired route %u %u via %u\n",
+                 (unsigned)routes[oldest].sysid,
+                 (unsigned)routes[oldest].compid,
+                 (unsigned)routes[oldest].channel);
 #endif
+        remove_route(oldest);
+        route_evictions++;
+        route_full_until_ms = 0;
+    }
+
+    const uint8_t i = num_routes++;
+    struct route &r = routes[i];
+    r.sysid = msg.sysid;
+    r.compid = msg.compid;
+    r.channel = in_channel;
+    r.mavtype = 0;
+    if (msg.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
+        r.mavtype = mavlink_msg_heartbeat_get_type(&msg);
     }
+    r.last_seen_ms = now_ms;
+    r.rx_count = 1;
+    r.fwd_count = 0;
+    r.next = buckets[bucket(r.sysid)];
+    buckets[bucket(r.sysid)] = i;
+#if ROUTING_DEBUG
+    ::printf("learned route %u %u via %u\n",
+             (unsigned)msg.sysid,
+             (unsigned)msg.compid,
+             (unsigned)in_channel);
+#endif
+}
+
+/*
+  count a sender which could not be given a route because the table is
+  full of live routes. A sender is only counted again once it has
+  dropped out of the list of recently refused senders, so the count is
+  of senders rather than of their messages
+*/
+void MAVLink_routing::route_refused(mavlink_channel_t in_channel, const mavlink_message_t &msg)
+{
+    for (const struct refused_route &r : refused) {
+        if (r.sysid == msg.sysid &&
+            r.compid == msg.compid &&
+            r.channel == in_channel) {
+            return;
+        }
+    }
+    struct refused_route &r = refused[refused_next];
+    r.sysid = msg.sysid;
+    r.compid = msg.compid;
+    r.channel = in_channel;
+    refused_next = (refused_next + 1) % ARRAY_SIZE(refused);
+    route_overflows++;
+}
+
+/*
+  remove a route from the table. The last route is moved into its
+  place to keep the table dense. Called with sem held
+*/
+void MAVLink_routing::remove_route(uint8_t idx)
+{
+    // unlink the route from its bucket
+    for (uint8_t *link = &buckets[bucket(routes[idx].sysid)]; *link != ROUTE_NONE; link = &routes[*link].next) {
+        if (*link == idx) {
+            *link = routes[idx].next;
+            break;
+        }
+    }
+
+    const uint8_t last = num_routes - 1;
+    if (idx != last) {
+        // point the link to the last route at its new place
+        for (uint8_t *link = &buckets[bucket(routes[last].sysid)]; *link != ROUTE_NONE; link = &routes[*link].next) {
+            if (*link == last) {
+                *link = idx;
+                break;
+            }
+        }
+        routes[idx] = routes[last];
+    }
+    num_routes--;
+}
+
+/*
+  text report of the routing table
+*/
+uint32_t MAVLink_routing::route_info(char *buf, uint32_t bufsize)
+{
+    WITH_SEMAPHORE(sem);
+
+    uint32_t len = 0;
+#define ROUTE_INFO_PRINTF(fmt, args...) do {                            \
+        const int n = hal.util->snprintf(&buf[MIN(len, bufsize)], bufsize - MIN(len, bufsize), fmt, ##args); \
+        if (n > 0) { len += n; }                                        \
+    } while (0)
+
+    ROUTE_INFO_PRINTF("Routes: %u/%u Overflows: %lu Evictions: %lu\n",
+                      (unsigned)num_routes,
+                      (unsigned)MAVLINK_MAX_ROUTES,
+                      (unsigned long)route_overflows,
+                      (unsigned long)route_evictions);
+    ROUTE_INFO_PRINTF("%5s %6s %4s %4s %8s %10s %10s\n",
+                      "SysID", "CompID", "Chan", "Type", "AgeMS", "Rx", "Fwd");
+    const uint32_t now_ms = AP_HAL::millis();
+    for (uint8_t i=0; i<num_routes; i++) {
+        const struct route &r = routes[i];
+        ROUTE_INFO_PRINTF("%5u %6u %4u %4u %8lu %10lu %10lu\n",
+                          (unsigned)r.sysid,
+                          (unsigned)r.compid,
+                          (unsigned)r.channel,
+                          (unsigned)r.mavtype,
+                          (unsigned long)(now_ms - r.last_seen_ms),
+                          (unsigned long)r.rx_count,
+                          (unsigned long)r.fwd_count);
+    }
+#undef ROUTE_INFO_PRINTF
+    return len;
 }
 
 
@@ -311,7 +458,7 @@ void MAVLink_routing::handle_heartbeat(mavlink_channel_t in_channel, const mavli
     mask &= ~no_route_mask;
     
     // mask out channels that are known sources for this sysid/compid
-    for (uint8_t i=0; i<num_routes; i++) {
+    for (uint8_t i=buckets[bucket(msg.sysid)]; i != ROUTE_NONE; i=routes[i].next) {
         if (routes[i].sysid == msg.sysid && routes[i].compid == msg.compid) {
             mask &= ~(1U<<((unsigned)(routes[i].channel-MAVLINK_COMM_0)));
         }
@@ -6,9 +6,32 @@
 #include <AP_Common/AP_Common.h>
 #include "GCS_MAVLink.h"
 
-// 20 routes should be enough for now. This may need to increase as
-// we make more extensive use of MAVLink forwarding
+/*
+  maximum number of routes. Routes are indexed by a uint8_t, so this
+  can be at most 254
+ */
+#ifndef MAVLINK_MAX_ROUTES
+#if HAL_MEM_CLASS >= HAL_MEM_CLASS_300
+#define MAVLINK_MAX_ROUTES 64
+#else
 #define MAVLINK_MAX_ROUTES 20
+#endif
+#endif
+
+// number of hash buckets routes are found by, a power of two
+#ifndef MAVLINK_ROUTE_BUCKETS
+#define MAVLINK_ROUTE_BUCKETS 32
+#endif
+
+// when the table is full a route not heard from for this long is
+// replaced by a new one. Routes only age out when the table is full:
+// until then a stale route is kept, and still used, however old it is
+#ifndef MAVLINK_ROUTE_STALE_MS
+#define MAVLINK_ROUTE_STALE_MS 30000
+#endif
+
+static_assert(MAVLINK_MAX_ROUTES < 255, "too many MAVLink routes");
+static_assert((MAVLINK_ROUTE_BUCKETS & (MAVLINK_ROUTE_BUCKETS-1)) == 0, "MAVLINK_ROUTE_BUCKETS must be a power of two");
 
 /*
   object to handle MAVLink packet routing
@@ -44,23 +67,63 @@ public:
      */
     bool find_by_mavtype(uint8_t mavtype, uint8_t &sysid, uint8_t &compid, mavlink_channel_t &channel);
 
+    /*
+      fill buf with a text report of the routing table, returning the
+      length of the whole report
+     */
+    uint32_t route_info(char *buf, uint32_t bufsize);
+
 private:
-    // a simple linear routing table. We don't expect to have a lot of
-    // routes, so a scalable structure isn't worthwhile yet.
+    // routes are chained from a hash of their sysid, so the routes to
+    // a target system are found without scanning the whole table
+    static const uint8_t ROUTE_NONE = 0xFF;
     uint8_t num_routes;
     struct route {
         uint8_t sysid;
         uint8_t compid;
         mavlink_channel_t channel;
         uint8_t mavtype;
+        uint8_t next;           // next route in the same bucket
+        uint32_t last_seen_ms;
+        uint32_t rx_count;      // messages received over the route
+        uint32_t fwd_count;     // messages forwarded over the route
     } routes[MAVLINK_MAX_ROUTES];
-    
+    uint8_t buckets[MAVLINK_ROUTE_BUCKETS];
+
+    // senders not learned because the table was full of live routes.
+    // A sender is counted once while it is in refused[], not for every
+    // message it sends
+    uint32_t route_overflows;
+    // when the table is full, the time before which no route can be
+    // stale, so new senders are refused without a scan or the semaphore
+    uint32_t route_full_until_ms;
+    // the most recently refused senders
+    struct refused_route {
+        uint8_t sysid;
+        uint8_t compid;
+        mavlink_channel_t channel;
+    } refused[4];
+    uint8_t refused_next;
+    // stale routes replaced by new ones
+    uint32_t route_evictions;
+
+    // held while routes are added or removed, and for reports
+    HAL_Semaphore sem;
+
+    static uint8_t bucket(uint8_t sysid) { return sysid & (MAVLINK_ROUTE_BUCKETS-1); }
+
+    // remove a route, moving the last route into its place
+    void remove_route(uint8_t idx);
+
     // a channel mask to block routing as required
     uint8_t no_route_mask;
     
     // learn new routes
     void learn_route(mavlink_channel_t in_channel, const mavlink_message_t &msg);
 
+    // count a sender refused a route because the table is full
+    void route_refused(mavlink_channel_t in_channel, const mavlink_message_t &msg);
+
     // extract target sysid and compid from a message
     void get_targets(const mavlink_message_t &msg, int16_t &sysid, int16_t &compid);
 